@@ -0,0 +1,130 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "arena.h"
+#include <new>
+
+
+namespace perun2
+{
+
+// Arena used by ArenaAllocated objects created on this thread
+static thread_local Arena* activeArena = nullptr;
+
+enum ArenaOrigin : unsigned char
+{
+   ao_Heap = 0,
+   ao_Arena
+};
+
+
+static p_size arenaAlign(const p_size size)
+{
+   return (size + ARENA_HEADER_SIZE - 1) & ~(ARENA_HEADER_SIZE - 1);
+}
+
+void* Arena::allocate(const p_size size)
+{
+   const p_size aligned = arenaAlign(size);
+
+   if (aligned > this->remaining) {
+      this->addBlock(aligned);
+   }
+
+   void* result = this->current;
+   this->current += aligned;
+   this->remaining -= aligned;
+   this->used += aligned;
+   return result;
+}
+
+void Arena::release()
+{
+   this->blocks.clear();
+   this->current = nullptr;
+   this->remaining = 0;
+   this->used = 0;
+   this->reserved = 0;
+}
+
+p_size Arena::getUsedMemory() const
+{
+   return this->used;
+}
+
+p_size Arena::getReservedMemory() const
+{
+   return this->reserved;
+}
+
+void Arena::addBlock(const p_size minSize)
+{
+   // an unusually big object gets a block of its own size
+   // the rest of the previous block is abandoned
+   const p_size size = minSize > ARENA_BLOCK_SIZE
+      ? minSize
+      : ARENA_BLOCK_SIZE;
+
+   // operator new[] for char returns memory aligned for any fundamental type
+   this->blocks.emplace_back(new char[size]);
+   this->current = this->blocks.back().get();
+   this->remaining = size;
+   this->reserved += size;
+}
+
+
+ArenaScope::ArenaScope(Arena& arena)
+   : previous(activeArena)
+{
+   activeArena = &arena;
+}
+
+ArenaScope::~ArenaScope() noexcept
+{
+   activeArena = this->previous;
+}
+
+
+void* ArenaAllocated::operator new(const p_size size)
+{
+   const p_size total = size + ARENA_HEADER_SIZE;
+   char* base;
+
+   if (activeArena == nullptr) {
+      base = static_cast<char*>(::operator new(total));
+      base[0] = ArenaOrigin::ao_Heap;
+   }
+   else {
+      base = static_cast<char*>(activeArena->allocate(total));
+      base[0] = ArenaOrigin::ao_Arena;
+   }
+
+   return base + ARENA_HEADER_SIZE;
+}
+
+void ArenaAllocated::operator delete(void* ptr) noexcept
+{
+   if (ptr == nullptr) {
+      return;
+   }
+
+   char* base = static_cast<char*>(ptr) - ARENA_HEADER_SIZE;
+
+   // memory of an Arena is released only as a whole
+   if (base[0] == ArenaOrigin::ao_Heap) {
+      ::operator delete(base);
+   }
+}
+
+}
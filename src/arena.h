@@ -0,0 +1,92 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "datatype/primitives.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+
+namespace perun2
+{
+
+// size of one memory block of the Arena
+// a typical script fits in one block
+p_constexpr p_size ARENA_BLOCK_SIZE = 64 * 1024;
+
+// every object placed by ArenaAllocated is preceded by a small header
+// it tells whether the memory came from an Arena or from the heap
+p_constexpr p_size ARENA_HEADER_SIZE = alignof(std::max_align_t);
+
+
+// parsed program is a tree of thousands of tiny objects: commands, generators, contexts, variables...
+// Arena is a monotonic bump allocator for them
+// objects are placed one after another in big memory blocks
+// freeing a single object does nothing, all memory is released at once together with the Arena
+struct Arena
+{
+public:
+   Arena() = default;
+   Arena(Arena const&) = delete;
+   Arena& operator= (Arena const&) = delete;
+
+   void* allocate(const p_size size);
+
+   // all objects from this Arena have to be destroyed before calling it
+   void release();
+
+   p_size getUsedMemory() const;
+   p_size getReservedMemory() const;
+
+private:
+   void addBlock(const p_size minSize);
+
+   std::vector<std::unique_ptr<char[]>> blocks;
+   char* current = nullptr;
+   p_size remaining = 0;
+   p_size used = 0;
+   p_size reserved = 0;
+};
+
+
+// while an ArenaScope exists, every ArenaAllocated object created on this thread goes into its Arena
+// outside of any scope, ArenaAllocated objects are allocated on the heap as usual
+struct ArenaScope
+{
+public:
+   ArenaScope() = delete;
+   ArenaScope(Arena& arena);
+   ~ArenaScope() noexcept;
+
+   ArenaScope(ArenaScope const&) = delete;
+   ArenaScope& operator= (ArenaScope const&) = delete;
+
+private:
+   Arena* const previous;
+};
+
+
+// base for the nodes of syntax tree
+// they are still owned by std::unique_ptr and their destructors run as usual
+// only the memory comes from the active Arena
+struct ArenaAllocated
+{
+public:
+   static void* operator new(const p_size size);
+   static void operator delete(void* ptr) noexcept;
+};
+
+}
@@ -16,6 +16,7 @@
 #include "cmd.h"
 #include "metadata.h"
 #include "os/os.h"
+#include <cwchar>
 
 
 namespace perun2
@@ -83,6 +84,39 @@ Arguments::Arguments(const p_int argc, p_char* const argv[])
             p_str lowerArg = arg;
             str_toLower(lowerArg);
 
+            // these are the only long options followed by more arguments
+            if (lowerArg == STRING_ARG_STATS) {
+               this->flags |= FLAG_STATS;
+               continue;
+            }
+            else if (lowerArg == STRING_ARG_WATCH) {
+               this->flags |= FLAG_WATCH;
+               continue;
+            }
+            else if (lowerArg == STRING_ARG_PROFILE) {
+               this->profileFormat = ProfileFormat::pf_Report;
+               continue;
+            }
+            else if (lowerArg == STRING_ARG_PROFILE_JSON) {
+               this->profileFormat = ProfileFormat::pf_Json;
+               continue;
+            }
+            else if (lowerArg == STRING_ARG_PROFILE_TRACE) {
+               this->profileFormat = ProfileFormat::pf_Trace;
+               continue;
+            }
+            else if (lowerArg == STRING_ARG_OUTPUT_TEXT) {
+               this->outputFormat = OutputFormat::of_Text;
+               continue;
+            }
+            else if (lowerArg == STRING_ARG_OUTPUT_JSON) {
+               this->outputFormat = OutputFormat::of_JsonLines;
+               continue;
+            }
+            else if (this->parseJobs(lowerArg)) {
+               continue;
+            }
+
             if (lowerArg == STRING_ARG_VERSION) {
                this->parseState = ArgsParseState::aps_PrintInfo;
                cmd::version();
@@ -99,6 +133,9 @@ Arguments::Arguments(const p_int argc, p_char* const argv[])
                this->parseState = ArgsParseState::aps_PrintInfo;
                cmd::help();
             }
+            else if (lowerArg == STRING_ARG_DAEMON) {
+               this->parseState = ArgsParseState::aps_Daemon;
+            }
             else {
                cmd::error::unknownOption(arg.substr(2));
             }
@@ -143,6 +180,16 @@ Arguments::Arguments(const p_int argc, p_char* const argv[])
                      this->flags |= FLAG_STATIC_ANALYSIS;
                      break;
                   }
+                  case CHAR_FLAG_SCRIPT_CACHE:
+                  case CHAR_FLAG_SCRIPT_CACHE_UPPER: {
+                     this->flags |= FLAG_SCRIPT_CACHE;
+                     break;
+                  }
+                  case CHAR_FLAG_PIPELINE:
+                  case CHAR_FLAG_PIPELINE_UPPER: {
+                     this->flags |= FLAG_PIPELINE;
+                     break;
+                  }
                   default: {
                      cmd::error::unknownOption(toStr(arg[j]));
                      return;
@@ -268,6 +315,48 @@ const p_str& Arguments::getCodeRef() const
    return this->code;
 }
 
+ProfileFormat Arguments::getProfileFormat() const
+{
+   return this->profileFormat;
+}
+
+OutputFormat Arguments::getOutputFormat() const
+{
+   return this->outputFormat;
+}
+
+p_size Arguments::getJobs() const
+{
+   return this->jobs;
+}
+
+p_bool Arguments::parseJobs(const p_str& arg)
+{
+   const p_size prefix = std::wcslen(STRING_ARG_JOBS);
+   const p_size length = arg.size();
+
+   if (length <= prefix || arg.compare(0, prefix, STRING_ARG_JOBS) != 0 || length - prefix > JOBS_MAX_DIGITS) {
+      return false;
+   }
+
+   p_size value = 0;
+
+   for (p_size i = prefix; i < length; i++) {
+      if (! char_isDigit(arg[i])) {
+         return false;
+      }
+
+      value = value * 10 + static_cast<p_size>(arg[i] - CHAR_0);
+   }
+
+   if (value == 0) {
+      return false;
+   }
+
+   this->jobs = value;
+   return true;
+}
+
 ArgsParseState Arguments::getParseState() const
 {
    return this->parseState;
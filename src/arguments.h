@@ -15,6 +15,8 @@
 #pragma once
 
 #include "datatype/datatype.h"
+#include "profiler.h"
+#include "logger.h"
 
 namespace perun2
 {
@@ -26,6 +28,10 @@ p_constexpr p_flags FLAG_NOOMIT =               1 << 0;
 p_constexpr p_flags FLAG_SILENT =               1 << 1;
 p_constexpr p_flags FLAG_GUI =                  1 << 2;
 p_constexpr p_flags FLAG_STATIC_ANALYSIS =      1 << 3;
+p_constexpr p_flags FLAG_SCRIPT_CACHE =         1 << 4;
+p_constexpr p_flags FLAG_PIPELINE =             1 << 5;
+p_constexpr p_flags FLAG_STATS =                1 << 6;
+p_constexpr p_flags FLAG_WATCH =                1 << 7;
 
 p_constexpr p_char CHAR_FLAG_GUI =              CHAR_g;
 p_constexpr p_char CHAR_FLAG_NOOMIT =           CHAR_n;
@@ -34,6 +40,8 @@ p_constexpr p_char CHAR_FLAG_DIRECTORY =        CHAR_d;
 p_constexpr p_char CHAR_FLAG_HERE =             CHAR_h;
 p_constexpr p_char CHAR_FLAG_CODE =             CHAR_c;
 p_constexpr p_char CHAR_FLAG_STATIC_ANALYSIS =  CHAR_m;
+p_constexpr p_char CHAR_FLAG_SCRIPT_CACHE =     CHAR_p;
+p_constexpr p_char CHAR_FLAG_PIPELINE =         CHAR_a;
 
 p_constexpr p_char CHAR_FLAG_GUI_UPPER =        CHAR_G;
 p_constexpr p_char CHAR_FLAG_NOOMIT_UPPER =     CHAR_N;
@@ -42,12 +50,18 @@ p_constexpr p_char CHAR_FLAG_DIRECTORY_UPPER =  CHAR_D;
 p_constexpr p_char CHAR_FLAG_HERE_UPPER =       CHAR_H;
 p_constexpr p_char CHAR_FLAG_CODE_UPPER =       CHAR_C;
 p_constexpr p_char CHAR_FLAG_STATIC_ANALYSIS_UPPER =  CHAR_M;
+p_constexpr p_char CHAR_FLAG_SCRIPT_CACHE_UPPER =     CHAR_P;
+p_constexpr p_char CHAR_FLAG_PIPELINE_UPPER =         CHAR_A;
+
+// the value of --jobs=<n> is short, so it never overflows
+p_constexpr p_size JOBS_MAX_DIGITS = 4;
 
 
 enum ArgsParseState 
 {
    aps_Ok = 0,
    aps_PrintInfo,
+   aps_Daemon,
    aps_Failed
 };
 
@@ -71,14 +85,24 @@ public:
    p_str getLocation() const;
    p_str getCode() const;
    const p_str& getCodeRef() const;
+   ProfileFormat getProfileFormat() const;
+   OutputFormat getOutputFormat() const;
+   p_size getJobs() const;
    ArgsParseState getParseState() const;
    p_bool hasFlag(const p_flags flag) const;
 
 private:
+   // option --jobs=<n>
+   p_bool parseJobs(const p_str& arg);
+
    p_str code;
    p_flags flags = FLAG_NULL;
    p_list args;
    p_str location;
+   ProfileFormat profileFormat = ProfileFormat::pf_None;
+   OutputFormat outputFormat = OutputFormat::of_Text;
+   // maximum of processes started at once by commands Run in a loop
+   p_size jobs = 1;
    ArgsParseState parseState = ArgsParseState::aps_Failed;
 };
 
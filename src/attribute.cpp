@@ -116,6 +116,14 @@ void Attribute::add(const Token& tk)
       this->setCoreCommandBase();
       this->set(ATTR_IMAGE_OR_VIDEO);
    }
+   else if (tk.isVariable(STRING_HASH, this->perun2)) {
+      this->setCoreCommandBase();
+      this->set(ATTR_HASH);
+   }
+   else if (tk.isVariable(STRING_CRC32, this->perun2)) {
+      this->setCoreCommandBase();
+      this->set(ATTR_CRC32);
+   }
 }
 
 void Attribute::set(const p_aunit v)
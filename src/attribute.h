@@ -15,6 +15,7 @@
 #pragma once
 
 #include "token.h"
+#include "arena.h"
 #include <memory>
 
 
@@ -46,6 +47,8 @@ p_constexpr p_aunit ATTR_READONLY =       1 << 18;
 p_constexpr p_aunit ATTR_SIZE =           1 << 19;
 p_constexpr p_aunit ATTR_SIZE_FILE_ONLY=  1 << 20;
 p_constexpr p_aunit ATTR_IMAGE_OR_VIDEO = 1 << 21;
+p_constexpr p_aunit ATTR_HASH =           1 << 22;
+p_constexpr p_aunit ATTR_CRC32 =          1 << 23;
 
 // certain expression or syntax structure may require multiple file attributes:
 // for example - creation time, modification time, size and extension
@@ -55,7 +58,7 @@ p_constexpr p_aunit ATTR_IMAGE_OR_VIDEO = 1 << 21;
 
 struct Perun2Process;
 
-struct Attribute
+struct Attribute : ArenaAllocated
 {
 public:
    Attribute() = delete;
@@ -0,0 +1,41 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "benchmark.h"
+#include "../perun2.h"
+
+
+// micro-benchmarks of the runtime of Perun2
+// run with the option --benchmark_format=json or --benchmark_out=<file> to get results as JSON
+int main(void)
+{
+   int argc;
+   LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+
+   if (argv == NULL) {
+      return perun2::EXITCODE_CLI_ERROR;
+   }
+
+   perun2::bench::BenchmarkRunner runner;
+   perun2::bench::addParseBenchmarks(runner);
+   perun2::bench::addTextBenchmarks(runner);
+   perun2::bench::addOrderBenchmarks(runner);
+   perun2::bench::addMathBenchmarks(runner);
+   perun2::bench::addOsBenchmarks(runner);
+   perun2::bench::addRuntimeBenchmarks(runner);
+
+   const int exitCode = runner.run(argc, argv);
+   LocalFree(argv);
+   return exitCode;
+}
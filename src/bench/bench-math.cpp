@@ -0,0 +1,135 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "benchmark.h"
+#include "../datatype/datatype.h"
+
+
+namespace perun2::bench
+{
+
+p_constexpr p_size MATH_OPERATIONS = 1000;
+
+
+static void benchNumberInteger(BenchmarkState& state)
+{
+   const p_num step(static_cast<p_nint>(7));
+   const p_num modulo(static_cast<p_nint>(1000003));
+
+   while (state.keepRunning()) {
+      p_num value(static_cast<p_nint>(1));
+
+      for (p_size i = 0; i < MATH_OPERATIONS; i++) {
+         value = (value * step + step) % modulo;
+      }
+
+      doNotOptimize(value);
+   }
+
+   state.setItemsProcessed(state.iterations * MATH_OPERATIONS);
+}
+
+static void benchNumberDouble(BenchmarkState& state)
+{
+   const p_num factor(static_cast<p_ndouble>(1.0001L));
+   const p_num divisor(static_cast<p_ndouble>(3.5L));
+
+   while (state.keepRunning()) {
+      p_num value(static_cast<p_ndouble>(0.5L));
+
+      for (p_size i = 0; i < MATH_OPERATIONS; i++) {
+         value = value * factor + value / divisor;
+      }
+
+      doNotOptimize(value);
+   }
+
+   state.setItemsProcessed(state.iterations * MATH_OPERATIONS);
+}
+
+// integers and doubles mixed, every operation decides the type of its result
+static void benchNumberMixed(BenchmarkState& state)
+{
+   const p_num half(static_cast<p_ndouble>(0.5L));
+   const p_num two(static_cast<p_nint>(2));
+
+   while (state.keepRunning()) {
+      p_num value(static_cast<p_nint>(1));
+
+      for (p_size i = 0; i < MATH_OPERATIONS; i++) {
+         value += half;
+         value *= two;
+         value -= value / two;
+      }
+
+      doNotOptimize(value);
+   }
+
+   state.setItemsProcessed(state.iterations * MATH_OPERATIONS * 3);
+}
+
+static void benchTimeAddPeriod(BenchmarkState& state)
+{
+   const p_per days(3, Period::u_Days);
+   const p_per months(1, Period::u_Months);
+   const p_per hours(17, Period::u_Hours);
+
+   while (state.keepRunning()) {
+      p_tim time(1, 1, 2000, 12, 30, 15);
+
+      for (p_size i = 0; i < MATH_OPERATIONS; i++) {
+         time += days;
+         time += hours;
+         time -= months;
+      }
+
+      doNotOptimize(time);
+   }
+
+   state.setItemsProcessed(state.iterations * MATH_OPERATIONS * 3);
+}
+
+static void benchTimeDifference(BenchmarkState& state)
+{
+   std::vector<p_tim> times;
+   times.reserve(MATH_OPERATIONS);
+
+   for (p_size i = 0; i < MATH_OPERATIONS; i++) {
+      const p_tnum n = static_cast<p_tnum>(i);
+      times.emplace_back(1 + n % 28, 1 + n % 12, 1990 + n % 40, n % 24, n % 60, n % 60);
+   }
+
+   const p_tim base(15, 6, 2010, 8, 0, 0);
+
+   while (state.keepRunning()) {
+      for (const p_tim& time : times) {
+         doNotOptimize(time - base);
+         doNotOptimize(time < base);
+      }
+   }
+
+   state.setItemsProcessed(state.iterations * MATH_OPERATIONS * 2);
+}
+
+
+void addMathBenchmarks(BenchmarkRunner& runner)
+{
+   runner.add(L"Number/integer", benchNumberInteger);
+   runner.add(L"Number/double", benchNumberDouble);
+   runner.add(L"Number/mixed", benchNumberMixed);
+   runner.add(L"Time/add period", benchTimeAddPeriod);
+   runner.add(L"Time/difference", benchTimeDifference);
+}
+
+}
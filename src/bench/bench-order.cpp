@@ -0,0 +1,157 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "benchmark.h"
+#include "../datatype/order.h"
+#include <algorithm>
+#include <random>
+
+
+namespace perun2::bench
+{
+
+p_constexpr p_size ORDER_VALUES = 10000;
+p_constexpr uint32_t ORDER_SEED = 2024;
+
+
+// the element of the sorted list, that is loaded right now
+struct ListElement : Generator<p_str>
+{
+public:
+   ListElement() = delete;
+   ListElement(const p_list& vals, const p_size& ind) : values(vals), index(ind) { };
+
+   p_str getValue() override
+   {
+      return this->values[this->index];
+   };
+
+private:
+   const p_list& values;
+   const p_size& index;
+};
+
+
+// a number derived from the element of the sorted list, like its size
+// many elements have the same number, so the next unit of order is used too
+struct ListElementNumber : Generator<p_num>
+{
+public:
+   ListElementNumber() = delete;
+   ListElementNumber(const p_list& vals, const p_size& ind) : values(vals), index(ind) { };
+
+   p_num getValue() override
+   {
+      return p_num(static_cast<p_nint>(this->values[this->index].size() % 7));
+   };
+
+private:
+   const p_list& values;
+   const p_size& index;
+};
+
+
+// access to protected members of OrderBy
+// values of units of order are loaded like OrderBy_List does, before sorting
+struct OrderedList : gen::OrderBy
+{
+public:
+   OrderedList() = delete;
+   OrderedList(gen::p_indptr& inds, gen::p_ordptr& ord)
+      : OrderBy(inds, ord) { };
+
+   void load(p_list& list, p_size& current)
+   {
+      const p_size length = list.size();
+      this->resultPtr = &list;
+      this->indices->prepare(length);
+      this->order->clearValues(length);
+
+      for (current = 0; current < length; current++) {
+         this->indices->values[current] = current;
+         this->order->addValues();
+      }
+   }
+};
+
+
+static p_list makeShuffledNames()
+{
+   p_list result;
+   result.reserve(ORDER_VALUES);
+
+   for (p_size i = 0; i < ORDER_VALUES; i++) {
+      result.push_back(str(L"file_", toStr(i * 7919 % ORDER_VALUES), L".txt"));
+   }
+
+   std::mt19937 random(ORDER_SEED);
+   std::shuffle(result.begin(), result.end(), random);
+   return result;
+}
+
+static void runQuicksort(BenchmarkState& state, OrderedList& order, const p_list& values, p_list& list, p_size& current)
+{
+   while (state.keepRunning()) {
+      state.pauseTiming();
+      list = values;
+      order.load(list, current);
+      state.resumeTiming();
+
+      order.quicksort(0, static_cast<p_int>(list.size()) - 1);
+      doNotOptimize(list.front());
+   }
+
+   state.setItemsProcessed(state.iterations * values.size());
+}
+
+// order by name
+static void benchQuicksortString(BenchmarkState& state)
+{
+   const p_list values = makeShuffledNames();
+   p_list list;
+   p_size current = 0;
+
+   gen::p_indptr indices = std::make_unique<gen::OrderIndices>();
+   p_genptr<p_str> name = std::make_unique<ListElement>(list, current);
+   gen::p_ordptr unit = std::make_unique<gen::OrderUnit_Final<p_str>>(name, false, indices.get());
+   OrderedList order(indices, unit);
+
+   runQuicksort(state, order, values, list, current);
+}
+
+// order by size desc, name
+static void benchQuicksortNumberString(BenchmarkState& state)
+{
+   const p_list values = makeShuffledNames();
+   p_list list;
+   p_size current = 0;
+
+   gen::p_indptr indices = std::make_unique<gen::OrderIndices>();
+   p_genptr<p_str> name = std::make_unique<ListElement>(list, current);
+   gen::p_ordptr last = std::make_unique<gen::OrderUnit_Final<p_str>>(name, false, indices.get());
+   p_genptr<p_num> size = std::make_unique<ListElementNumber>(list, current);
+   gen::p_ordptr first = std::make_unique<gen::OrderUnit_Middle<p_num>>(size, true, last, indices.get());
+   OrderedList order(indices, first);
+
+   runQuicksort(state, order, values, list, current);
+}
+
+
+void addOrderBenchmarks(BenchmarkRunner& runner)
+{
+   runner.add(L"OrderBy::quicksort/string", benchQuicksortString);
+   runner.add(L"OrderBy::quicksort/number,string", benchQuicksortNumberString);
+}
+
+}
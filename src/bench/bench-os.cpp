@@ -0,0 +1,133 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "benchmark.h"
+#include "../perun2.h"
+#include "../os/os.h"
+
+
+namespace perun2::bench
+{
+
+p_constexpr p_char TREE_DIRECTORY_NAME[] = L"perun2-bench-tree";
+p_constexpr p_size TREE_DIRECTORIES = 10;
+p_constexpr p_size TREE_FILES_PER_DIRECTORY = 100;
+
+
+// a synthetic tree of directories and files, created next to the place the benchmark was called from
+// it exists as long as this object
+struct SyntheticTree
+{
+public:
+   SyntheticTree() = delete;
+   SyntheticTree(Perun2Process& p2)
+      : root(os_join(os_currentPath(), TREE_DIRECTORY_NAME)), perun2(p2)
+   {
+      os_createDirectory(this->root);
+
+      for (p_size d = 0; d < TREE_DIRECTORIES; d++) {
+         const p_str directory = str(L"dir_", toStr(d));
+         os_createDirectory(os_join(this->root, directory));
+         this->paths.push_back(directory);
+
+         for (p_size f = 0; f < TREE_FILES_PER_DIRECTORY; f++) {
+            const p_str file = os_join(directory, str(L"file_", toStr(f), f % 2 == 0 ? L".txt" : L".csv"));
+            // files of different sizes, some of them empty
+            const p_size size = (f * 37) % 4096;
+            os_writeBinaryFile(os_join(this->root, file), std::string(size, 'x'));
+            this->paths.push_back(file);
+            this->bytes += size;
+         }
+      }
+   };
+
+   ~SyntheticTree() noexcept
+   {
+      os_dropDirectory(this->root, this->perun2);
+   };
+
+   const p_str root;
+   // relative to the root
+   p_list paths;
+   // total size of all files
+   p_size bytes = 0;
+
+private:
+   Perun2Process& perun2;
+};
+
+
+static void runLoadAttributes(BenchmarkState& state, const p_aunit attributes)
+{
+   const Arguments arguments(os_join(os_currentPath(), TREE_DIRECTORY_NAME), p_str());
+   Perun2Process process(arguments);
+   const SyntheticTree tree(process);
+
+   p_attrptr attribute = std::make_unique<Attribute>(attributes, process);
+   FileContext context(attribute, process);
+
+   while (state.keepRunning()) {
+      for (const p_str& path : tree.paths) {
+         context.this_->value = path;
+         os_loadAttributes(context);
+         doNotOptimize(context.v_exists->value);
+      }
+   }
+
+   state.setItemsProcessed(state.iterations * tree.paths.size());
+}
+
+// only names and paths, no access to the file system
+static void benchLoadAttributesNames(BenchmarkState& state)
+{
+   runLoadAttributes(state, ATTR_PATH | ATTR_NAME | ATTR_EXTENSION | ATTR_FULLNAME | ATTR_PARENT | ATTR_DEPTH);
+}
+
+// one query of the file system for every path
+static void benchLoadAttributesFileSystem(BenchmarkState& state)
+{
+   runLoadAttributes(state, ATTR_PATH | ATTR_NAME | ATTR_EXISTS | ATTR_SIZE_FILE_ONLY
+      | ATTR_MODIFICATION | ATTR_CREATION | ATTR_HIDDEN | ATTR_READONLY);
+}
+
+// the whole tree is copied next to itself
+// the copy is deleted after every iteration and this is not measured
+static void benchCopyTree(BenchmarkState& state)
+{
+   const Arguments arguments(os_join(os_currentPath(), TREE_DIRECTORY_NAME), p_str());
+   Perun2Process process(arguments);
+   const SyntheticTree tree(process);
+   const p_str destination = str(tree.root, L"-copy");
+
+   while (state.keepRunning()) {
+      doNotOptimize(os_copyTo(tree.root, destination, false, process));
+
+      state.pauseTiming();
+      os_dropDirectory(destination, process);
+      state.resumeTiming();
+   }
+
+   state.setItemsProcessed(state.iterations * tree.paths.size());
+   state.setBytesProcessed(state.iterations * tree.bytes);
+}
+
+
+void addOsBenchmarks(BenchmarkRunner& runner)
+{
+   runner.add(L"os_loadAttributes/names", benchLoadAttributesNames);
+   runner.add(L"os_loadAttributes/file system", benchLoadAttributesFileSystem);
+   runner.add(L"os_copyTo/tree", benchCopyTree);
+}
+
+}
@@ -0,0 +1,111 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "benchmark.h"
+#include "../perun2.h"
+#include "../lexer.h"
+#include "../command/com-parse.h"
+
+
+namespace perun2::bench
+{
+
+// a bit of everything: variables, lists, conditions, loops, functions and file system commands
+p_constexpr p_char PARSE_SCRIPT_PART[] =
+   L"a = 30, -2, 6, 3, 23.3, 1\n"
+   L"print a order by number(this) desc limit 3\n"
+   L"b = 'first', 'second', 'third'\n"
+   L"if count(b where length(this) > 5) >= 2 {\n"
+   L"   print upper(b[0]) + ' ' + lower(b[1])\n"
+   L"} else {\n"
+   L"   print replace('thing in minside', 'in', '')\n"
+   L"}\n"
+   L"inside 'defchain' {\n"
+   L"   recursivefiles where extension = 'txt' and depth in 2, 3 order by name desc {\n"
+   L"      print name + ' ' + depth\n"
+   L"   }\n"
+   L"}\n"
+   L"files where name like '%report_20##%' and modification > now - 3 days order by size desc, name limit 100 {\n"
+   L"   copy to 'backup'\n"
+   L"}\n"
+   L"50 times {\n"
+   L"   if index % 7 = 0 { continue }\n"
+   L"   print index * 2 + 1\n"
+   L"}\n";
+
+p_constexpr p_size PARSE_SCRIPT_REPEATS = 20;
+
+
+static p_str makeScript()
+{
+   p_str result;
+
+   for (p_size i = 0; i < PARSE_SCRIPT_REPEATS; i++) {
+      result += PARSE_SCRIPT_PART;
+   }
+
+   return result;
+}
+
+
+static void benchTokenize(BenchmarkState& state)
+{
+   const p_str code = makeScript();
+   const Arguments arguments(os_currentPath(), code);
+   Perun2Process process(arguments);
+
+   while (state.keepRunning()) {
+      const std::vector<Token> tokens = tokenize(code, process);
+      doNotOptimize(tokens.size());
+   }
+
+   state.setBytesProcessed(state.iterations * code.size() * sizeof(p_char));
+}
+
+static void benchParseCommands(BenchmarkState& state)
+{
+   const p_str code = makeScript();
+   const Arguments arguments(os_currentPath(), code);
+
+   while (state.keepRunning()) {
+      // every parsing needs a fresh process, because variables of the script are declared in it
+      state.pauseTiming();
+      std::unique_ptr<Perun2Process> process = std::make_unique<Perun2Process>(arguments);
+      const std::vector<Token> tokens = tokenize(code, *process);
+      const Tokens tks(tokens);
+      p_comptr commands;
+      state.resumeTiming();
+
+      {
+         const ArenaScope scope(process->arena);
+         doNotOptimize(comm::parseCommands(commands, tks, *process));
+      }
+
+      state.pauseTiming();
+      commands.reset();
+      process.reset();
+      state.resumeTiming();
+   }
+
+   state.setBytesProcessed(state.iterations * code.size() * sizeof(p_char));
+}
+
+
+void addParseBenchmarks(BenchmarkRunner& runner)
+{
+   runner.add(L"tokenize", benchTokenize);
+   runner.add(L"comm::parseCommands", benchParseCommands);
+}
+
+}
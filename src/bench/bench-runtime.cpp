@@ -0,0 +1,143 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "benchmark.h"
+#include "../perun2.h"
+#include "../lexer.h"
+#include "../command/com-parse.h"
+
+
+namespace perun2::bench
+{
+
+// only variables, lists, conditions and loops
+// nothing is printed and the file system is not touched, so only the evaluation is measured
+p_constexpr p_char EVAL_SCRIPT[] =
+   L"a = 30, -2, 6, 3, 23.3, 1\n"
+   L"b = 'first', 'second', 'third'\n"
+   L"n = 0\n"
+   L"200 times {\n"
+   L"   c = a order by number(this) desc limit 3\n"
+   L"   d = upper(b[index % 3]) + ' ' + lower(b[(index + 1) % 3])\n"
+   L"   if count(b where length(this) > 5) >= 2 and d like '%ir%' {\n"
+   L"      n += length(d) + count(c)\n"
+   L"   } else {\n"
+   L"      n -= 1\n"
+   L"   }\n"
+   L"}\n";
+
+
+// parsed commands are evaluated many times, so the only difference is where their objects are
+static void runEvaluation(BenchmarkState& state, const p_bool inArena)
+{
+   const p_str code = EVAL_SCRIPT;
+   const Arguments arguments(os_currentPath(), code);
+   Perun2Process process(arguments);
+   const std::vector<Token> tokens = tokenize(code, process);
+   const Tokens tks(tokens);
+   p_comptr commands;
+
+   if (inArena) {
+      const ArenaScope scope(process.arena);
+      comm::parseCommands(commands, tks, process);
+   }
+   else {
+      comm::parseCommands(commands, tks, process);
+   }
+
+   while (state.keepRunning()) {
+      process.contexts.resetRuntimeState(process);
+      commands->run();
+   }
+
+   state.setItemsProcessed(state.iterations);
+}
+
+static void benchEvaluationArena(BenchmarkState& state)
+{
+   runEvaluation(state, true);
+}
+
+static void benchEvaluationHeap(BenchmarkState& state)
+{
+   runEvaluation(state, false);
+}
+
+
+// time from the code to a prepared script, as seen by a user who calls Perun2 again and again
+static void runStartup(BenchmarkState& state, const p_flags flags)
+{
+   const p_str location = os_currentPath();
+   const p_str code = EVAL_SCRIPT;
+
+   // the first run writes the script cache, so every measured run can read it
+   Perun2(location, code, flags).prepare();
+
+   while (state.keepRunning()) {
+      Perun2 perun2(location, code, flags);
+      doNotOptimize(perun2.prepare());
+   }
+
+   state.setItemsProcessed(state.iterations);
+}
+
+static void benchStartup(BenchmarkState& state)
+{
+   runStartup(state, FLAG_NULL);
+}
+
+static void benchStartupScriptCache(BenchmarkState& state)
+{
+   runStartup(state, FLAG_SCRIPT_CACHE);
+}
+
+
+// one prepared script is executed many times
+static void benchExecutePrepared(BenchmarkState& state)
+{
+   Perun2 perun2(os_currentPath(), EVAL_SCRIPT);
+   perun2.prepare();
+
+   while (state.keepRunning()) {
+      doNotOptimize(perun2.execute());
+   }
+
+   state.setItemsProcessed(state.iterations);
+}
+
+// the same work without reuse, every run is parsed from the beginning
+static void benchRunFresh(BenchmarkState& state)
+{
+   const p_str location = os_currentPath();
+
+   while (state.keepRunning()) {
+      Perun2 perun2(location, EVAL_SCRIPT);
+      doNotOptimize(perun2.run());
+   }
+
+   state.setItemsProcessed(state.iterations);
+}
+
+
+void addRuntimeBenchmarks(BenchmarkRunner& runner)
+{
+   runner.add(L"evaluation/arena", benchEvaluationArena);
+   runner.add(L"evaluation/heap", benchEvaluationHeap);
+   runner.add(L"startup/no cache", benchStartup);
+   runner.add(L"startup/script cache", benchStartupScriptCache);
+   runner.add(L"Perun2::execute/prepared", benchExecutePrepared);
+   runner.add(L"Perun2::run/fresh", benchRunFresh);
+}
+
+}
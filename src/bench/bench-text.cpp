@@ -0,0 +1,350 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "benchmark.h"
+#include "../datatype/generator/gen-generic.h"
+#include "../datatype/text/like.h"
+#include "../datatype/text/regexp.h"
+#include "../datatype/text/resemblance.h"
+#include "../datatype/text/text-search.h"
+#include "../datatype/text/wildcard.h"
+
+
+namespace perun2::bench
+{
+
+p_constexpr p_size TEXT_VALUES = 1000;
+// size of the content of a file searched by the command Find
+p_constexpr p_size CORPUS_SIZE = 1024 * 1024;
+
+
+// names of files, as they are met in a typical directory
+static p_list makeFileNames()
+{
+   const p_list stems = { L"report", L"invoice", L"photo", L"IMG", L"backup", L"notes", L"summary" };
+   const p_list extensions = { L"txt", L"pdf", L"jpg", L"docx", L"csv" };
+   p_list result;
+   result.reserve(TEXT_VALUES);
+
+   for (p_size i = 0; i < TEXT_VALUES; i++) {
+      result.push_back(str(stems[i % stems.size()], L"_20", toStr(10 + i % 15),
+         L"_", toStr(i), L".", extensions[i % extensions.size()]));
+   }
+
+   return result;
+}
+
+
+// the value of a string variable, that changes between calls
+struct CurrentValue : Generator<p_str>
+{
+public:
+   CurrentValue() = delete;
+   CurrentValue(const p_str& val) : value(val) { };
+
+   p_str getValue() override
+   {
+      return this->value;
+   };
+
+private:
+   const p_str& value;
+};
+
+
+static void benchWildcard(BenchmarkState& state)
+{
+   const p_list values = makeFileNames();
+   SimpleWildcardComparer comparer(L"*20*_1*.txt");
+
+   while (state.keepRunning()) {
+      for (const p_str& value : values) {
+         doNotOptimize(comparer.matches(value));
+      }
+   }
+
+   state.setItemsProcessed(state.iterations * values.size());
+}
+
+template <typename T>
+static void benchLike(BenchmarkState& state, T& comparer)
+{
+   const p_list values = makeFileNames();
+
+   while (state.keepRunning()) {
+      for (const p_str& value : values) {
+         doNotOptimize(comparer.compareToPattern(value));
+      }
+   }
+
+   state.setItemsProcessed(state.iterations * values.size());
+}
+
+// every kind of the Like operator is created directly
+// so the benchmark does not depend on how parseLikeCmp() chooses them
+static void benchLikeDefault(BenchmarkState& state)
+{
+   gen::LC_Default comparer(L"%_20#_%.t_t");
+   benchLike(state, comparer);
+}
+
+static void benchLikeStartsWith(BenchmarkState& state)
+{
+   gen::LC_StartsWith comparer(L"report%");
+   benchLike(state, comparer);
+}
+
+static void benchLikeEndsWith(BenchmarkState& state)
+{
+   gen::LC_EndsWith comparer(L"%.txt");
+   benchLike(state, comparer);
+}
+
+static void benchLikeContains(BenchmarkState& state)
+{
+   gen::LC_Contains comparer(L"%_2012_%");
+   benchLike(state, comparer);
+}
+
+static void benchLikeStartsWithChar(BenchmarkState& state)
+{
+   gen::LC_StartsWithChar comparer(L"p%");
+   benchLike(state, comparer);
+}
+
+static void benchLikeEndsWithChar(BenchmarkState& state)
+{
+   gen::LC_EndsWithChar comparer(L"%f");
+   benchLike(state, comparer);
+}
+
+static void benchLikeContainsChar(BenchmarkState& state)
+{
+   gen::LC_ContainsChar comparer(L"%v%");
+   benchLike(state, comparer);
+}
+
+static void benchLikeUnderscoreStart(BenchmarkState& state)
+{
+   gen::LC_UnderscoreStart comparer(L"_hoto_2010_0.txt");
+   benchLike(state, comparer);
+}
+
+static void benchLikeUnderscoreEnd(BenchmarkState& state)
+{
+   gen::LC_UnderscoreEnd comparer(L"notes_2015_5.pd_");
+   benchLike(state, comparer);
+}
+
+static void benchLikeUnderscoreStartEnd(BenchmarkState& state)
+{
+   gen::LC_UnderscoreStartEnd comparer(L"_eport_2010_0.tx_");
+   benchLike(state, comparer);
+}
+
+static void benchLikeEquals(BenchmarkState& state)
+{
+   gen::LC_Equals comparer(L"summary_2016_6.jpg");
+   benchLike(state, comparer);
+}
+
+static void benchLikeConstant(BenchmarkState& state)
+{
+   gen::LC_Constant comparer(true);
+   benchLike(state, comparer);
+}
+
+static void benchLikeConstantLength(BenchmarkState& state)
+{
+   gen::LC_ConstantLength comparer(18);
+   benchLike(state, comparer);
+}
+
+static void benchLikeUnderscorePercent(BenchmarkState& state)
+{
+   gen::LC_UnderscorePercent comparer(L"_nvoice%");
+   benchLike(state, comparer);
+}
+
+static void benchLikePercentUnderscore(BenchmarkState& state)
+{
+   gen::LC_PercentUnderscore comparer(L"%.pd_");
+   benchLike(state, comparer);
+}
+
+static void benchLikeOnlyDigits(BenchmarkState& state)
+{
+   gen::LC_OnlyDigits comparer(4);
+   benchLike(state, comparer);
+}
+
+static void benchLikeFieldU(BenchmarkState& state)
+{
+   gen::LC_Field_U comparer(L"photo_20__2_.jpg");
+   benchLike(state, comparer);
+}
+
+static void benchLikeFieldH(BenchmarkState& state)
+{
+   gen::LC_Field_H comparer(L"photo_20##_2#.jpg");
+   benchLike(state, comparer);
+}
+
+static void benchLikeFieldUH(BenchmarkState& state)
+{
+   gen::LC_Field_UH comparer(L"_hoto_20##_2#.jpg");
+   benchLike(state, comparer);
+}
+
+static void benchLikeEmpty(BenchmarkState& state)
+{
+   gen::LC_Empty comparer;
+   benchLike(state, comparer);
+}
+
+static void benchRegexpConst(BenchmarkState& state)
+{
+   const p_list values = makeFileNames();
+   p_str current;
+   p_genptr<p_str> value = std::make_unique<CurrentValue>(current);
+   gen::RegexpConst regexp(value, L"(report|photo)_20[0-9]{2}_[0-9]*1\\.(txt|jpg)");
+
+   while (state.keepRunning()) {
+      for (const p_str& v : values) {
+         current = v;
+         doNotOptimize(regexp.getValue());
+      }
+   }
+
+   state.setItemsProcessed(state.iterations * values.size());
+}
+
+static void benchResemblance(BenchmarkState& state)
+{
+   p_list values = makeFileNames();
+   p_str pattern = L"reprot 2012";
+
+   for (p_str& value : values) {
+      gen::prepareForResemblance(value);
+   }
+
+   gen::prepareForResemblance(pattern);
+
+   while (state.keepRunning()) {
+      for (const p_str& value : values) {
+         doNotOptimize(gen::str_resemblance(value, pattern));
+      }
+   }
+
+   state.setItemsProcessed(state.iterations * values.size());
+}
+
+// plain UTF-8 text without a byte order mark
+// the searched words appear in it rarely, so most of the bytes are just passed
+static std::string makeCorpus()
+{
+   const p_list names = makeFileNames();
+   std::string result;
+   result.reserve(CORPUS_SIZE);
+
+   for (p_size i = 0; result.size() < CORPUS_SIZE; i++) {
+      const p_str& name = names[i % names.size()];
+      result.append(name.begin(), name.end());
+      result += (i % 16 == 15) ? '\n' : ' ';
+   }
+
+   return result;
+}
+
+static p_list makeNeedles()
+{
+   return { L"invoice_2013", L"photo_2021", L"notes_2017_", L"summary_2024", L"IMG_2011_9", L".docx\n", L"_999." };
+}
+
+// one pass of the automaton for all the needles
+static void benchMultiTextSearchCount(BenchmarkState& state)
+{
+   const std::string corpus = makeCorpus();
+   MultiTextSearch search(makeNeedles());
+
+   while (state.keepRunning()) {
+      doNotOptimize(search.countIn(corpus.c_str(), corpus.size()));
+   }
+
+   state.setBytesProcessed(state.iterations * corpus.size());
+}
+
+static void benchMultiTextSearchAny(BenchmarkState& state)
+{
+   const std::string corpus = makeCorpus();
+   MultiTextSearch search({ L"not in the corpus", L"neither this" });
+
+   while (state.keepRunning()) {
+      doNotOptimize(search.isAnyFoundIn(corpus.c_str(), corpus.size()));
+   }
+
+   state.setBytesProcessed(state.iterations * corpus.size());
+}
+
+// what the automaton replaces: one pass over the data for every needle
+static void benchTextSearchEach(BenchmarkState& state)
+{
+   const std::string corpus = makeCorpus();
+   std::vector<TextSearch> searches;
+
+   for (const p_str& needle : makeNeedles()) {
+      searches.emplace_back(needle);
+   }
+
+   while (state.keepRunning()) {
+      for (const TextSearch& search : searches) {
+         doNotOptimize(search.isFoundIn(corpus.c_str(), corpus.size()));
+      }
+   }
+
+   state.setBytesProcessed(state.iterations * corpus.size());
+}
+
+
+void addTextBenchmarks(BenchmarkRunner& runner)
+{
+   runner.add(L"WildcardComparer::matches", benchWildcard);
+   runner.add(L"LC_Default", benchLikeDefault);
+   runner.add(L"LC_StartsWith", benchLikeStartsWith);
+   runner.add(L"LC_EndsWith", benchLikeEndsWith);
+   runner.add(L"LC_Contains", benchLikeContains);
+   runner.add(L"LC_StartsWithChar", benchLikeStartsWithChar);
+   runner.add(L"LC_EndsWithChar", benchLikeEndsWithChar);
+   runner.add(L"LC_ContainsChar", benchLikeContainsChar);
+   runner.add(L"LC_UnderscoreStart", benchLikeUnderscoreStart);
+   runner.add(L"LC_UnderscoreEnd", benchLikeUnderscoreEnd);
+   runner.add(L"LC_UnderscoreStartEnd", benchLikeUnderscoreStartEnd);
+   runner.add(L"LC_Equals", benchLikeEquals);
+   runner.add(L"LC_Constant", benchLikeConstant);
+   runner.add(L"LC_ConstantLength", benchLikeConstantLength);
+   runner.add(L"LC_UnderscorePercent", benchLikeUnderscorePercent);
+   runner.add(L"LC_PercentUnderscore", benchLikePercentUnderscore);
+   runner.add(L"LC_OnlyDigits", benchLikeOnlyDigits);
+   runner.add(L"LC_Field_U", benchLikeFieldU);
+   runner.add(L"LC_Field_H", benchLikeFieldH);
+   runner.add(L"LC_Field_UH", benchLikeFieldUH);
+   runner.add(L"LC_Empty", benchLikeEmpty);
+   runner.add(L"RegexpConst", benchRegexpConst);
+   runner.add(L"str_resemblance", benchResemblance);
+   runner.add(L"MultiTextSearch::countIn", benchMultiTextSearchCount);
+   runner.add(L"MultiTextSearch::isAnyFoundIn", benchMultiTextSearchAny);
+   runner.add(L"TextSearch::isFoundIn/each needle", benchTextSearchEach);
+}
+
+}
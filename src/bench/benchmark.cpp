@@ -0,0 +1,384 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "benchmark.h"
+#include "../perun2.h"
+#include "../os/os.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+
+namespace perun2::bench
+{
+
+p_constexpr p_char ARG_FILTER[] =         L"--benchmark_filter=";
+p_constexpr p_char ARG_MIN_TIME[] =       L"--benchmark_min_time=";
+p_constexpr p_char ARG_REPETITIONS[] =    L"--benchmark_repetitions=";
+p_constexpr p_char ARG_FORMAT[] =         L"--benchmark_format=";
+p_constexpr p_char ARG_OUT[] =            L"--benchmark_out=";
+p_constexpr p_char ARG_LIST[] =           L"--benchmark_list_tests";
+
+p_constexpr p_char FORMAT_CONSOLE[] =     L"console";
+p_constexpr p_char FORMAT_JSON[] =        L"json";
+
+
+static p_bool takeValue(const p_str& arg, const p_char* prefix, p_str& value)
+{
+   const p_str start(prefix);
+
+   if (arg.size() < start.size() || arg.compare(0, start.size(), start) != 0) {
+      return false;
+   }
+
+   value = arg.substr(start.size());
+   return true;
+}
+
+static p_str toFixed(const double value)
+{
+   p_ostream s;
+   s << std::fixed << std::setprecision(3) << value;
+   return s.str();
+}
+
+
+BenchmarkState::BenchmarkState(const uint64_t iters)
+   : iterations(iters), remaining(iters) { };
+
+p_bool BenchmarkState::keepRunning()
+{
+   if (! this->started) {
+      this->started = true;
+      this->start();
+   }
+
+   if (this->remaining == 0) {
+      this->stop();
+      return false;
+   }
+
+   this->remaining--;
+   return true;
+}
+
+void BenchmarkState::pauseTiming()
+{
+   this->stop();
+}
+
+void BenchmarkState::resumeTiming()
+{
+   this->start();
+}
+
+void BenchmarkState::setItemsProcessed(const uint64_t items)
+{
+   this->itemsProcessed = items;
+}
+
+void BenchmarkState::setBytesProcessed(const uint64_t bytes)
+{
+   this->bytesProcessed = bytes;
+}
+
+double BenchmarkState::getRealTime() const
+{
+   return this->realTime;
+}
+
+double BenchmarkState::getCpuTime() const
+{
+   return this->cpuTime;
+}
+
+uint64_t BenchmarkState::getItemsProcessed() const
+{
+   return this->itemsProcessed;
+}
+
+uint64_t BenchmarkState::getBytesProcessed() const
+{
+   return this->bytesProcessed;
+}
+
+void BenchmarkState::start()
+{
+   if (this->running) {
+      return;
+   }
+
+   this->running = true;
+   this->cpuStart = std::clock();
+   this->realStart = p_benchclock::now();
+}
+
+void BenchmarkState::stop()
+{
+   if (! this->running) {
+      return;
+   }
+
+   const p_benchtime realEnd = p_benchclock::now();
+   const std::clock_t cpuEnd = std::clock();
+   this->running = false;
+
+   this->realTime += static_cast<double>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(realEnd - this->realStart).count());
+   this->cpuTime += static_cast<double>(cpuEnd - this->cpuStart)
+      * 1000000000.0 / static_cast<double>(CLOCKS_PER_SEC);
+}
+
+
+void BenchmarkRunner::add(const p_str& name, const p_benchfunc function)
+{
+   this->benchmarks.push_back({ name, function });
+}
+
+int BenchmarkRunner::run(const p_int argc, p_char* const argv[])
+{
+   if (! this->parseArguments(argc, argv)) {
+      return EXITCODE_CLI_ERROR;
+   }
+
+   if (! this->json) {
+      std::wcout << std::left << std::setw(48) << L"Benchmark"
+         << std::right << std::setw(16) << L"Time (ns)"
+         << std::setw(16) << L"CPU (ns)"
+         << std::setw(14) << L"Iterations" << std::endl;
+   }
+
+   for (const Benchmark& benchmark : this->benchmarks) {
+      if (! this->filter.empty() && benchmark.name.find(this->filter) == p_str::npos) {
+         continue;
+      }
+
+      std::vector<BenchmarkResult> repeated;
+
+      for (p_size i = 0; i < this->repetitions; i++) {
+         BenchmarkResult result = this->runOnce(benchmark);
+         this->print(result);
+         repeated.push_back(result);
+         this->results.push_back(result);
+      }
+
+      if (this->repetitions > 1) {
+         this->addAggregates(benchmark.name, repeated);
+      }
+   }
+
+   if (this->json) {
+      std::wcout << this->toJson() << std::endl;
+   }
+
+   if (! this->outputPath.empty() && ! os_writeBinaryFile(this->outputPath, os_toUtf8(this->toJson()))) {
+      std::wcerr << L"Results could not be written to " << this->outputPath << std::endl;
+      return EXITCODE_RUNTIME_ERROR;
+   }
+
+   return EXITCODE_OK;
+}
+
+p_bool BenchmarkRunner::parseArguments(const p_int argc, p_char* const argv[])
+{
+   for (p_int i = 1; i < argc; i++) {
+      const p_str arg = argv[i];
+      p_str value;
+
+      if (arg == ARG_LIST) {
+         for (const Benchmark& benchmark : this->benchmarks) {
+            std::wcout << benchmark.name << std::endl;
+         }
+
+         this->benchmarks.clear();
+      }
+      else if (takeValue(arg, ARG_FILTER, value)) {
+         this->filter = value;
+      }
+      else if (takeValue(arg, ARG_OUT, value)) {
+         this->outputPath = value;
+      }
+      else if (takeValue(arg, ARG_FORMAT, value)) {
+         if (value == FORMAT_JSON) {
+            this->json = true;
+         }
+         else if (value == FORMAT_CONSOLE) {
+            this->json = false;
+         }
+         else {
+            std::wcerr << L"Unknown output format: " << value << std::endl;
+            return false;
+         }
+      }
+      else if (takeValue(arg, ARG_MIN_TIME, value)) {
+         // Google Benchmark accepts also a suffix of seconds, like 0.5s
+         if (! value.empty() && value.back() == L's') {
+            value.pop_back();
+         }
+
+         try {
+            this->minTime = std::stod(value);
+         }
+         catch (...) {
+            std::wcerr << L"Invalid value of option " << arg << std::endl;
+            return false;
+         }
+      }
+      else if (takeValue(arg, ARG_REPETITIONS, value)) {
+         try {
+            this->repetitions = std::max(static_cast<p_size>(std::stoul(value)), static_cast<p_size>(1));
+         }
+         catch (...) {
+            std::wcerr << L"Invalid value of option " << arg << std::endl;
+            return false;
+         }
+      }
+      else {
+         std::wcerr << L"Unknown option: " << arg << std::endl;
+         return false;
+      }
+   }
+
+   return true;
+}
+
+BenchmarkResult BenchmarkRunner::runOnce(const Benchmark& benchmark) const
+{
+   const double minNanoseconds = this->minTime * 1000000000.0;
+   uint64_t iterations = 1;
+
+   while (true) {
+      BenchmarkState state(iterations);
+      benchmark.function(state);
+      const double elapsed = state.getRealTime();
+
+      if (elapsed >= minNanoseconds || iterations >= BENCHMARK_MAX_ITERATIONS) {
+         const double seconds = elapsed / 1000000000.0;
+         const double iters = static_cast<double>(iterations);
+
+         return { benchmark.name, benchmark.name, p_str(), iterations,
+            elapsed / iters,
+            state.getCpuTime() / iters,
+            seconds > 0.0 ? static_cast<double>(state.getItemsProcessed()) / seconds : 0.0,
+            seconds > 0.0 ? static_cast<double>(state.getBytesProcessed()) / seconds : 0.0 };
+      }
+
+      // aim a little above the minimal time, so the next attempt is likely the last one
+      const double expected = elapsed <= 0.0
+         ? static_cast<double>(BENCHMARK_MAX_GROWTH)
+         : std::min(minNanoseconds * 1.4 / elapsed, static_cast<double>(BENCHMARK_MAX_GROWTH));
+
+      iterations = std::min(std::max(static_cast<uint64_t>(static_cast<double>(iterations) * expected), iterations + 1),
+         BENCHMARK_MAX_ITERATIONS);
+   }
+}
+
+void BenchmarkRunner::addAggregates(const p_str& name, const std::vector<BenchmarkResult>& repetitions)
+{
+   const double count = static_cast<double>(repetitions.size());
+   BenchmarkResult mean = { str(name, L"_mean"), name, L"mean", repetitions[0].iterations, 0.0, 0.0, 0.0, 0.0 };
+
+   for (const BenchmarkResult& r : repetitions) {
+      mean.realTime += r.realTime / count;
+      mean.cpuTime += r.cpuTime / count;
+      mean.itemsPerSecond += r.itemsPerSecond / count;
+      mean.bytesPerSecond += r.bytesPerSecond / count;
+   }
+
+   std::vector<BenchmarkResult> sorted = repetitions;
+   std::sort(sorted.begin(), sorted.end(), [](const BenchmarkResult& a, const BenchmarkResult& b) {
+      return a.realTime < b.realTime;
+   });
+
+   BenchmarkResult median = sorted[sorted.size() / 2];
+   median.name = str(name, L"_median");
+   median.aggregate = L"median";
+
+   BenchmarkResult stddev = { str(name, L"_stddev"), name, L"stddev", mean.iterations, 0.0, 0.0, 0.0, 0.0 };
+
+   for (const BenchmarkResult& r : repetitions) {
+      stddev.realTime += (r.realTime - mean.realTime) * (r.realTime - mean.realTime);
+      stddev.cpuTime += (r.cpuTime - mean.cpuTime) * (r.cpuTime - mean.cpuTime);
+   }
+
+   stddev.realTime = std::sqrt(stddev.realTime / (count - 1.0));
+   stddev.cpuTime = std::sqrt(stddev.cpuTime / (count - 1.0));
+
+   for (const BenchmarkResult& aggregate : { mean, median, stddev }) {
+      this->print(aggregate);
+      this->results.push_back(aggregate);
+   }
+}
+
+void BenchmarkRunner::print(const BenchmarkResult& result) const
+{
+   if (this->json) {
+      return;
+   }
+
+   std::wcout << std::left << std::setw(48) << result.name
+      << std::right << std::setw(16) << toFixed(result.realTime)
+      << std::setw(16) << toFixed(result.cpuTime)
+      << std::setw(14) << result.iterations << std::endl;
+}
+
+p_str BenchmarkRunner::toJson() const
+{
+   std::time_t now = std::time(nullptr);
+   p_char date[32];
+   std::wcsftime(date, 32, L"%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+   p_str result = str(L"{\"context\":{\"date\":", str_toJson(date),
+      L",\"executable\":\"perun2_bench\",\"num_cpus\":", toStr(std::thread::hardware_concurrency()),
+      L",\"library_build_type\":\"release\"},\"benchmarks\":[");
+
+   for (p_size i = 0; i < this->results.size(); i++) {
+      const BenchmarkResult& r = this->results[i];
+
+      if (i != 0) {
+         result += CHAR_COMMA;
+      }
+
+      result += str(L"{\"name\":", str_toJson(r.name),
+         L",\"run_name\":", str_toJson(r.runName),
+         L",\"run_type\":", r.aggregate.empty() ? L"\"iteration\"" : L"\"aggregate\"",
+         L",\"repetitions\":", toStr(this->repetitions));
+
+      if (! r.aggregate.empty()) {
+         result += str(L",\"aggregate_name\":", str_toJson(r.aggregate));
+      }
+
+      result += str(L",\"iterations\":", toStr(r.iterations),
+         L",\"real_time\":", toFixed(r.realTime),
+         L",\"cpu_time\":", toFixed(r.cpuTime),
+         L",\"time_unit\":\"ns\"");
+
+      if (r.itemsPerSecond > 0.0) {
+         result += str(L",\"items_per_second\":", toFixed(r.itemsPerSecond));
+      }
+
+      if (r.bytesPerSecond > 0.0) {
+         result += str(L",\"bytes_per_second\":", toFixed(r.bytesPerSecond));
+      }
+
+      result += CHAR_CLOSING_CURLY_BRACKET;
+   }
+
+   result += L"]}";
+   return result;
+}
+
+}
@@ -0,0 +1,149 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "../datatype/primitives.h"
+#include <chrono>
+#include <ctime>
+#include <vector>
+
+
+namespace perun2::bench
+{
+
+typedef std::chrono::steady_clock   p_benchclock;
+typedef p_benchclock::time_point    p_benchtime;
+
+
+// every benchmark runs at least this long, unless the option --benchmark_min_time says otherwise
+p_constexpr double BENCHMARK_DEFAULT_MIN_TIME = 0.5;
+
+// the number of iterations grows at most this many times between two attempts
+p_constexpr uint64_t BENCHMARK_MAX_GROWTH = 10;
+p_constexpr uint64_t BENCHMARK_MAX_ITERATIONS = 1000000000;
+
+
+// the body of a benchmark repeats the measured operation as long as keepRunning() says so
+// everything before the loop is the preparation and is not measured
+// work done inside the loop, that should not be measured, goes between pauseTiming() and resumeTiming()
+struct BenchmarkState
+{
+public:
+   BenchmarkState() = delete;
+   BenchmarkState(const uint64_t iters);
+
+   p_bool keepRunning();
+   void pauseTiming();
+   void resumeTiming();
+
+   // optional throughput of the benchmark, counted for all iterations together
+   void setItemsProcessed(const uint64_t items);
+   void setBytesProcessed(const uint64_t bytes);
+
+   const uint64_t iterations;
+
+   // in nanoseconds
+   double getRealTime() const;
+   double getCpuTime() const;
+   uint64_t getItemsProcessed() const;
+   uint64_t getBytesProcessed() const;
+
+private:
+   void start();
+   void stop();
+
+   uint64_t remaining;
+   p_bool started = false;
+   p_bool running = false;
+   p_benchtime realStart;
+   std::clock_t cpuStart = 0;
+   double realTime = 0.0;
+   double cpuTime = 0.0;
+   uint64_t itemsProcessed = 0;
+   uint64_t bytesProcessed = 0;
+};
+
+
+typedef void (*p_benchfunc)(BenchmarkState& state);
+
+
+struct Benchmark
+{
+   p_str name;
+   p_benchfunc function;
+};
+
+
+// one line of the results
+// it is either one repetition of a benchmark or an aggregate of all its repetitions
+struct BenchmarkResult
+{
+   p_str name;
+   p_str runName;
+   p_str aggregate;
+   uint64_t iterations;
+   // average time of one iteration in nanoseconds
+   double realTime;
+   double cpuTime;
+   double itemsPerSecond;
+   double bytesPerSecond;
+};
+
+
+// the same command-line options and the same JSON schema as Google Benchmark
+// so results of Perun2 can be compared by its tools
+struct BenchmarkRunner
+{
+public:
+   void add(const p_str& name, const p_benchfunc function);
+
+   // returns the exit code of the program
+   int run(const p_int argc, p_char* const argv[]);
+
+private:
+   p_bool parseArguments(const p_int argc, p_char* const argv[]);
+   BenchmarkResult runOnce(const Benchmark& benchmark) const;
+   void addAggregates(const p_str& name, const std::vector<BenchmarkResult>& repetitions);
+   void print(const BenchmarkResult& result) const;
+   p_str toJson() const;
+
+   std::vector<Benchmark> benchmarks;
+   std::vector<BenchmarkResult> results;
+
+   p_str filter;
+   p_str outputPath;
+   p_bool json = false;
+   double minTime = BENCHMARK_DEFAULT_MIN_TIME;
+   p_size repetitions = 1;
+};
+
+
+// the compiler is not allowed to drop the computation of this value
+template <typename T>
+inline void doNotOptimize(const T& value)
+{
+   asm volatile("" : : "r,m"(value) : "memory");
+}
+
+
+// benchmarks of every part of Perun2 are added by one function
+void addParseBenchmarks(BenchmarkRunner& runner);
+void addTextBenchmarks(BenchmarkRunner& runner);
+void addOrderBenchmarks(BenchmarkRunner& runner);
+void addMathBenchmarks(BenchmarkRunner& runner);
+void addOsBenchmarks(BenchmarkRunner& runner);
+void addRuntimeBenchmarks(BenchmarkRunner& runner);
+
+}
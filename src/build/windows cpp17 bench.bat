@@ -0,0 +1,4 @@
+cmake -S .. -B . -G "MinGW Makefiles" -DUSED_CPP_STANDARD=17
+cmake --build . --target perun2_bench
+perun2_bench.exe --benchmark_out=perun2-bench.json
+pause
\ No newline at end of file
@@ -0,0 +1,88 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "cancellation.h"
+#include <algorithm>
+#include <chrono>
+
+
+namespace perun2
+{
+
+void CancellationToken::cancel()
+{
+   // subscribers are interrupted under the lock
+   // so none of them can be unsubscribed and destroyed in the meantime
+   const std::lock_guard<std::mutex> lock(this->mutex);
+   this->cancelled.store(true, std::memory_order_release);
+
+   for (Cancellable* operation : this->operations) {
+      operation->cancel();
+   }
+
+   this->cancelledEvent.notify_all();
+}
+
+p_bool CancellationToken::waitFor(const p_nint ms)
+{
+   // spurious wake-ups do not extend the wait, as it is measured against a fixed deadline
+   p_nint remaining = ms;
+   std::unique_lock<std::mutex> lock(this->mutex);
+
+   while (remaining > 0) {
+      const p_nint part = std::min(remaining, CANCELLATION_MAX_WAIT_MS);
+      const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(part);
+
+      const p_bool cancelled = this->cancelledEvent.wait_until(lock, deadline, [this]() {
+         return this->cancelled.load(std::memory_order_relaxed);
+      });
+
+      if (cancelled) {
+         return false;
+      }
+
+      remaining -= part;
+   }
+
+   return !this->cancelled.load(std::memory_order_relaxed);
+}
+
+void CancellationToken::reset()
+{
+   this->cancelled.store(false, std::memory_order_release);
+}
+
+p_bool CancellationToken::subscribe(Cancellable* operation)
+{
+   const std::lock_guard<std::mutex> lock(this->mutex);
+
+   if (this->cancelled.load(std::memory_order_relaxed)) {
+      return false;
+   }
+
+   this->operations.push_back(operation);
+   return true;
+}
+
+void CancellationToken::unsubscribe(Cancellable* operation)
+{
+   const std::lock_guard<std::mutex> lock(this->mutex);
+   const auto it = std::find(this->operations.begin(), this->operations.end(), operation);
+
+   if (it != this->operations.end()) {
+      this->operations.erase(it);
+   }
+}
+
+}
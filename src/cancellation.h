@@ -0,0 +1,77 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "datatype/primitives.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+
+namespace perun2
+{
+
+// longest single wait of the condition variable
+// longer sleeps are divided, so the deadline never overflows the clock
+p_constexpr p_nint CANCELLATION_MAX_WAIT_MS = 24LL * 60 * 60 * 1000;
+
+// blocking operation, that has to be interrupted at once, when its Perun2 is cancelled
+// (a child process, a sleep...)
+struct Cancellable
+{
+public:
+   virtual ~Cancellable() noexcept = default;
+
+   // called from the thread that cancels, while the operation may still be running
+   virtual void cancel() = 0;
+};
+
+
+// stop request of one instance of Perun2
+// it can be set from any thread (Ctrl+C, the daemon, watch mode)
+// the interpreter and its worker threads poll it for every element, so reading is a single atomic load
+struct CancellationToken
+{
+public:
+   p_bool isCancelled() const
+   {
+      return this->cancelled.load(std::memory_order_acquire);
+   };
+
+   // set the flag, wake every waiting thread and interrupt every subscribed operation
+   void cancel();
+
+   // block the calling thread for the given time
+   // it wakes up at once, if the token is cancelled
+   // return false, if the wait was cut short by cancellation
+   p_bool waitFor(const p_nint ms);
+
+   // prepare for the next run of the same script
+   void reset();
+
+   // return false, if the token has already been cancelled
+   // then the operation should not start at all
+   p_bool subscribe(Cancellable* operation);
+   void unsubscribe(Cancellable* operation);
+
+private:
+   std::atomic<p_bool> cancelled{false};
+   std::mutex mutex;
+   std::condition_variable cancelledEvent;
+   std::vector<Cancellable*> operations;
+};
+
+}
@@ -50,12 +50,29 @@ void help()
    logger.print(L"  --version    Display interpreter version information.");
    logger.print(str(L"  --website    Enter the official ", metadata::NAME, L" website."));
    logger.print(str(L"  --docs       Enter the official ", metadata::NAME, L" documentation."));
+   logger.print(str(L"  --daemon     Run in the background and execute jobs sent to the pipe ", STRING_DAEMON_PIPE, L"."));
+   logger.print(L"  --profile    Measure time and calls of every command, expression and file system operation.");
+   logger.print(L"               Print the results at the end. Use --profile=json or --profile=trace to write them");
+   logger.print(str(L"               to the file ", PROFILE_JSON_FILE_NAME, L" or ", PROFILE_TRACE_FILE_NAME, L" (Chrome trace format) instead."));
+   logger.print(L"  --stats      Count file system operations and measure their durations. Print a summary at the end.");
+   logger.print(L"  --output=json");
+   logger.print(L"               Print logs of commands as JSON Lines records with fields operation, source, destination,");
+   logger.print(L"               success, error and timestamp. Print writes lists and definitions as JSON arrays.");
+   logger.print(L"  --jobs=<n>   Let commands Run in a loop start up to n processes at once. Their logs keep the");
+   logger.print(L"               order of the loop and 'success' is set at its end. Loops that read 'success' run one by one.");
+   logger.print(L"  --watch      Run the script and then again after every change inside of the working location.");
+   logger.print(L"               A burst of changes is one run. After a run that modified something, the script runs");
+   logger.print(L"               again until a run modifies nothing, so files added meanwhile are not missed. Stop with Ctrl+C.");
+   logger.print(L"               Only the working location is watched, not other places the script reads.");
    logger.print(str(L"  -c <value>   Pass ", metadata::NAME, L" code to run."));
    logger.print(L"  -d <value>   Set working location to certain value.");
    logger.print(L"  -h           Set working location to the place where this command was called from.");
    logger.print(L"  -n           Run in noomit mode (iterate all filesystem elements with no exceptions).");
    logger.print(L"  -s           Run in silent mode (no command log messages).");
    logger.print(L"  -m           Static analysis. Check code correctness without running it. Print 'good' if no error detected.");
+   logger.print(L"  -p           Use precompiled script cache. Skip lexical analysis if this code has been run before.");
+   logger.print(L"               Keep metadata of images and videos between runs.");
+   logger.print(L"  -a           Copy and move asynchronously in loops of core commands. Logs keep their order.");
 }
 
 namespace error
@@ -120,6 +137,24 @@ namespace error
       Logger logger;
       logger.print(str(L"Command-line error: input file '", fileName, L"' could not be read."));
    }
+
+   void daemonPipe()
+   {
+      Logger logger;
+      logger.print(str(L"Command-line error: pipe '", STRING_DAEMON_PIPE, L"' could not be created."));
+   }
+
+   void daemonPipeTaken()
+   {
+      Logger logger;
+      logger.print(str(L"Command-line error: pipe '", STRING_DAEMON_PIPE, L"' is already used by another process."));
+   }
+
+   void watchLocation(const p_str& location)
+   {
+      Logger logger;
+      logger.print(str(L"Command-line error: changes of location '", location, L"' cannot be watched."));
+   }
 }
 
 }
@@ -37,6 +37,9 @@ namespace error
    void fileNotFound(const p_str& fileName);
    void wrongFileExtension();
    void fileReadFailure(const p_str& fileName);
+   void daemonPipe();
+   void daemonPipeTaken();
+   void watchLocation(const p_str& location);
 }
 
 }
@@ -29,23 +29,20 @@ void C_CopyTo::run()
    p_str n = os_trim(location->getValue());
 
    if (!this->context->v_exists->value || os_isInvalid(n) || !os_hasParentDirectory(oldPath)) {
-      this->perun2.logger.log(L"Failed to copy ", getCCName(oldPath));
-      this->perun2.contexts.success->value = false;
+      this->fail(oldPath);
       return;
    }
 
    const p_str newLoc = os_leftJoin(this->locationContext->location->value, n);
 
    if (newLoc.empty()) {
-      this->perun2.logger.log(L"Failed to copy ", getCCName(oldPath));
-      this->perun2.contexts.success->value = false;
+      this->fail(oldPath);
       return;
    }
 
    if (!os_directoryExists(newLoc)) {
       if (!(os_hasParentDirectory(newLoc) && os_createDirectory(newLoc))) {
-         this->perun2.logger.log(L"Failed to copy ", getCCName(oldPath));
-         this->perun2.contexts.success->value = false;
+         this->fail(oldPath);
          return;
       }
    }
@@ -53,25 +50,49 @@ void C_CopyTo::run()
    const p_str fulln = os_fullname(oldPath);
    const p_str newPath = str(newLoc, OS_SEPARATOR, fulln);
 
+   if (this->pipeline != nullptr) {
+      this->pipeline->awaitPath(newPath);
+   }
+
    if (os_exists(newPath)) {
       if (!(forced && !(this->context->v_isdirectory->value && os_isAncestor(oldPath, newPath))
          && os_drop(newPath, this->perun2))) 
       {
-         this->perun2.logger.log(L"Failed to copy ", getCCName(oldPath));
-         this->perun2.contexts.success->value = false;
+         this->fail(oldPath);
          return;
       }
    }
 
+   if (this->pipeline != nullptr) {
+      this->pipeline->addTransfer(TransferType::tt_Copy, oldPath, newPath, this->context->v_isfile->value,
+         str(L"Copy ", getCCName(oldPath), L" to ", getCCName(newLoc)),
+         str(L"Failed to copy ", getCCName(oldPath)));
+      this->perun2.contexts.success->value = true;
+      return;
+   }
+
    const p_bool s = os_copyTo(oldPath, newPath, this->context->v_isfile->value, this->perun2);
    this->perun2.contexts.success->value = s;
 
    if (s) {
-      this->perun2.logger.log(L"Copy ", getCCName(oldPath), L" to ", getCCName(newLoc));
+      this->perun2.logger.logOperation(LogOperation::lo_Copy, oldPath, newPath, true, L"Copy ", getCCName(oldPath), L" to ", getCCName(newLoc));
+   }
+   else {
+      this->perun2.logger.logOperation(LogOperation::lo_Copy, oldPath, newPath, false, L"Failed to copy ", getCCName(oldPath));
+   }
+}
+
+void C_CopyTo::fail(const p_str& oldPath)
+{
+   if (this->pipeline == nullptr) {
+      this->perun2.logger.logOperation(LogOperation::lo_Copy, oldPath, p_str(), false, L"Failed to copy ", getCCName(oldPath));
    }
    else {
-      this->perun2.logger.log(L"Failed to copy ", getCCName(oldPath));
+      // earlier transfers may still be in progress, so this log has to wait for them
+      this->pipeline->addFailure(LogOperation::lo_Copy, oldPath, str(L"Failed to copy ", getCCName(oldPath)));
    }
+
+   this->perun2.contexts.success->value = false;
 }
 
 void C_CopyTo_Stack::run()
@@ -82,7 +103,7 @@ void C_CopyTo_Stack::run()
    p_str n = os_trim(location->getValue());
 
    if (!this->context->v_exists->value || os_isInvalid(n) || !os_hasParentDirectory(oldPath)) {
-      this->perun2.logger.log(L"Failed to copy ", getCCName(oldPath));
+      this->perun2.logger.logOperation(LogOperation::lo_Copy, oldPath, p_str(), false, L"Failed to copy ", getCCName(oldPath));
       this->perun2.contexts.success->value = false;
       return;
    }
@@ -90,14 +111,14 @@ void C_CopyTo_Stack::run()
    p_str newLoc = os_leftJoin(this->locationContext->location->value, n);
    
    if (newLoc.empty()) {
-      this->perun2.logger.log(L"Failed to copy ", getCCName(oldPath));
+      this->perun2.logger.logOperation(LogOperation::lo_Copy, oldPath, p_str(), false, L"Failed to copy ", getCCName(oldPath));
       this->perun2.contexts.success->value = false;
       return;
    }
 
    if (!os_directoryExists(newLoc)) {
       if (!(os_hasParentDirectory(newLoc) && os_createDirectory(newLoc))) {
-         this->perun2.logger.log(L"Failed to copy ", getCCName(oldPath));
+         this->perun2.logger.logOperation(LogOperation::lo_Copy, oldPath, p_str(), false, L"Failed to copy ", getCCName(oldPath));
          this->perun2.contexts.success->value = false;
          return;
       }
@@ -122,10 +143,10 @@ void C_CopyTo_Stack::run()
    this->perun2.contexts.success->value = s;
 
    if (s) {
-      this->perun2.logger.log(L"Copy ", getCCName(oldPath), L" to ", getCCName(newLoc));
+      this->perun2.logger.logOperation(LogOperation::lo_Copy, oldPath, newPath, true, L"Copy ", getCCName(oldPath), L" to ", getCCName(newLoc));
    }
    else {
-      this->perun2.logger.log(L"Failed to copy ", getCCName(oldPath));
+      this->perun2.logger.logOperation(LogOperation::lo_Copy, oldPath, newPath, false, L"Failed to copy ", getCCName(oldPath));
    }
 }
 
@@ -139,7 +160,7 @@ void C_CopyToAs::run()
 
    if (!this->context->v_exists->value || os_isInvalid(fulln) || os_isInvalid(loc) || !os_hasParentDirectory(oldPath))
    {
-      this->perun2.logger.log(L"Failed to copy ", getCCName(oldPath));
+      this->perun2.logger.logOperation(LogOperation::lo_Copy, oldPath, p_str(), false, L"Failed to copy ", getCCName(oldPath));
       this->perun2.contexts.success->value = false;
       return;
    }
@@ -153,7 +174,7 @@ void C_CopyToAs::run()
    const p_str newLoc = os_leftJoin(this->locationContext->location->value, loc);
 
    if (newLoc.empty()) {
-      this->perun2.logger.log(L"Failed to copy ", getCCName(oldPath));
+      this->perun2.logger.logOperation(LogOperation::lo_Copy, oldPath, p_str(), false, L"Failed to copy ", getCCName(oldPath));
       this->perun2.contexts.success->value = false;
       return;
    }
@@ -161,7 +182,7 @@ void C_CopyToAs::run()
 
    if (!os_directoryExists(newLoc)) {
       if (!(os_hasParentDirectory(newLoc) && os_createDirectory(newLoc))) {
-         this->perun2.logger.log(L"Failed to copy ", getCCName(oldPath));
+         this->perun2.logger.logOperation(LogOperation::lo_Copy, oldPath, p_str(), false, L"Failed to copy ", getCCName(oldPath));
          this->perun2.contexts.success->value = false;
          return;
       }
@@ -173,7 +194,7 @@ void C_CopyToAs::run()
       if (!(forced && !(this->context->v_isdirectory->value && os_isAncestor(oldPath, newPath))
             && os_drop(newPath, this->perun2)))
       {
-         this->perun2.logger.log(L"Failed to copy ", getCCName(oldPath));
+         this->perun2.logger.logOperation(LogOperation::lo_Copy, oldPath, newPath, false, L"Failed to copy ", getCCName(oldPath));
          this->perun2.contexts.success->value = false;
          return;
       }
@@ -183,10 +204,10 @@ void C_CopyToAs::run()
    this->perun2.contexts.success->value = s;
 
    if (s) {
-      this->perun2.logger.log(L"Copy ", getCCName(oldPath), L" to ", getCCName(newLoc), L" as '", fulln, L"'");
+      this->perun2.logger.logOperation(LogOperation::lo_Copy, oldPath, newPath, true, L"Copy ", getCCName(oldPath), L" to ", getCCName(newLoc), L" as '", fulln, L"'");
    }
    else {
-      this->perun2.logger.log(L"Failed to copy ", getCCName(oldPath));
+      this->perun2.logger.logOperation(LogOperation::lo_Copy, oldPath, newPath, false, L"Failed to copy ", getCCName(oldPath));
    }
 }
 
@@ -200,7 +221,7 @@ void C_CopyToAs_Stack::run()
 
    if (!this->context->v_exists->value || os_isInvalid(fulln) || os_isInvalid(loc) || !os_hasParentDirectory(oldPath))
    {
-      this->perun2.logger.log(L"Failed to copy ", getCCName(oldPath));
+      this->perun2.logger.logOperation(LogOperation::lo_Copy, oldPath, p_str(), false, L"Failed to copy ", getCCName(oldPath));
       this->perun2.contexts.success->value = false;
       return;
    }
@@ -208,7 +229,7 @@ void C_CopyToAs_Stack::run()
    const p_str newLoc = os_leftJoin(this->locationContext->location->value, loc);
 
    if (newLoc.empty()) {
-      this->perun2.logger.log(L"Failed to copy ", getCCName(oldPath));
+      this->perun2.logger.logOperation(LogOperation::lo_Copy, oldPath, p_str(), false, L"Failed to copy ", getCCName(oldPath));
       this->perun2.contexts.success->value = false;
       return;
    }
@@ -217,7 +238,7 @@ void C_CopyToAs_Stack::run()
 
    if (!os_directoryExists(newLoc)) {
       if (!(os_hasParentDirectory(newLoc) && os_createDirectory(newLoc))) {
-         this->perun2.logger.log(L"Failed to copy ", getCCName(oldPath));
+         this->perun2.logger.logOperation(LogOperation::lo_Copy, oldPath, p_str(), false, L"Failed to copy ", getCCName(oldPath));
          this->perun2.contexts.success->value = false;
          return;
       }
@@ -256,10 +277,10 @@ void C_CopyToAs_Stack::run()
    this->perun2.contexts.success->value = s;
 
    if (s) {
-      this->perun2.logger.log(L"Copy ", getCCName(oldPath), L" to ", getCCName(newLoc), L" as '", fulln, L"'");
+      this->perun2.logger.logOperation(LogOperation::lo_Copy, oldPath, newPath, true, L"Copy ", getCCName(oldPath), L" to ", getCCName(newLoc), L" as '", fulln, L"'");
    }
    else {
-      this->perun2.logger.log(L"Failed to copy ", getCCName(oldPath));
+      this->perun2.logger.logOperation(LogOperation::lo_Copy, oldPath, newPath, false, L"Failed to copy ", getCCName(oldPath));
    }
 }
 
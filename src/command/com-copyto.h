@@ -15,6 +15,7 @@
 #pragma once
 
 #include "com-core.h"
+#include "com-pipeline.h"
 
 
 namespace perun2::comm
@@ -25,14 +26,21 @@ struct C_CopyTo : CoreCommand
 public:
    C_CopyTo(p_genptr<p_str>& loc, const p_bool save,
       const p_bool forc, FileContext* ctx, Perun2Process& p2)
-      : location(std::move(loc)), saveChanges(save), forced(forc), CoreCommand(save, ctx, p2) { };
+      : location(std::move(loc)), saveChanges(save), forced(forc), pipeline(nullptr), CoreCommand(save, ctx, p2) { };
+   C_CopyTo(p_genptr<p_str>& loc, const p_bool save, const p_bool forc,
+      TransferPipeline* pip, FileContext* ctx, Perun2Process& p2)
+      : location(std::move(loc)), saveChanges(save), forced(forc), pipeline(pip), CoreCommand(save, ctx, p2) { };
 
    void run() override;
 
 protected:
+   void fail(const p_str& oldPath);
+
    p_genptr<p_str> location;
    const p_bool saveChanges;
    const p_bool forced;
+   // if not null, the copy itself is performed in the background
+   TransferPipeline* pipeline;
 };
 
 
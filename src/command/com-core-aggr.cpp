@@ -138,22 +138,22 @@ void C_AggrSelect_List::run()
 
 void logCopyError(Perun2Process& p2, const p_str& name)
 {
-   p2.logger.log(L"Failed to copy ", getCCNameShort(name));
+   p2.logger.logOperation(LogOperation::lo_Copy, name, p_str(), false, L"Failed to copy ", getCCNameShort(name));
 }
 
 void logCopySuccess(Perun2Process& p2, const p_str& name)
 {
-   p2.logger.log(L"Copy ", getCCNameShort(name));
+   p2.logger.logOperation(LogOperation::lo_Copy, name, p_str(), true, L"Copy ", getCCNameShort(name));
 }
 
 void logSelectError(Perun2Process& p2, const p_str& name)
 {
-   p2.logger.log(L"Failed to select ", getCCNameShort(name));
+   p2.logger.logOperation(LogOperation::lo_Select, name, p_str(), false, L"Failed to select ", getCCNameShort(name));
 }
 
 void logSelectSuccess(Perun2Process& p2, const p_str& name)
 {
-   p2.logger.log(L"Select ", getCCNameShort(name));
+   p2.logger.logOperation(LogOperation::lo_Select, name, p_str(), true, L"Select ", getCCNameShort(name));
 }
 
 
@@ -35,11 +35,11 @@ void C_Delete::run()
    this->perun2.contexts.success->value = s;
 
    if (s) {
-      this->perun2.logger.log(L"Delete ", getCCName(this->context->v_path->value));
+      this->perun2.logger.logOperation(LogOperation::lo_Delete, this->context->v_path->value, p_str(), true, L"Delete ", getCCName(this->context->v_path->value));
       this->context->reloadData();
    }
    else {
-      this->perun2.logger.log(L"Failed to delete ", getCCName(this->context->v_path->value));
+      this->perun2.logger.logOperation(LogOperation::lo_Delete, this->context->v_path->value, p_str(), false, L"Failed to delete ", getCCName(this->context->v_path->value));
    }
 }
 
@@ -51,13 +51,13 @@ void C_Drop::run()
    this->perun2.contexts.success->value = s;
 
    if (s) {
-      this->perun2.logger.log(L"Drop ", getCCName(this->context->v_path->value));
+      this->perun2.logger.logOperation(LogOperation::lo_Drop, this->context->v_path->value, p_str(), true, L"Drop ", getCCName(this->context->v_path->value));
       if (saveChanges) {
          this->context->reloadData();
       }
    }
    else {
-      this->perun2.logger.log(L"Failed to drop ", getCCName(this->context->v_path->value));
+      this->perun2.logger.logOperation(LogOperation::lo_Drop, this->context->v_path->value, p_str(), false, L"Failed to drop ", getCCName(this->context->v_path->value));
    }
 }
 
@@ -69,13 +69,13 @@ void C_Hide::run()
    this->perun2.contexts.success->value = s;
 
    if (s) {
-      this->perun2.logger.log(L"Hide ", getCCName(this->context->v_path->value));
+      this->perun2.logger.logOperation(LogOperation::lo_Hide, this->context->v_path->value, p_str(), true, L"Hide ", getCCName(this->context->v_path->value));
       if (saveChanges) {
          this->context->v_hidden->value = true;
       }
    }
    else {
-      this->perun2.logger.log(L"Failed to hide ", getCCName(this->context->v_path->value));
+      this->perun2.logger.logOperation(LogOperation::lo_Hide, this->context->v_path->value, p_str(), false, L"Failed to hide ", getCCName(this->context->v_path->value));
    }
 }
 
@@ -87,13 +87,13 @@ void C_Lock::run()
    this->perun2.contexts.success->value = s;
 
    if (s) {
-      this->perun2.logger.log(L"Lock ", getCCName(this->context->v_path->value));
+      this->perun2.logger.logOperation(LogOperation::lo_Lock, this->context->v_path->value, p_str(), true, L"Lock ", getCCName(this->context->v_path->value));
       if (saveChanges) {
          this->context->v_readonly->value = true;
       }
    }
    else {
-      this->perun2.logger.log(L"Failed to lock ", getCCName(this->context->v_path->value));
+      this->perun2.logger.logOperation(LogOperation::lo_Lock, this->context->v_path->value, p_str(), false, L"Failed to lock ", getCCName(this->context->v_path->value));
    }
 }
 
@@ -105,10 +105,10 @@ void C_Open::run()
    this->perun2.contexts.success->value = s;
 
    if (s) {
-      this->perun2.logger.log(L"Open ", getCCName(this->context->v_path->value));
+      this->perun2.logger.logOperation(LogOperation::lo_Open, this->context->v_path->value, p_str(), true, L"Open ", getCCName(this->context->v_path->value));
    }
    else {
-      this->perun2.logger.log(L"Failed to open ", getCCName(this->context->v_path->value));
+      this->perun2.logger.logOperation(LogOperation::lo_Open, this->context->v_path->value, p_str(), false, L"Failed to open ", getCCName(this->context->v_path->value));
    }
 }
 
@@ -120,13 +120,13 @@ void C_Unlock::run()
    this->perun2.contexts.success->value = s;
 
    if (s) {
-      this->perun2.logger.log(L"Unlock ", getCCName(this->context->v_path->value));
+      this->perun2.logger.logOperation(LogOperation::lo_Unlock, this->context->v_path->value, p_str(), true, L"Unlock ", getCCName(this->context->v_path->value));
       if (saveChanges) {
          this->context->v_readonly->value = false;
       }
    }
    else {
-      this->perun2.logger.log(L"Failed to unlock ", getCCName(this->context->v_path->value));
+      this->perun2.logger.logOperation(LogOperation::lo_Unlock, this->context->v_path->value, p_str(), false, L"Failed to unlock ", getCCName(this->context->v_path->value));
    }
 }
 
@@ -138,13 +138,13 @@ void C_Unhide::run()
    this->perun2.contexts.success->value = s;
 
    if (s) {
-      this->perun2.logger.log(L"Unhide ", getCCName(this->context->v_path->value));
+      this->perun2.logger.logOperation(LogOperation::lo_Unhide, this->context->v_path->value, p_str(), true, L"Unhide ", getCCName(this->context->v_path->value));
       if (saveChanges) {
          this->context->v_hidden->value = false;
       }
    }
    else {
-      this->perun2.logger.log(L"Failed to unhide ", getCCName(this->context->v_path->value));
+      this->perun2.logger.logOperation(LogOperation::lo_Unhide, this->context->v_path->value, p_str(), false, L"Failed to unhide ", getCCName(this->context->v_path->value));
    }
 }
 
@@ -155,7 +155,7 @@ void C_OpenWith::run()
    const p_str pro = os_trim(program->getValue());
 
    if (!this->context->v_exists->value || pro.empty()) {
-      this->perun2.logger.log(L"Failed to open ", getCCName(this->context->v_path->value), L" with ", getCCNameShort(pro));
+      this->perun2.logger.logOperation(LogOperation::lo_Open, this->context->v_path->value, p_str(), false, L"Failed to open ", getCCName(this->context->v_path->value), L" with ", getCCNameShort(pro));
       this->perun2.contexts.success->value = false;
       return;
    }
@@ -163,7 +163,7 @@ void C_OpenWith::run()
    const p_str proPath = os_leftJoin(this->locationContext->location->value, pro);
 
    if (proPath.empty()) {
-      this->perun2.logger.log(L"Failed to open ", getCCName(this->context->v_path->value), L" with ", getCCNameShort(pro));
+      this->perun2.logger.logOperation(LogOperation::lo_Open, this->context->v_path->value, p_str(), false, L"Failed to open ", getCCName(this->context->v_path->value), L" with ", getCCNameShort(pro));
       this->perun2.contexts.success->value = false;
       return;
    }
@@ -186,10 +186,10 @@ void C_OpenWith::run()
    this->perun2.contexts.success->value = s;
 
    if (s) {
-      this->perun2.logger.log(L"Open ", getCCName(this->context->v_path->value), L" with ", getCCName(proPath));
+      this->perun2.logger.logOperation(LogOperation::lo_Open, this->context->v_path->value, p_str(), true, L"Open ", getCCName(this->context->v_path->value), L" with ", getCCName(proPath));
    }
    else {
-      this->perun2.logger.log(L"Failed to open ", getCCName(this->context->v_path->value), L" with ", getCCName(proPath));
+      this->perun2.logger.logOperation(LogOperation::lo_Open, this->context->v_path->value, p_str(), false, L"Failed to open ", getCCName(this->context->v_path->value), L" with ", getCCName(proPath));
    }
 };
 
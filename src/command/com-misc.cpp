@@ -27,32 +27,36 @@ namespace perun2::comm
 
 void C_PrintSingle::run()
 {
-   this->perun2.logger.print(this->value->getValue());
+   this->perun2.logger.printValue(this->value->getValue());
 }
 
 void C_PrintList::run()
 {
    const p_list list = this->value->getValue();
    const p_size length = list.size();
+   this->perun2.logger.printArrayStart();
    for (p_size i = 0; this->perun2.isRunning() && i < length; i++) {
-      this->perun2.logger.print(list[i]);
+      this->perun2.logger.printArrayElement(list[i]);
    }
+   this->perun2.logger.printArrayEnd();
 }
 
 void C_PrintDefinition::run()
 {
+   this->perun2.logger.printArrayStart();
    while (this->value->hasNext()) {
       if (!this->perun2.isRunning()) {
          this->value->reset();
          break;
       }
-      this->perun2.logger.print(this->value->getValue());
+      this->perun2.logger.printArrayElement(this->value->getValue());
    }
+   this->perun2.logger.printArrayEnd();
 }
 
 void C_PrintThis::run()
 {
-   this->perun2.logger.print(this->context.this_->value);
+   this->perun2.logger.printValue(this->context.this_->value);
 }
 
 void C_SleepPeriod::run()
@@ -109,7 +113,13 @@ void C_ErrorWithExitCode::run()
 
 RunBase::RunBase(Perun2Process& p2)
    : perun2(p2),
-     locationCtx(p2.contexts.getLocationContext()) { };
+     locationCtx(p2.contexts.getLocationContext()),
+     pool(p2.runPool)
+{
+   if (this->pool != nullptr) {
+      this->pool->addCommand();
+   }
+};
 
 
 p_str RunBase::getLocation()
@@ -117,49 +127,65 @@ p_str RunBase::getLocation()
    return this->locationCtx->location->value;
 }
 
-void C_Run::run()
+void RunBase::runCommand(const p_str& command, const p_str& source,
+   const p_str& successMessage, const p_str& failureMessage)
 {
-   p_str command = os_softTrim(this->value->getValue());
+   const p_str loc = this->getLocation();
 
-   if (command.empty()) {
-      this->perun2.logger.log(L"Failed to run an empty command");
-      this->perun2.contexts.success->value = false;
+   if (this->pool != nullptr) {
+      this->pool->start(command, loc, source, successMessage, failureMessage);
       return;
    }
 
-   const p_str loc = this->getLocation();
    const p_bool s = os_run(command, loc, this->perun2);
    this->perun2.contexts.success->value = s;
 
    if (s) {
-      this->perun2.logger.log(L"Run '", command, L"'");
+      this->perun2.logger.logOperation(LogOperation::lo_Run, source, p_str(), true, successMessage);
    }
    else {
-      this->perun2.logger.log(L"Failed to run '", command, L"'");
+      this->perun2.logger.logOperation(LogOperation::lo_Run, source, p_str(), false, failureMessage);
    }
 }
 
+void RunBase::failCommand(const p_str& source, const p_str& message)
+{
+   if (this->pool != nullptr) {
+      this->pool->addFailure(source, message);
+      return;
+   }
+
+   this->perun2.logger.logOperation(LogOperation::lo_Run, source, p_str(), false, message);
+   this->perun2.contexts.success->value = false;
+}
+
+void C_Run::run()
+{
+   p_str command = os_softTrim(this->value->getValue());
+
+   if (command.empty()) {
+      this->failCommand(p_str(), L"Failed to run an empty command");
+      return;
+   }
+
+   this->runCommand(command, command,
+      str(L"Run '", command, L"'"),
+      str(L"Failed to run '", command, L"'"));
+}
+
 void C_RunWith::run()
 {
    p_str base = os_softTrim(value->getValue());
 
    if (!this->context->v_exists->value || base.empty()) {
-      this->perun2.logger.log(L"Failed to run ", getCCName(this->context->trimmed), L" with '", base, L"'");
-      this->perun2.contexts.success->value = false;
+      this->failCommand(this->context->trimmed, str(L"Failed to run ", getCCName(this->context->trimmed), L" with '", base, L"'"));
       return;
    }
 
    const p_str com = str(base, CHAR_SPACE, os_quoteEmbraced(this->context->trimmed));
-   const p_str loc = this->getLocation();
-   const p_bool s = os_run(com, loc, this->perun2);
-   this->perun2.contexts.success->value = s;
-
-   if (s) {
-      this->perun2.logger.log(L"Run ", getCCName(this->context->trimmed), L" with '", base, L"'");
-   }
-   else {
-      this->perun2.logger.log(L"Failed to run ", getCCName(this->context->trimmed), L" with '", base, L"'");
-   }
+   this->runCommand(com, this->context->trimmed,
+      str(L"Run ", getCCName(this->context->trimmed), L" with '", base, L"'"),
+      str(L"Failed to run ", getCCName(this->context->trimmed), L" with '", base, L"'"));
 }
 
 void C_RunWithWithString::run()
@@ -167,8 +193,7 @@ void C_RunWithWithString::run()
    p_str base = os_softTrim(value->getValue());
 
    if (!this->context->v_exists->value || base.empty()) {
-      this->perun2.logger.log(L"Failed to run ", getCCName(this->context->trimmed), L" with '", base, L"'");
-      this->perun2.contexts.success->value = false;
+      this->failCommand(this->context->trimmed, str(L"Failed to run ", getCCName(this->context->trimmed), L" with '", base, L"'"));
       return;
    }
 
@@ -176,16 +201,9 @@ void C_RunWithWithString::run()
    const p_str arg = os_makeArg(rawArg);
    const p_str com = str(base, CHAR_SPACE, os_quoteEmbraced(this->context->trimmed), CHAR_SPACE, arg);
 
-   const p_str loc = this->getLocation();
-   const p_bool s = os_run(com, loc, this->perun2);
-   this->perun2.contexts.success->value = s;
-
-   if (s) {
-      this->perun2.logger.log(L"Run ", getCCName(this->context->trimmed), L" with '", base, L"' with '", rawArg, L"'");
-   }
-   else {
-      this->perun2.logger.log(L"Failed to run ", getCCName(this->context->trimmed), L" with '", base, L"' with '", rawArg, L"'");
-   }
+   this->runCommand(com, this->context->trimmed,
+      str(L"Run ", getCCName(this->context->trimmed), L" with '", base, L"' with '", rawArg, L"'"),
+      str(L"Failed to run ", getCCName(this->context->trimmed), L" with '", base, L"' with '", rawArg, L"'"));
 }
 
 void C_RunWithWith::run()
@@ -193,8 +211,7 @@ void C_RunWithWith::run()
    p_str base = os_softTrim(value->getValue());
 
    if (!this->context->v_exists->value || base.empty()) {
-      this->perun2.logger.log(L"Failed to run ", getCCName(this->context->trimmed), L" with '", base, L"'");
-      this->perun2.contexts.success->value = false;
+      this->failCommand(this->context->trimmed, str(L"Failed to run ", getCCName(this->context->trimmed), L" with '", base, L"'"));
       return;
    }
 
@@ -203,16 +220,9 @@ void C_RunWithWith::run()
 
    if (len == 0) {
       const p_str com = str(base, CHAR_SPACE, os_quoteEmbraced(this->context->trimmed));
-      const p_str loc = this->getLocation();
-      const p_bool s = os_run(com, loc, this->perun2);
-      this->perun2.contexts.success->value = s;
-
-      if (s) {
-         this->perun2.logger.log(L"Run ", getCCName(this->context->trimmed), L" with '", base, L"'");
-      }
-      else {
-         this->perun2.logger.log(L"Failed to run ", getCCName(this->context->trimmed), L" with '", base, L"'");
-      }
+      this->runCommand(com, this->context->trimmed,
+         str(L"Run ", getCCName(this->context->trimmed), L" with '", base, L"'"),
+         str(L"Failed to run ", getCCName(this->context->trimmed), L" with '", base, L"'"));
    }
    else {
       p_stream comStream;
@@ -228,45 +238,29 @@ void C_RunWithWith::run()
       }
 
       const p_str com = comStream.str();
-      const p_str loc = this->getLocation();
-      const p_bool s = os_run(com, loc, this->perun2);
-      this->perun2.contexts.success->value = s;
-
-      if (s) {
-         this->perun2.logger.log(L"Run ", logStream.str());
-      }
-      else {
-         this->perun2.logger.log(L"Failed to run ", logStream.str());
-      }
+      this->runCommand(com, this->context->trimmed,
+         str(L"Run ", logStream.str()),
+         str(L"Failed to run ", logStream.str()));
    }
 }
 
 void C_RunWithPerun2::run()
 {
    if (!this->context->v_exists->value) {
-      this->perun2.logger.log(L"Failed to run ", getCCName(this->context->trimmed), L" with Perun2");
-      this->perun2.contexts.success->value = false;
+      this->failCommand(this->context->trimmed, str(L"Failed to run ", getCCName(this->context->trimmed), L" with Perun2"));
       return;
    }
 
    const p_str com = str(this->perun2.constCache.cmdProcessStartingArgs, os_quoteEmbraced(this->context->trimmed));
-   const p_str loc = this->getLocation();
-   const p_bool s = os_run(com, loc, this->perun2);
-   this->perun2.contexts.success->value = s;
-
-   if (s) {
-      this->perun2.logger.log(L"Run ", getCCName(this->context->trimmed), L" with Perun2");
-   }
-   else {
-      this->perun2.logger.log(L"Failed to run ", getCCName(this->context->trimmed), L" with Perun2");
-   }
+   this->runCommand(com, this->context->trimmed,
+      str(L"Run ", getCCName(this->context->trimmed), L" with Perun2"),
+      str(L"Failed to run ", getCCName(this->context->trimmed), L" with Perun2"));
 }
 
 void C_RunWithPerun2WithString::run()
 {
    if (!this->context->v_exists->value) {
-      this->perun2.logger.log(L"Failed to run ", getCCName(this->context->trimmed), L" with Perun2");
-      this->perun2.contexts.success->value = false;
+      this->failCommand(this->context->trimmed, str(L"Failed to run ", getCCName(this->context->trimmed), L" with Perun2"));
       return;
    }
 
@@ -274,23 +268,15 @@ void C_RunWithPerun2WithString::run()
    const p_str arg = os_makeArg(rawArg);
    const p_str com = str(this->perun2.constCache.cmdProcessStartingArgs, os_quoteEmbraced(this->context->trimmed), CHAR_SPACE, arg);
 
-   const p_str loc = this->getLocation();
-   const p_bool s = os_run(com, loc, this->perun2);
-   this->perun2.contexts.success->value = s;
-
-   if (s) {
-      this->perun2.logger.log(L"Run ", getCCName(this->context->trimmed), L" with Perun2 with '", rawArg, L"'");
-   }
-   else {
-      this->perun2.logger.log(L"Failed to run ", getCCName(this->context->trimmed), L" with Perun2 with '", rawArg, L"'");
-   }
+   this->runCommand(com, this->context->trimmed,
+      str(L"Run ", getCCName(this->context->trimmed), L" with Perun2 with '", rawArg, L"'"),
+      str(L"Failed to run ", getCCName(this->context->trimmed), L" with Perun2 with '", rawArg, L"'"));
 }
 
 void C_RunWithPerun2With::run()
 {
    if (!this->context->v_exists->value) {
-      this->perun2.logger.log(L"Failed to run ", getCCName(this->context->trimmed), L" with Perun2");
-      this->perun2.contexts.success->value = false;
+      this->failCommand(this->context->trimmed, str(L"Failed to run ", getCCName(this->context->trimmed), L" with Perun2"));
       return;
    }
 
@@ -299,16 +285,9 @@ void C_RunWithPerun2With::run()
 
    if (len == 0) {
       const p_str com = str(this->perun2.constCache.cmdProcessStartingArgs, os_quoteEmbraced(this->context->trimmed));
-      const p_str loc = this->getLocation();
-      const p_bool s = os_run(com, loc, this->perun2);
-      this->perun2.contexts.success->value = s;
-
-      if (s) {
-         this->perun2.logger.log(L"Run ", getCCName(this->context->trimmed), L" with Perun2");
-      }
-      else {
-         this->perun2.logger.log(L"Failed to run ", getCCName(this->context->trimmed), L" with Perun2");
-      }
+      this->runCommand(com, this->context->trimmed,
+         str(L"Run ", getCCName(this->context->trimmed), L" with Perun2"),
+         str(L"Failed to run ", getCCName(this->context->trimmed), L" with Perun2"));
    }
    else {
       p_stream comStream;
@@ -324,16 +303,9 @@ void C_RunWithPerun2With::run()
       }
 
       const p_str com = comStream.str();
-      const p_str loc = this->getLocation();
-      const p_bool s = os_run(com, loc, this->perun2);
-      this->perun2.contexts.success->value = s;
-
-      if (s) {
-         this->perun2.logger.log(L"Run ", logStream.str());
-      }
-      else {
-         this->perun2.logger.log(L"Failed to run ", logStream.str());
-      }
+      this->runCommand(com, this->context->trimmed,
+         str(L"Run ", logStream.str()),
+         str(L"Failed to run ", logStream.str()));
    }
 }
 
@@ -342,5 +314,11 @@ void C_Popup::run()
    os_popup(this->value->getValue());
 }
 
+void C_Profiled::run()
+{
+   const ProfileScope scope(this->profiler, this->site);
+   this->command->run();
+}
+
 
 }
@@ -21,6 +21,7 @@
 #include "com-core.h"
 #include "../attribute.h"
 #include "../perun2.h"
+#include "com-run-pool.h"
 
 
 namespace perun2::comm
@@ -179,11 +180,20 @@ public:
 
 protected:
    p_str getLocation();
+
+   // run the command and wait for it
+   // or hand it over to the pool of the loop, if the option --jobs is used
+   void runCommand(const p_str& command, const p_str& source,
+      const p_str& successMessage, const p_str& failureMessage);
+
+   // the command could not even start
+   void failCommand(const p_str& source, const p_str& message);
    
    Perun2Process& perun2;
 
 private:
    LocationContext* locationCtx;
+   RunPool* const pool;
 };
 
 
@@ -297,4 +307,21 @@ private:
    p_genptr<p_str> value;
 };
 
+
+// a command measured by the profiler
+// it exists only if the profiler is turned on
+struct C_Profiled : Command
+{
+public:
+   C_Profiled(p_comptr& com, const p_size st, Profiler& prof)
+      : command(std::move(com)), site(st), profiler(prof) { };
+
+   void run() override;
+
+private:
+   p_comptr command;
+   const p_size site;
+   Profiler& profiler;
+};
+
 }
@@ -35,26 +35,29 @@ void C_MoveTo::run()
    p_str& oldPath = this->context->v_path->value;
    const p_str n = os_trim(location->getValue());
 
+   // a directory could contain destinations of earlier transfers
+   // so it is moved only after all of them
+   if (this->pipeline != nullptr && !this->context->v_isfile->value) {
+      this->pipeline->await();
+   }
+
    if (!this->context->v_exists->value || os_isInvalid(n)
          || !os_hasParentDirectory(oldPath)) {
 
-      this->perun2.logger.log(L"Failed to move ", getCCName(oldPath));
-      this->perun2.contexts.success->value = false;
+      this->fail(oldPath);
       return;
    }
 
    const p_str newLoc = os_leftJoin(this->locationContext->location->value, n);
 
    if (newLoc.empty()) {
-      this->perun2.logger.log(L"Failed to move ", getCCName(oldPath));
-      this->perun2.contexts.success->value = false;
+      this->fail(oldPath);
       return;
    }
 
    if (!os_directoryExists(newLoc)) {
       if (!(os_hasParentDirectory(newLoc) && os_createDirectory(newLoc))) {
-         this->perun2.logger.log(L"Failed to move ", getCCName(oldPath));
-         this->perun2.contexts.success->value = false;
+         this->fail(oldPath);
          return;
       }
    }
@@ -62,31 +65,54 @@ void C_MoveTo::run()
    const p_str fulln = os_fullname(oldPath);
    const p_str newPath = str(newLoc, OS_SEPARATOR, fulln);
 
+   if (this->pipeline != nullptr) {
+      this->pipeline->awaitPath(newPath);
+   }
+
    if (os_exists(newPath)) {
       if (!(forced && !(this->context->v_isdirectory->value && os_isAncestor(oldPath, newPath)) 
             && os_drop(newPath, this->perun2))) 
       {
-         this->perun2.logger.log(L"Failed to move ", getCCName(oldPath));
-         this->perun2.contexts.success->value = false;
+         this->fail(oldPath);
          return;
       }
    }
 
+   if (this->pipeline != nullptr && this->context->v_isfile->value) {
+      this->pipeline->addTransfer(TransferType::tt_Move, oldPath, newPath, true,
+         str(L"Move ", getCCName(oldPath), L" to ", getCCName(newLoc)),
+         str(L"Failed to move ", getCCName(oldPath)));
+      this->perun2.contexts.success->value = true;
+      return;
+   }
+
    const p_bool s = os_moveTo(oldPath, newPath);
    this->perun2.contexts.success->value = s;
 
    if (s) {
-      this->perun2.logger.log(L"Move ", getCCName(oldPath), L" to ", getCCName(newLoc));
+      this->perun2.logger.logOperation(LogOperation::lo_Move, oldPath, newPath, true, L"Move ", getCCName(oldPath), L" to ", getCCName(newLoc));
 
-      if (this->saveChanges) {
+      if (this->saveChanges && this->pipeline == nullptr) {
          changeValueOfThisAfterMoving(*this->context, n, newPath);
       }
    }
    else {
-      this->perun2.logger.log(L"Failed to move ", getCCName(oldPath));
+      this->perun2.logger.logOperation(LogOperation::lo_Move, oldPath, newPath, false, L"Failed to move ", getCCName(oldPath));
    }
 }
 
+void C_MoveTo::fail(const p_str& oldPath)
+{
+   if (this->pipeline == nullptr) {
+      this->perun2.logger.logOperation(LogOperation::lo_Move, oldPath, p_str(), false, L"Failed to move ", getCCName(oldPath));
+   }
+   else {
+      this->pipeline->addFailure(LogOperation::lo_Move, oldPath, str(L"Failed to move ", getCCName(oldPath)));
+   }
+
+   this->perun2.contexts.success->value = false;
+}
+
 void C_MoveTo_Stack::run()
 {
    P_CHECK_IF_PERUN2_IS_RUNNING;
@@ -95,7 +121,7 @@ void C_MoveTo_Stack::run()
    const p_str n = os_trim(location->getValue());
 
    if (!this->context->v_exists->value || os_isInvalid(n) || !os_hasParentDirectory(oldPath)) {
-      this->perun2.logger.log(L"Failed to move ", getCCName(oldPath));
+      this->perun2.logger.logOperation(LogOperation::lo_Move, oldPath, p_str(), false, L"Failed to move ", getCCName(oldPath));
       this->perun2.contexts.success->value = false;
       return;
    }
@@ -103,14 +129,14 @@ void C_MoveTo_Stack::run()
    p_str newLoc = os_leftJoin(this->locationContext->location->value, n);
    
    if (newLoc.empty()) {
-      this->perun2.logger.log(L"Failed to move ", getCCName(oldPath));
+      this->perun2.logger.logOperation(LogOperation::lo_Move, oldPath, p_str(), false, L"Failed to move ", getCCName(oldPath));
       this->perun2.contexts.success->value = false;
       return;
    }
 
    if (!os_directoryExists(newLoc)) {
       if (!(os_hasParentDirectory(newLoc) && os_createDirectory(newLoc))) {
-         this->perun2.logger.log(L"Failed to move ", getCCName(oldPath));
+         this->perun2.logger.logOperation(LogOperation::lo_Move, oldPath, p_str(), false, L"Failed to move ", getCCName(oldPath));
          this->perun2.contexts.success->value = false;
          return;
       }
@@ -135,14 +161,14 @@ void C_MoveTo_Stack::run()
    this->perun2.contexts.success->value = s;
 
    if (s) {
-      this->perun2.logger.log(L"Move ", getCCName(oldPath), L" to ", getCCName(newLoc));
+      this->perun2.logger.logOperation(LogOperation::lo_Move, oldPath, newPath, true, L"Move ", getCCName(oldPath), L" to ", getCCName(newLoc));
 
       if (this->saveChanges) {
          changeValueOfThisAfterMoving(*this->context, n, newPath);
       }
    }
    else {
-      this->perun2.logger.log(L"Failed to move ", getCCName(oldPath));
+      this->perun2.logger.logOperation(LogOperation::lo_Move, oldPath, newPath, false, L"Failed to move ", getCCName(oldPath));
    }
 }
 
@@ -157,7 +183,7 @@ void C_MoveToAs::run()
    if (!this->context->v_exists->value || os_isInvalid(fulln)
          || os_isInvalid(loc) || !os_hasParentDirectory(oldPath)) {
 
-      this->perun2.logger.log(L"Failed to move ", getCCName(oldPath));
+      this->perun2.logger.logOperation(LogOperation::lo_Move, oldPath, p_str(), false, L"Failed to move ", getCCName(oldPath));
       this->perun2.contexts.success->value = false;
       return;
    }
@@ -171,14 +197,14 @@ void C_MoveToAs::run()
    const p_str newLoc = os_leftJoin(this->locationContext->location->value, loc);
 
    if (newLoc.empty()) {
-      this->perun2.logger.log(L"Failed to move ", getCCName(oldPath));
+      this->perun2.logger.logOperation(LogOperation::lo_Move, oldPath, p_str(), false, L"Failed to move ", getCCName(oldPath));
       this->perun2.contexts.success->value = false;
       return;
    }
 
    if (!os_directoryExists(newLoc)) {
       if (!(os_hasParentDirectory(newLoc) && os_createDirectory(newLoc))) {
-         this->perun2.logger.log(L"Failed to move ", getCCName(oldPath));
+         this->perun2.logger.logOperation(LogOperation::lo_Move, oldPath, p_str(), false, L"Failed to move ", getCCName(oldPath));
          this->perun2.contexts.success->value = false;
          return;
       }
@@ -190,7 +216,7 @@ void C_MoveToAs::run()
       if (!(forced && !(this->context->v_isdirectory->value && os_isAncestor(oldPath, newPath))
             && os_drop(newPath, this->perun2))) 
       {
-         this->perun2.logger.log(L"Failed to move ", getCCName(oldPath));
+         this->perun2.logger.logOperation(LogOperation::lo_Move, oldPath, newPath, false, L"Failed to move ", getCCName(oldPath));
          this->perun2.contexts.success->value = false;
          return;
       }
@@ -200,14 +226,14 @@ void C_MoveToAs::run()
    this->perun2.contexts.success->value = s;
 
    if (s) {
-      this->perun2.logger.log(L"Move ", getCCName(oldPath), L" to ", getCCName(newLoc), L" as '", fulln, L"'");
+      this->perun2.logger.logOperation(LogOperation::lo_Move, oldPath, newPath, true, L"Move ", getCCName(oldPath), L" to ", getCCName(newLoc), L" as '", fulln, L"'");
 
       if (this->saveChanges) {
          changeValueOfThisAfterMoving(*this->context, loc, newPath);
       }
    }
    else {
-      this->perun2.logger.log(L"Failed to move ", getCCName(oldPath));
+      this->perun2.logger.logOperation(LogOperation::lo_Move, oldPath, newPath, false, L"Failed to move ", getCCName(oldPath));
    }
 }
 
@@ -222,7 +248,7 @@ void C_MoveToAs_Stack::run()
    if (!this->context->v_exists->value || os_isInvalid(fulln)
          || os_isInvalid(loc) || !os_hasParentDirectory(oldPath)) {
 
-      this->perun2.logger.log(L"Failed to move ", getCCName(oldPath));
+      this->perun2.logger.logOperation(LogOperation::lo_Move, oldPath, p_str(), false, L"Failed to move ", getCCName(oldPath));
       this->perun2.contexts.success->value = false;
       return;
    }
@@ -231,14 +257,14 @@ void C_MoveToAs_Stack::run()
    const p_str newLoc = os_leftJoin(this->locationContext->location->value, loc);
 
    if (newLoc.empty()) {
-      this->perun2.logger.log(L"Failed to move ", getCCName(oldPath));
+      this->perun2.logger.logOperation(LogOperation::lo_Move, oldPath, p_str(), false, L"Failed to move ", getCCName(oldPath));
       this->perun2.contexts.success->value = false;
       return;
    }
 
    if (!os_directoryExists(newLoc)) {
       if (!(os_hasParentDirectory(newLoc) && os_createDirectory(newLoc))) {
-         this->perun2.logger.log(L"Failed to move ", getCCName(oldPath));
+         this->perun2.logger.logOperation(LogOperation::lo_Move, oldPath, p_str(), false, L"Failed to move ", getCCName(oldPath));
          this->perun2.contexts.success->value = false;
          return;
       }
@@ -278,14 +304,14 @@ void C_MoveToAs_Stack::run()
    this->perun2.contexts.success->value = s;
 
    if (s) {
-      this->perun2.logger.log(L"Move ", getCCName(oldPath), L" to ", getCCName(newLoc), L" as '", fulln, L"'");
+      this->perun2.logger.logOperation(LogOperation::lo_Move, oldPath, newPath, true, L"Move ", getCCName(oldPath), L" to ", getCCName(newLoc), L" as '", fulln, L"'");
 
       if (this->saveChanges) {
          changeValueOfThisAfterMoving(*this->context, loc, newPath);
       }
    }
    else {
-      this->perun2.logger.log(L"Failed to move ", getCCName(oldPath));
+      this->perun2.logger.logOperation(LogOperation::lo_Move, oldPath, newPath, false, L"Failed to move ", getCCName(oldPath));
    }
 }
 
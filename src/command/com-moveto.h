@@ -15,6 +15,7 @@
 #pragma once
 
 #include "com-core.h"
+#include "com-pipeline.h"
 
 
 namespace perun2::comm
@@ -25,13 +26,19 @@ struct C_MoveTo : CoreCommand
 {
 public:
    C_MoveTo(p_genptr<p_str>& loc, const p_bool forc, FileContext* ctx, Perun2Process& p2)
-      : location(std::move(loc)), forced(forc), CoreCommand(ctx, p2) { };
+      : location(std::move(loc)), forced(forc), pipeline(nullptr), CoreCommand(ctx, p2) { };
+   C_MoveTo(p_genptr<p_str>& loc, const p_bool forc, TransferPipeline* pip, FileContext* ctx, Perun2Process& p2)
+      : location(std::move(loc)), forced(forc), pipeline(pip), CoreCommand(ctx, p2) { };
 
    void run() override;
 
 protected:
+   void fail(const p_str& oldPath);
+
    p_genptr<p_str> location;
    const p_bool forced;
+   // if not null, files are moved in the background
+   TransferPipeline* pipeline;
 };
 
 
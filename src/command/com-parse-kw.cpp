@@ -148,6 +148,19 @@ static p_bool parseLooped(const Tokens& tks, p_comptr& innerCommand, p_fcptr& ct
    return false;
 }
 
+p_bool readsSuccess(const Tokens& tks, Perun2Process& p2)
+{
+   const p_int end = tks.getEnd();
+
+   for (p_int i = tks.getStart(); i <= end; i++) {
+      if (tks.listAt(i).isVariable(STRING_SUCCESS, p2)) {
+         return true;
+      }
+   }
+
+   return false;
+}
+
 static void makeCoreCommandContext(p_fcptr& result, Perun2Process& p2)
 {
    p_attrptr attr = std::make_unique<Attribute>(p2);
@@ -882,14 +895,23 @@ static p_bool c_moveToContextfull(p_comptr& result, const Token& word, const Tok
    p2.contexts.retreatFileContext();
 
    p_comptr inner;
+   p_plptr pipeline;
+
    if (mode == CoreCommandMode::ccm_Stack) {
       inner = std::make_unique<C_MoveTo_Stack>(dest, ctx.get(), p2);
    }
+   else if ((p2.flags & FLAG_PIPELINE) && !readsSuccess(left, p2) && !readsSuccess(right, p2)) {
+      pipeline = std::make_unique<TransferPipeline>(p2);
+      inner = std::make_unique<C_MoveTo>(dest, mode == CoreCommandMode::ccm_Force, pipeline.get(), ctx.get(), p2);
+   }
    else {
       inner = std::make_unique<C_MoveTo>(dest, mode == CoreCommandMode::ccm_Force, ctx.get(), p2);
    }
 
    if (parseLooped(left, inner, ctx, result, p2)) {
+      if (pipeline) {
+         result = std::make_unique<CS_PipelinedLoop>(result, pipeline, p2);
+      }
       return true;
    }
 
@@ -1155,14 +1177,23 @@ static p_bool c_copyToContextfull(p_comptr& result, const Token& word, const Tok
    p2.contexts.retreatFileContext();
 
    p_comptr inner;
+   p_plptr pipeline;
+
    if (mode == CoreCommandMode::ccm_Stack) {
       inner = std::make_unique<C_CopyTo_Stack>(dest, false, ctx.get(), p2);
    }
+   else if ((p2.flags & FLAG_PIPELINE) && !readsSuccess(left, p2) && !readsSuccess(right, p2)) {
+      pipeline = std::make_unique<TransferPipeline>(p2);
+      inner = std::make_unique<C_CopyTo>(dest, false, mode == CoreCommandMode::ccm_Force, pipeline.get(), ctx.get(), p2);
+   }
    else {
       inner = std::make_unique<C_CopyTo>(dest, false, mode == CoreCommandMode::ccm_Force, ctx.get(), p2);
    }
 
    if (parseLooped(left, inner, ctx, result, p2)) {
+      if (pipeline) {
+         result = std::make_unique<CS_PipelinedLoop>(result, pipeline, p2);
+      }
       return true;
    }
 
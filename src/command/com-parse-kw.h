@@ -37,6 +37,10 @@ enum CoreCommandMode
 p_bool keywordCommands(p_comptr& result, const Token& word, Tokens& tks,
    const p_int line, const CoreCommandMode mode, Perun2Process& p2);
 
+// pipelined transfers and pooled runs set 'success' only at the end of their loop
+// so a loop cannot use them, if its expressions read this variable
+p_bool readsSuccess(const Tokens& tks, Perun2Process& p2);
+
 static void checkFileContextExistence(const p_str& commandName, const p_int line, Perun2Process& p2);
 
 static p_bool kwCommandSimple(p_comptr& result, const Token& word, Tokens& tks,
@@ -14,6 +14,7 @@
 
 #include "com-parse.h"
 #include "com-misc.h"
+#include "com-run-pool.h"
 #include "../exception.h"
 #include "com-struct.h"
 #include "../datatype/parse-gen.h"
@@ -48,8 +49,10 @@ p_bool parseCommands(p_comptr& result, const Tokens& tks, Perun2Process& p2)
                   if (sublen != 0) {
                      p2.conditionContext.lockLast();
                      Tokens tks2(tks, i - sublen, sublen);
+                     const Token& first = tks2.first();
                      p_comptr com;
                      command(com, tks2, p2);
+                     profileCommand(com, first, p2);
                      commands.push_back(std::move(com));
                      sublen = 0;
                   }
@@ -73,6 +76,7 @@ p_bool parseCommands(p_comptr& result, const Tokens& tks, Perun2Process& p2)
                   p_comptr com;
 
                   if (commandStruct(com, tks, sublen, i, open, p2)) {
+                     profileCommand(com, tks.listAt(i - sublen), p2);
                      commands.push_back(std::move(com));
                   }
                   sublen = 0;
@@ -95,8 +99,10 @@ p_bool parseCommands(p_comptr& result, const Tokens& tks, Perun2Process& p2)
 
    if (sublen != 0) {
       Tokens tks2(tks, 1 + end - sublen, sublen);
+      const Token& first = tks2.first();
       p_comptr com;
       command(com, tks2, p2);
+      profileCommand(com, first, p2);
       commands.push_back(std::move(com));
    }
 
@@ -344,7 +350,21 @@ static p_bool commandStruct(p_comptr& result, const Tokens& tks, const p_int sub
    left.checkCommonExpressionExceptions(p2);
    Tokens right(tks, rightStart, rightLen);
 
+   // with the option --jobs, commands Run inside of this loop share one pool
+   RunPool* const prevPool = p2.runPool;
+   p_rpptr pool;
+
+   if (p2.arguments.getJobs() > 1 && !readsSuccess(left, p2) && !readsSuccess(right, p2)) {
+      pool = std::make_unique<RunPool>(p2);
+      p2.runPool = pool.get();
+   }
+
    bool success = parseIterationLoop(result, left, right, p2);
+   p2.runPool = prevPool;
+
+   if (success && pool && pool->hasCommands()) {
+      result = std::make_unique<CS_RunPoolLoop>(result, pool, p2);
+   }
 
    if (!success && explicitForeach) {
       throw SyntaxError(str(L"keyword '", first.getOriginString(p2), L"' is not followed by a valid value"), first.line);
@@ -613,6 +633,14 @@ static p_bool parseInsideLoop(p_comptr& result, const Token& keyword, const Toke
    throw SyntaxError(L"tokens before { bracket do not form any valid syntax structure", left.first().line);
 }
 
+static void profileCommand(p_comptr& result, const Token& first, Perun2Process& p2)
+{
+   if (result && p2.profiler.isEnabled()) {
+      const p_size site = p2.profiler.addSite(ProfileKind::pk_Command, first.line, first.getOriginString(p2));
+      result = std::make_unique<C_Profiled>(result, site, p2.profiler);
+   }
+}
+
 static p_bool parseCommandsAsMember(p_comptr& result, const Tokens& tks, p_comptr* cond, Perun2Process& p2)
 {
    p2.conditionContext.add(cond);
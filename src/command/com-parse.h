@@ -34,6 +34,7 @@ static p_bool commandStruct(p_comptr& result, const Tokens& tks, const p_int sub
    const p_int index, const p_int open, Perun2Process& p2);
 static p_bool parseIterationLoop(p_comptr& result, const Tokens& left, const Tokens& right, Perun2Process& p2);
 static p_bool parseInsideLoop(p_comptr& result, const Token& keyword, const Tokens& left, const Tokens& right, Perun2Process& p2);
+static void profileCommand(p_comptr& result, const Token& first, Perun2Process& p2);
 static p_bool parseCommandsAsMember(p_comptr& result, const Tokens& tks, p_comptr* cond, Perun2Process& p2);
 static p_bool command(p_comptr& result, Tokens& tks, Perun2Process& p2);
 static p_bool commandMisc(p_comptr& result, const Tokens& tks, Perun2Process& p2);
@@ -0,0 +1,239 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "com-pipeline.h"
+#include "../perun2.h"
+#include "../os/os.h"
+
+
+namespace perun2::comm
+{
+
+TransferPipeline::TransferPipeline(Perun2Process& p2)
+   : perun2(p2) { };
+
+TransferPipeline::~TransferPipeline() noexcept
+{
+   {
+      const std::lock_guard<std::mutex> lock(this->mutex);
+      this->stopped = true;
+   }
+
+   this->workAvailable.notify_all();
+
+   for (std::thread& w : this->workers) {
+      w.join();
+   }
+}
+
+void TransferPipeline::addTransfer(const TransferType type, const p_str& oldPath, const p_str& newPath,
+   const p_bool isFile, const p_str& successMessage, const p_str& failureMessage)
+{
+   Transfer transfer;
+   transfer.type = type;
+   transfer.operation = type == TransferType::tt_Copy ? LogOperation::lo_Copy : LogOperation::lo_Move;
+   transfer.oldPath = oldPath;
+   transfer.newPath = newPath;
+   transfer.isFile = isFile;
+   transfer.successMessage = successMessage;
+   transfer.failureMessage = failureMessage;
+   this->add(std::move(transfer));
+}
+
+void TransferPipeline::addFailure(const LogOperation operation, const p_str& oldPath, const p_str& message)
+{
+   Transfer transfer;
+   transfer.type = TransferType::tt_Failure;
+   transfer.operation = operation;
+   transfer.oldPath = oldPath;
+   transfer.isFile = false;
+   transfer.failureMessage = message;
+   transfer.done = true;
+   this->add(std::move(transfer));
+}
+
+void TransferPipeline::add(Transfer&& transfer)
+{
+   std::unique_lock<std::mutex> lock(this->mutex);
+
+   // threads are started only when needed, as many loops never run or transfer nothing
+   if (this->workers.empty()) {
+      for (p_size i = 0; i < PIPELINE_WORKERS; i++) {
+         this->workers.emplace_back(&TransferPipeline::work, this);
+      }
+   }
+
+   this->logFinished(lock);
+
+   while (this->transfers.size() >= PIPELINE_CAPACITY) {
+      this->workDone.wait(lock);
+      this->logFinished(lock);
+   }
+
+   if (transfer.type != TransferType::tt_Failure) {
+      this->pendingPaths.insert(this->pathKey(transfer.newPath));
+   }
+
+   this->transfers.push_back(std::move(transfer));
+   this->logFinished(lock);
+   lock.unlock();
+   this->workAvailable.notify_one();
+}
+
+void TransferPipeline::awaitPath(const p_str& path)
+{
+   std::unique_lock<std::mutex> lock(this->mutex);
+
+   if (this->pendingPaths.find(this->pathKey(path)) == this->pendingPaths.end()) {
+      return;
+   }
+
+   this->await(lock);
+}
+
+void TransferPipeline::await()
+{
+   std::unique_lock<std::mutex> lock(this->mutex);
+   this->await(lock);
+}
+
+p_bool TransferPipeline::finish(p_bool& lastSuccess)
+{
+   std::unique_lock<std::mutex> lock(this->mutex);
+   this->await(lock);
+
+   const p_bool result = this->anyLogged;
+   lastSuccess = this->lastSuccess;
+   this->anyLogged = false;
+   return result;
+}
+
+void TransferPipeline::await(std::unique_lock<std::mutex>& lock)
+{
+   this->logFinished(lock);
+
+   while (! this->transfers.empty()) {
+      this->workDone.wait(lock);
+      this->logFinished(lock);
+   }
+}
+
+void TransferPipeline::work()
+{
+   // operations of this thread are counted for the process that started it
+   SystemStats::active = &this->perun2.systemStats;
+
+   while (true) {
+      Transfer* transfer;
+
+      {
+         std::unique_lock<std::mutex> lock(this->mutex);
+
+         while (true) {
+            // skip failures, they have nothing to do
+            while (this->nextToStart < this->transfers.size() && this->transfers[this->nextToStart].done) {
+               this->nextToStart++;
+            }
+
+            if (this->nextToStart < this->transfers.size()) {
+               break;
+            }
+
+            if (this->stopped) {
+               return;
+            }
+
+            this->workAvailable.wait(lock);
+         }
+
+         // elements of std::deque do not move, when other elements are added or removed at its ends
+         // and this one will not be removed until it is done
+         transfer = &this->transfers[this->nextToStart];
+         this->nextToStart++;
+      }
+
+      const p_bool success = transfer->type == TransferType::tt_Copy
+         ? os_copyTo(transfer->oldPath, transfer->newPath, transfer->isFile, this->perun2)
+         : os_moveTo(transfer->oldPath, transfer->newPath);
+
+      {
+         const std::lock_guard<std::mutex> lock(this->mutex);
+         transfer->success = success;
+         transfer->done = true;
+      }
+
+      this->workDone.notify_all();
+   }
+}
+
+void TransferPipeline::logFinished(std::unique_lock<std::mutex>& lock)
+{
+   while (! this->transfers.empty() && this->transfers.front().done) {
+      const Transfer& transfer = this->transfers.front();
+
+      if (transfer.success) {
+         this->perun2.logger.logOperation(transfer.operation, transfer.oldPath,
+            transfer.newPath, true, transfer.successMessage);
+      }
+      else {
+         this->perun2.logger.logOperation(transfer.operation, transfer.oldPath,
+            transfer.newPath, false, transfer.failureMessage);
+      }
+
+      this->anyLogged = true;
+      this->lastSuccess = transfer.success;
+
+      if (transfer.type != TransferType::tt_Failure) {
+         this->pendingPaths.erase(this->pathKey(transfer.newPath));
+      }
+
+      this->transfers.pop_front();
+
+      if (this->nextToStart > 0) {
+         this->nextToStart--;
+      }
+   }
+}
+
+p_str TransferPipeline::pathKey(const p_str& path) const
+{
+   p_str result = path;
+   str_toLower(result);
+   return result;
+}
+
+
+CS_PipelinedLoop::CS_PipelinedLoop(p_comptr& lp, p_plptr& pip, Perun2Process& p2)
+   : loop(std::move(lp)), pipeline(std::move(pip)), perun2(p2) { };
+
+void CS_PipelinedLoop::run()
+{
+   p_bool lastSuccess;
+
+   try {
+      this->loop->run();
+   }
+   catch (...) {
+      // transfers already handed over are finished and logged before the error goes further
+      this->pipeline->finish(lastSuccess);
+      throw;
+   }
+
+   // commands of the loop have set 'success' before their transfers were done
+   if (this->pipeline->finish(lastSuccess)) {
+      this->perun2.contexts.success->value = lastSuccess;
+   }
+}
+
+}
@@ -0,0 +1,136 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "com.h"
+#include "../datatype/datatype.h"
+#include "../logger.h"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+
+namespace perun2
+{
+   struct Perun2Process;
+}
+
+namespace perun2::comm
+{
+
+// number of threads that copy and move files in the background
+p_constexpr p_size PIPELINE_WORKERS = 4;
+
+// iteration waits, if this many transfers are not finished and logged yet
+p_constexpr p_size PIPELINE_CAPACITY = 64;
+
+
+enum TransferType
+{
+   tt_Copy = 0,
+   tt_Move,
+   // nothing to do, the command failed before the transfer
+   tt_Failure
+};
+
+
+struct Transfer
+{
+   TransferType type;
+   LogOperation operation;
+   p_str oldPath;
+   p_str newPath;
+   p_bool isFile;
+   p_str successMessage;
+   p_str failureMessage;
+
+   p_bool done = false;
+   p_bool success = false;
+};
+
+
+// core commands Copy and Move called in a loop: copy '**/*.jpg' to 'backup'
+// usually, every element is transferred before the next one is even found
+// with the flag -a, they only prepare the transfer and hand it over to this pipeline
+// worker threads perform transfers in the background, while iteration goes on
+// logs are printed in the original order of elements
+// at the end of the loop, we wait for all transfers and 'success' tells about the last element, as usual
+// loops, whose expressions read 'success' during iteration, are never pipelined
+struct TransferPipeline
+{
+public:
+   TransferPipeline() = delete;
+   TransferPipeline(Perun2Process& p2);
+   TransferPipeline(TransferPipeline const&) = delete;
+   TransferPipeline& operator= (TransferPipeline const&) = delete;
+   ~TransferPipeline() noexcept;
+
+   void addTransfer(const TransferType type, const p_str& oldPath, const p_str& newPath,
+      const p_bool isFile, const p_str& successMessage, const p_str& failureMessage);
+   void addFailure(const LogOperation operation, const p_str& oldPath, const p_str& message);
+
+   // a transfer to this path has not finished yet
+   // so wait for all of them, as the command has to know if the path exists
+   void awaitPath(const p_str& path);
+
+   // wait for all transfers and print their logs
+   void await();
+
+   // the same, but at the end of the loop
+   // return false, if nothing has been transferred since the previous call
+   // otherwise, the result of the last transfer is written to the argument
+   p_bool finish(p_bool& lastSuccess);
+
+private:
+   void add(Transfer&& transfer);
+   void await(std::unique_lock<std::mutex>& lock);
+   void work();
+   void logFinished(std::unique_lock<std::mutex>& lock);
+   p_str pathKey(const p_str& path) const;
+
+   Perun2Process& perun2;
+   std::mutex mutex;
+   std::condition_variable workAvailable;
+   std::condition_variable workDone;
+   std::deque<Transfer> transfers;
+   p_size nextToStart = 0;
+   std::unordered_set<p_str> pendingPaths;
+   std::vector<std::thread> workers;
+   p_bool anyLogged = false;
+   p_bool lastSuccess = false;
+   p_bool stopped = false;
+};
+
+
+typedef std::unique_ptr<TransferPipeline> p_plptr;
+
+
+// loop of core commands followed by a barrier of the pipeline
+struct CS_PipelinedLoop : Command
+{
+public:
+   CS_PipelinedLoop(p_comptr& lp, p_plptr& pip, Perun2Process& p2);
+   void run() override;
+
+private:
+   p_comptr loop;
+   p_plptr pipeline;
+   Perun2Process& perun2;
+};
+
+}
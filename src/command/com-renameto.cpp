@@ -47,7 +47,7 @@ void C_RenameTo::run()
    if (!this->context->v_exists->value || os_isInvalid(n)
          || !os_hasParentDirectory(this->context->v_path->value) || os_isAbsolute(n)) {
 
-      this->perun2.logger.log(L"Failed to rename ", getCCName(this->context->v_path->value));
+      this->perun2.logger.logOperation(LogOperation::lo_Rename, this->context->v_path->value, p_str(), false, L"Failed to rename ", getCCName(this->context->v_path->value));
       this->perun2.contexts.success->value = false;
       return;
    }
@@ -63,7 +63,7 @@ void C_RenameTo::run()
 
    if (os_exists(newPath)) {
       if (!(forced && os_drop(newPath, this->perun2))) {
-         this->perun2.logger.log(L"Failed to rename ", getCCName(this->context->v_path->value));
+         this->perun2.logger.logOperation(LogOperation::lo_Rename, this->context->v_path->value, newPath, false, L"Failed to rename ", getCCName(this->context->v_path->value));
          this->perun2.contexts.success->value = false;
          return;
       }
@@ -73,7 +73,7 @@ void C_RenameTo::run()
    this->perun2.contexts.success->value = s;
 
    if (s) {
-      this->perun2.logger.log(L"Rename ", getCCName(this->context->v_path->value), L" to '", n, L"'");
+      this->perun2.logger.logOperation(LogOperation::lo_Rename, this->context->v_path->value, newPath, true, L"Rename ", getCCName(this->context->v_path->value), L" to '", n, L"'");
 
       if (saveChanges) {
          this->context->v_fullname->value = n;
@@ -83,7 +83,7 @@ void C_RenameTo::run()
       }
    }
    else {
-      this->perun2.logger.log(L"Failed to rename ", getCCName(this->context->v_path->value));
+      this->perun2.logger.logOperation(LogOperation::lo_Rename, this->context->v_path->value, newPath, false, L"Failed to rename ", getCCName(this->context->v_path->value));
    }
 }
 
@@ -96,7 +96,7 @@ void C_RenameTo_Stack::run()
    if (!this->context->v_exists->value || os_isInvalid(n)
          || !os_hasParentDirectory(oldPath) || os_isAbsolute(n)) {
 
-      this->perun2.logger.log(L"Failed to rename ", getCCName(oldPath));
+      this->perun2.logger.logOperation(LogOperation::lo_Rename, oldPath, p_str(), false, L"Failed to rename ", getCCName(oldPath));
       this->perun2.contexts.success->value = false;
       return;
    }
@@ -142,7 +142,7 @@ void C_RenameTo_Stack::run()
    this->perun2.contexts.success->value = s;
 
    if (s) {
-      this->perun2.logger.log(L"Rename ", getCCName(this->context->v_path->value), L" to '", n, L"'");
+      this->perun2.logger.logOperation(LogOperation::lo_Rename, this->context->v_path->value, newPath, true, L"Rename ", getCCName(this->context->v_path->value), L" to '", n, L"'");
 
       if (saveChanges) {
          this->context->v_fullname->value = n;
@@ -152,7 +152,7 @@ void C_RenameTo_Stack::run()
       }
    }
    else {
-      this->perun2.logger.log(L"Failed to rename ", getCCName(this->context->v_path->value));
+      this->perun2.logger.logOperation(LogOperation::lo_Rename, this->context->v_path->value, newPath, false, L"Failed to rename ", getCCName(this->context->v_path->value));
    }
 }
 
@@ -0,0 +1,159 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "com-run-pool.h"
+#include "../perun2.h"
+#include "../os/os.h"
+#include <algorithm>
+
+
+namespace perun2::comm
+{
+
+RunPool::RunPool(Perun2Process& p2)
+   : perun2(p2), limit(std::min(p2.arguments.getJobs(), RUN_POOL_MAX_JOBS)) { };
+
+RunPool::~RunPool() noexcept
+{
+   // children are not left behind, even if the process is destroyed in the middle of a loop
+   for (RunJob& job : this->jobs) {
+      if (! job.done) {
+         os_endProcess(job.process, this->perun2);
+      }
+   }
+}
+
+void RunPool::addCommand()
+{
+   this->anyCommand = true;
+}
+
+p_bool RunPool::hasCommands() const
+{
+   return this->anyCommand;
+}
+
+void RunPool::start(const p_str& command, const p_str& location, const p_str& source,
+   const p_str& successMessage, const p_str& failureMessage)
+{
+   while (this->running >= this->limit || this->jobs.size() >= RUN_POOL_CAPACITY) {
+      this->awaitAny();
+      this->logFinished();
+   }
+
+   RunJob job;
+   job.source = source;
+   job.successMessage = successMessage;
+   job.failureMessage = failureMessage;
+
+   if (os_startProcess(command, location, job.process, this->perun2)) {
+      this->running++;
+   }
+   else {
+      job.done = true;
+   }
+
+   this->jobs.push_back(std::move(job));
+   this->logFinished();
+}
+
+void RunPool::addFailure(const p_str& source, const p_str& message)
+{
+   RunJob job;
+   job.source = source;
+   job.failureMessage = message;
+   job.done = true;
+   this->jobs.push_back(std::move(job));
+   this->logFinished();
+}
+
+p_bool RunPool::finish(p_bool& lastSuccess)
+{
+   while (this->running > 0) {
+      this->awaitAny();
+   }
+
+   this->logFinished();
+
+   const p_bool result = this->anyLogged;
+   lastSuccess = this->lastSuccess;
+   this->anyLogged = false;
+   return result;
+}
+
+void RunPool::awaitAny()
+{
+   this->waited.clear();
+   this->waitedIndices.clear();
+
+   for (p_size i = 0; i < this->jobs.size(); i++) {
+      if (! this->jobs[i].done) {
+         this->waited.push_back(this->jobs[i].process);
+         this->waitedIndices.push_back(i);
+      }
+   }
+
+   if (this->waited.empty()) {
+      return;
+   }
+
+   RunJob& job = this->jobs[this->waitedIndices[os_awaitAnyProcess(this->waited)]];
+   job.success = os_endProcess(job.process, this->perun2);
+   job.done = true;
+   this->running--;
+}
+
+void RunPool::logFinished()
+{
+   while (! this->jobs.empty() && this->jobs.front().done) {
+      const RunJob& job = this->jobs.front();
+
+      if (job.success) {
+         this->perun2.logger.logOperation(LogOperation::lo_Run, job.source, p_str(), true, job.successMessage);
+      }
+      else {
+         this->perun2.logger.logOperation(LogOperation::lo_Run, job.source, p_str(), false, job.failureMessage);
+      }
+
+      this->anyLogged = true;
+      this->lastSuccess = job.success;
+
+      this->jobs.pop_front();
+   }
+}
+
+
+CS_RunPoolLoop::CS_RunPoolLoop(p_comptr& lp, p_rpptr& pl, Perun2Process& p2)
+   : loop(std::move(lp)), pool(std::move(pl)), perun2(p2) { };
+
+void CS_RunPoolLoop::run()
+{
+   p_bool lastSuccess;
+
+   try {
+      this->loop->run();
+   }
+   catch (...) {
+      // the same syntax tree may run again, so nothing is left for the next run
+      this->pool->finish(lastSuccess);
+      throw;
+   }
+
+   // commands of the loop did not wait for their processes
+   if (this->pool->finish(lastSuccess)) {
+      this->perun2.contexts.success->value = lastSuccess;
+   }
+}
+
+}
@@ -0,0 +1,115 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "com.h"
+#include "../datatype/datatype.h"
+#include "../side-process.h"
+#include <deque>
+#include <memory>
+#include <vector>
+
+
+namespace perun2
+{
+   struct Perun2Process;
+}
+
+namespace perun2::comm
+{
+
+// a process can wait for at most this many others at once
+p_constexpr p_size RUN_POOL_MAX_JOBS = MAXIMUM_WAIT_OBJECTS;
+
+// iteration waits, if this many runs are not finished and logged yet
+p_constexpr p_size RUN_POOL_CAPACITY = 256;
+
+
+struct RunJob
+{
+   p_process process;
+   p_str source;
+   p_str successMessage;
+   p_str failureMessage;
+
+   p_bool done = false;
+   p_bool success = false;
+};
+
+
+// commands Run called in a loop: images { run 'convert ...' }
+// usually, every process is awaited before the next iteration
+// with the option --jobs=<n>, up to n of them run at once
+// logs are printed in the original order of runs
+// at the end of the loop, we wait for all processes and 'success' gets the result of the last run
+// everything happens on the thread of the script, the operating system waits for processes
+struct RunPool
+{
+public:
+   RunPool() = delete;
+   RunPool(Perun2Process& p2);
+   RunPool(RunPool const&) = delete;
+   RunPool& operator= (RunPool const&) = delete;
+   ~RunPool() noexcept;
+
+   // called while parsing, so the loop knows if it needs a barrier
+   void addCommand();
+   p_bool hasCommands() const;
+
+   void start(const p_str& command, const p_str& location, const p_str& source,
+      const p_str& successMessage, const p_str& failureMessage);
+   // nothing to start, the command failed before
+   // earlier runs may still be in progress, so this log has to wait for them
+   void addFailure(const p_str& source, const p_str& message);
+
+   // wait for all processes and print their logs
+   // return false, if nothing has been run since the previous call
+   // otherwise, the result of the last run is written to the argument
+   p_bool finish(p_bool& lastSuccess);
+
+private:
+   void awaitAny();
+   void logFinished();
+
+   Perun2Process& perun2;
+   const p_size limit;
+   std::deque<RunJob> jobs;
+   p_size running = 0;
+   // reused for every wait
+   std::vector<p_process> waited;
+   std::vector<p_size> waitedIndices;
+   p_bool anyCommand = false;
+   p_bool anyLogged = false;
+   p_bool lastSuccess = false;
+};
+
+
+typedef std::unique_ptr<RunPool> p_rpptr;
+
+
+// iteration loop followed by a barrier of the pool
+struct CS_RunPoolLoop : Command
+{
+public:
+   CS_RunPoolLoop(p_comptr& lp, p_rpptr& pl, Perun2Process& p2);
+   void run() override;
+
+private:
+   p_comptr loop;
+   p_rpptr pool;
+   Perun2Process& perun2;
+};
+
+}
@@ -30,7 +30,7 @@ void C_ReaccessTo::run()
    t.setValue(time->getValue());
 
    if (t.type == Time::tt_Never) {
-      this->perun2.logger.log(L"Failed to reaccess ", getCCName(this->context->v_path->value));
+      this->perun2.logger.logOperation(LogOperation::lo_Reaccess, this->context->v_path->value, p_str(), false, L"Failed to reaccess ", getCCName(this->context->v_path->value));
       this->perun2.contexts.success->value = false;
       return;
    }
@@ -39,14 +39,14 @@ void C_ReaccessTo::run()
       && os_setTime(this->context->v_path->value, this->context->v_creation->value, t, this->context->v_modification->value);
 
    if (this->perun2.contexts.success->value) {
-      this->perun2.logger.log(L"Reaccess ", getCCName(this->context->v_path->value), L" to ", t.toString());
+      this->perun2.logger.logOperation(LogOperation::lo_Reaccess, this->context->v_path->value, p_str(), true, L"Reaccess ", getCCName(this->context->v_path->value), L" to ", t.toString());
 
       if (saveChanges) {
          this->context->v_access->value = t;
       }
    }
    else {
-      this->perun2.logger.log(L"Failed to reaccess ", getCCName(this->context->v_path->value));
+      this->perun2.logger.logOperation(LogOperation::lo_Reaccess, this->context->v_path->value, p_str(), false, L"Failed to reaccess ", getCCName(this->context->v_path->value));
    }
 }
 
@@ -58,7 +58,7 @@ void C_RechangeTo::run()
    t.setValue(time->getValue());
    
    if (t.type == Time::tt_Never) {
-      this->perun2.logger.log(L"Failed to rechange ", getCCName(this->context->v_path->value));
+      this->perun2.logger.logOperation(LogOperation::lo_Rechange, this->context->v_path->value, p_str(), false, L"Failed to rechange ", getCCName(this->context->v_path->value));
       this->perun2.contexts.success->value = false;
       return;
    }
@@ -67,7 +67,7 @@ void C_RechangeTo::run()
       && os_setTime(this->context->v_path->value, this->context->v_creation->value, this->context->v_access->value, t);
 
    if (this->perun2.contexts.success->value) {
-      this->perun2.logger.log(L"Rechange ", getCCName(this->context->v_path->value), L" to ", t.toString());
+      this->perun2.logger.logOperation(LogOperation::lo_Rechange, this->context->v_path->value, p_str(), true, L"Rechange ", getCCName(this->context->v_path->value), L" to ", t.toString());
 
       if (saveChanges) {
          this->context->v_change->value = t;
@@ -75,7 +75,7 @@ void C_RechangeTo::run()
       }
    }
    else {
-      this->perun2.logger.log(L"Failed to rechange ", getCCName(this->context->v_path->value));
+      this->perun2.logger.logOperation(LogOperation::lo_Rechange, this->context->v_path->value, p_str(), false, L"Failed to rechange ", getCCName(this->context->v_path->value));
    }
 }
 
@@ -87,7 +87,7 @@ void C_RecreateTo::run()
    t.setValue(time->getValue());
 
    if (t.type == Time::tt_Never) {
-      this->perun2.logger.log(L"Failed to recreate ", getCCName(this->context->v_path->value));
+      this->perun2.logger.logOperation(LogOperation::lo_Recreate, this->context->v_path->value, p_str(), false, L"Failed to recreate ", getCCName(this->context->v_path->value));
       this->perun2.contexts.success->value = false;
       return;
    }
@@ -96,14 +96,14 @@ void C_RecreateTo::run()
       && os_setTime(this->context->v_path->value, t, this->context->v_access->value, this->context->v_modification->value);
 
    if (this->perun2.contexts.success->value) {
-      this->perun2.logger.log(L"Recreate ", getCCName(this->context->v_path->value),  L" to ", t.toString());
+      this->perun2.logger.logOperation(LogOperation::lo_Recreate, this->context->v_path->value, p_str(), true, L"Recreate ", getCCName(this->context->v_path->value),  L" to ", t.toString());
 
       if (saveChanges) {
          this->context->v_creation->value = t;
       }
    }
    else {
-      this->perun2.logger.log(L"Failed to recreate ", getCCName(this->context->v_path->value));
+      this->perun2.logger.logOperation(LogOperation::lo_Recreate, this->context->v_path->value, p_str(), false, L"Failed to recreate ", getCCName(this->context->v_path->value));
    }
 }
 
@@ -115,7 +115,7 @@ void C_RemodifyTo::run()
    t.setValue(time->getValue());
 
    if (t.type == Time::tt_Never) {
-      this->perun2.logger.log(L"Failed to remodify ", getCCName(this->context->v_path->value));
+      this->perun2.logger.logOperation(LogOperation::lo_Remodify, this->context->v_path->value, p_str(), false, L"Failed to remodify ", getCCName(this->context->v_path->value));
       this->perun2.contexts.success->value = false;
       return;
    }
@@ -124,7 +124,7 @@ void C_RemodifyTo::run()
       && os_setTime(this->context->v_path->value, this->context->v_creation->value, this->context->v_access->value, t);
 
    if (this->perun2.contexts.success->value) {
-      this->perun2.logger.log(L"Remodify ", getCCName(this->context->v_path->value), L" to ", t.toString());
+      this->perun2.logger.logOperation(LogOperation::lo_Remodify, this->context->v_path->value, p_str(), true, L"Remodify ", getCCName(this->context->v_path->value), L" to ", t.toString());
 
       if (saveChanges) {
          this->context->v_modification->value = t;
@@ -132,7 +132,7 @@ void C_RemodifyTo::run()
       }
    }
    else {
-      this->perun2.logger.log(L"Failed to remodify ", getCCName(this->context->v_path->value));
+      this->perun2.logger.logOperation(LogOperation::lo_Remodify, this->context->v_path->value, p_str(), false, L"Failed to remodify ", getCCName(this->context->v_path->value));
    }
 }
 
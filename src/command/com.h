@@ -14,13 +14,14 @@
 
 #pragma once
 
+#include "../arena.h"
 #include <memory>
 
 
 namespace perun2
 {
 
-struct Command
+struct Command : ArenaAllocated
 {
 public:
    virtual void run() = 0;
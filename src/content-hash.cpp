@@ -0,0 +1,346 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "content-hash.h"
+#include "datatype/text/chars.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define P_CRC32C_HARDWARE
+#include <nmmintrin.h>
+#endif
+
+
+namespace perun2
+{
+
+p_constexpr uint64_t XXH_PRIME_1 = 11400714785074694791ULL;
+p_constexpr uint64_t XXH_PRIME_2 = 14029467366897019727ULL;
+p_constexpr uint64_t XXH_PRIME_3 = 1609587929392839161ULL;
+p_constexpr uint64_t XXH_PRIME_4 = 9650029242287828579ULL;
+p_constexpr uint64_t XXH_PRIME_5 = 2870177450012600261ULL;
+
+// reversed polynomial of CRC-32C
+p_constexpr uint32_t CRC32C_POLYNOMIAL = 0x82F63B78;
+
+
+static inline uint64_t rotateLeft(const uint64_t value, const int bits)
+{
+   return (value << bits) | (value >> (64 - bits));
+}
+
+static inline uint64_t read64(const char* data)
+{
+   uint64_t result;
+   std::memcpy(&result, data, sizeof(result));
+   return result;
+}
+
+static inline uint32_t read32(const char* data)
+{
+   uint32_t result;
+   std::memcpy(&result, data, sizeof(result));
+   return result;
+}
+
+static inline uint64_t xxRound(uint64_t acc, const uint64_t input)
+{
+   acc += input * XXH_PRIME_2;
+   acc = rotateLeft(acc, 31);
+   return acc * XXH_PRIME_1;
+}
+
+static inline uint64_t xxMergeRound(uint64_t acc, const uint64_t value)
+{
+   acc ^= xxRound(0, value);
+   return acc * XXH_PRIME_1 + XXH_PRIME_4;
+}
+
+uint64_t xxHash64(const char* data, const p_size size)
+{
+   const char* position = data;
+   const char* const end = data + size;
+   uint64_t result;
+
+   if (size >= 32) {
+      // four independent lanes, so the processor can compute them at the same time
+      uint64_t v1 = XXH_PRIME_1 + XXH_PRIME_2;
+      uint64_t v2 = XXH_PRIME_2;
+      uint64_t v3 = 0;
+      uint64_t v4 = 0 - XXH_PRIME_1;
+      const char* const limit = end - 32;
+
+      do {
+         v1 = xxRound(v1, read64(position));
+         v2 = xxRound(v2, read64(position + 8));
+         v3 = xxRound(v3, read64(position + 16));
+         v4 = xxRound(v4, read64(position + 24));
+         position += 32;
+      }
+      while (position <= limit);
+
+      result = rotateLeft(v1, 1) + rotateLeft(v2, 7) + rotateLeft(v3, 12) + rotateLeft(v4, 18);
+      result = xxMergeRound(result, v1);
+      result = xxMergeRound(result, v2);
+      result = xxMergeRound(result, v3);
+      result = xxMergeRound(result, v4);
+   }
+   else {
+      result = XXH_PRIME_5;
+   }
+
+   result += static_cast<uint64_t>(size);
+
+   while (position + 8 <= end) {
+      result ^= xxRound(0, read64(position));
+      result = rotateLeft(result, 27) * XXH_PRIME_1 + XXH_PRIME_4;
+      position += 8;
+   }
+
+   if (position + 4 <= end) {
+      result ^= static_cast<uint64_t>(read32(position)) * XXH_PRIME_1;
+      result = rotateLeft(result, 23) * XXH_PRIME_2 + XXH_PRIME_3;
+      position += 4;
+   }
+
+   while (position < end) {
+      result ^= static_cast<uint64_t>(static_cast<unsigned char>(*position)) * XXH_PRIME_5;
+      result = rotateLeft(result, 11) * XXH_PRIME_1;
+      position++;
+   }
+
+   result ^= result >> 33;
+   result *= XXH_PRIME_2;
+   result ^= result >> 29;
+   result *= XXH_PRIME_3;
+   result ^= result >> 32;
+   return result;
+}
+
+
+struct Crc32cTable
+{
+   uint32_t values[256];
+
+   constexpr Crc32cTable() : values()
+   {
+      for (uint32_t i = 0; i < 256; i++) {
+         uint32_t crc = i;
+         for (int j = 0; j < 8; j++) {
+            crc = (crc & 1) ? (crc >> 1) ^ CRC32C_POLYNOMIAL : crc >> 1;
+         }
+         this->values[i] = crc;
+      }
+   }
+};
+
+p_constexpr Crc32cTable CRC32C_TABLE;
+
+static uint32_t crc32cSoftware(const char* data, const p_size size, uint32_t crc)
+{
+   for (p_size i = 0; i < size; i++) {
+      crc = CRC32C_TABLE.values[(crc ^ static_cast<unsigned char>(data[i])) & 0xFF] ^ (crc >> 8);
+   }
+
+   return crc;
+}
+
+#ifdef P_CRC32C_HARDWARE
+
+__attribute__((target("sse4.2")))
+static uint32_t crc32cHardware(const char* data, const p_size size, const uint32_t crc)
+{
+   uint64_t result = crc;
+   p_size i = 0;
+
+   for (; i + 8 <= size; i += 8) {
+      result = _mm_crc32_u64(result, read64(data + i));
+   }
+
+   uint32_t rest = static_cast<uint32_t>(result);
+
+   for (; i < size; i++) {
+      rest = _mm_crc32_u8(rest, static_cast<unsigned char>(data[i]));
+   }
+
+   return rest;
+}
+
+static const p_bool CRC32C_HAS_HARDWARE = __builtin_cpu_supports("sse4.2");
+
+#endif
+
+uint32_t crc32c(const char* data, const p_size size, const uint32_t previous)
+{
+   const uint32_t crc = ~previous;
+
+#ifdef P_CRC32C_HARDWARE
+   if (CRC32C_HAS_HARDWARE) {
+      return ~crc32cHardware(data, size, crc);
+   }
+#endif
+
+   return ~crc32cSoftware(data, size, crc);
+}
+
+// multiplication of two polynomials modulo the CRC polynomial
+static uint32_t multiplyModulo(uint32_t a, uint32_t b)
+{
+   uint32_t mask = 1u << 31;
+   uint32_t result = 0;
+
+   while (true) {
+      if (a & mask) {
+         result ^= b;
+         if ((a & (mask - 1)) == 0) {
+            break;
+         }
+      }
+
+      mask >>= 1;
+      b = (b & 1) ? (b >> 1) ^ CRC32C_POLYNOMIAL : b >> 1;
+   }
+
+   return result;
+}
+
+// x raised to the power of 8 * bytes, modulo the CRC polynomial
+static uint32_t shiftModulo(p_size bytes)
+{
+   // powers x^(2^n)
+   static const std::vector<uint32_t> powers = [] {
+      std::vector<uint32_t> result(32);
+      uint32_t power = 1u << 30;
+      result[0] = power;
+
+      for (p_size i = 1; i < 32; i++) {
+         power = multiplyModulo(power, power);
+         result[i] = power;
+      }
+
+      return result;
+   }();
+
+   uint32_t result = 1u << 31;
+   p_size index = 3;
+
+   while (bytes != 0) {
+      if (bytes & 1) {
+         result = multiplyModulo(powers[index & 31], result);
+      }
+
+      bytes >>= 1;
+      index++;
+   }
+
+   return result;
+}
+
+uint32_t crc32cCombine(const uint32_t first, const uint32_t second, const p_size secondLength)
+{
+   return multiplyModulo(shiftModulo(secondLength), first) ^ second;
+}
+
+p_str hashToString(const uint64_t hash)
+{
+   static const p_char digits[] = L"0123456789abcdef";
+   p_str result(16, CHAR_0);
+
+   for (p_size i = 0; i < 16; i++) {
+      result[15 - i] = digits[(hash >> (i * 4)) & 0xF];
+   }
+
+   return result;
+}
+
+// CRC of a big file is computed in parts by several threads and then the parts are combined
+static uint32_t parallelCrc32c(const char* data, const p_size size)
+{
+   const p_size chunks = (size + HASH_CHUNK_SIZE - 1) / HASH_CHUNK_SIZE;
+   std::vector<uint32_t> parts(chunks);
+   std::atomic<p_size> next(0);
+
+   auto work = [&]() {
+      while (true) {
+         const p_size index = next.fetch_add(1, std::memory_order_relaxed);
+         if (index >= chunks) {
+            return;
+         }
+
+         const p_size start = index * HASH_CHUNK_SIZE;
+         parts[index] = crc32c(data + start, std::min(HASH_CHUNK_SIZE, size - start), 0);
+      }
+   };
+
+   const p_size count = std::min<p_size>({ HASH_MAX_WORKERS, chunks,
+      std::max<p_size>(std::thread::hardware_concurrency(), 1) });
+
+   std::vector<std::thread> workers;
+   workers.reserve(count);
+
+   for (p_size i = 0; i < count; i++) {
+      workers.emplace_back(work);
+   }
+
+   for (std::thread& w : workers) {
+      w.join();
+   }
+
+   uint32_t result = parts[0];
+
+   for (p_size i = 1; i < chunks; i++) {
+      const p_size start = i * HASH_CHUNK_SIZE;
+      result = crc32cCombine(result, parts[i], std::min(HASH_CHUNK_SIZE, size - start));
+   }
+
+   return result;
+}
+
+void computeContentHash(const char* data, const p_size size,
+   const p_bool hash, const p_bool crc32, ContentHash& result)
+{
+   const p_bool needsHash = hash && !result.hasHash;
+   const p_bool needsCrc32 = crc32 && !result.hasCrc32;
+
+   if (needsCrc32 && size >= HASH_PARALLEL_SIZE) {
+      // xxHash cannot be divided into parts
+      // so this thread computes it, while other threads compute the CRC
+      std::thread crcThread([&result, data, size]() {
+         result.crc32 = parallelCrc32c(data, size);
+      });
+
+      if (needsHash) {
+         result.hash = xxHash64(data, size);
+      }
+
+      crcThread.join();
+   }
+   else {
+      if (needsHash) {
+         result.hash = xxHash64(data, size);
+      }
+      if (needsCrc32) {
+         result.crc32 = crc32c(data, size, 0);
+      }
+   }
+
+   result.hasHash |= needsHash;
+   result.hasCrc32 |= needsCrc32;
+}
+
+}
@@ -0,0 +1,65 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "datatype/primitives.h"
+#include "file-cache.h"
+
+
+namespace perun2
+{
+
+// files of this size or bigger are hashed by several threads
+p_constexpr p_size HASH_PARALLEL_SIZE = 64 * 1024 * 1024;
+// every thread takes a part of this size
+p_constexpr p_size HASH_CHUNK_SIZE = 8 * 1024 * 1024;
+p_constexpr p_size HASH_MAX_WORKERS = 8;
+// partial hash covers this many bytes at the beginning and at the end of a file
+p_constexpr p_size HASH_PART_SIZE = 4096;
+
+
+// 64-bit xxHash of the data
+uint64_t xxHash64(const char* data, const p_size size);
+
+// CRC-32C (Castagnoli) of the data, continued from a previous value
+// x86-64 processors with SSE 4.2 compute it with a dedicated instruction
+uint32_t crc32c(const char* data, const p_size size, const uint32_t previous);
+
+// CRC-32C of two joined parts, where the length of the second one is known
+uint32_t crc32cCombine(const uint32_t first, const uint32_t second, const p_size secondLength);
+
+// hash in its textual form: 16 hexadecimal digits
+p_str hashToString(const uint64_t hash);
+
+
+// content hashes of a file
+// only the requested ones are computed
+struct ContentHash
+{
+   p_bool hasHash = false;
+   p_bool hasCrc32 = false;
+   uint64_t hash = 0;
+   uint32_t crc32 = 0;
+};
+
+// compute the missing hashes of the data in one pass
+void computeContentHash(const char* data, const p_size size,
+   const p_bool hash, const p_bool crc32, ContentHash& result);
+
+
+// hashes of files already read during this process
+typedef FileCache<ContentHash> HashCache;
+
+}
@@ -22,7 +22,7 @@ namespace perun2
 {
    struct Perun2Process;
 
-   struct AggregateContext
+   struct AggregateContext : ArenaAllocated
    {
       AggregateContext() = delete;
       AggregateContext(Perun2Process& p2);
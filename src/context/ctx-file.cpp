@@ -66,6 +66,8 @@ namespace perun2
       this->v_parent = this->insertVar<p_str>(STRING_PARENT);
       this->v_path = this->insertVar<p_str>(STRING_PATH);
       this->v_duration = this->insertVar<p_per>(STRING_DURATION);
+      this->v_hash = this->insertVar<p_str>(STRING_HASH);
+      this->v_crc32 = this->insertVar<p_num>(STRING_CRC32);
    }
 
 
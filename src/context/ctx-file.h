@@ -72,6 +72,8 @@ namespace perun2
       Variable<p_str>* v_parent;
       Variable<p_str>* v_path;
       Variable<p_per>* v_duration;
+      Variable<p_str>* v_hash;
+      Variable<p_num>* v_crc32;
 
    private:
       void initVars(Perun2Process& p2);
@@ -15,6 +15,7 @@
 #include "ctx-global.h"
 #include "../perun2.h"
 #include "../datatype/generator/gen-time.h"
+#include "../datatype/generator/gen-number.h"
 
 
 namespace perun2
@@ -27,6 +28,13 @@ namespace perun2
       this->globalVars.times.insert(std::make_pair(STRING_YESTERDAY, std::make_unique<gen::v_Yesterday>()));
       this->globalVars.times.insert(std::make_pair(STRING_TOMORROW, std::make_unique<gen::v_Tomorrow>()));
 
+      this->insertStat(STRING_DIRECTORYOPENS, SystemStat::ss_DirectoryOpens, p2);
+      this->insertStat(STRING_ENTRYREADS, SystemStat::ss_EntryReads, p2);
+      this->insertStat(STRING_ATTRIBUTEQUERIES, SystemStat::ss_AttributeQueries, p2);
+      this->insertStat(STRING_FILEOPENS, SystemStat::ss_FileOpens, p2);
+      this->insertStat(STRING_BYTESREAD, SystemStat::ss_BytesRead, p2);
+      this->insertStat(STRING_BYTESWRITTEN, SystemStat::ss_BytesWritten, p2);
+
       this->insertConstant<p_str>(STRING_DESKTOP);
       this->insertConstant<p_str>(STRING_PERUN2);
       this->insertConstant<p_str>(STRING_ORIGIN);
@@ -43,4 +51,9 @@ namespace perun2
       this->globalVars.numbers[STRING_NAN]->value.setToNaN();
    };
 
+   void GlobalContext::insertStat(const p_str& name, const SystemStat stat, Perun2Process& p2)
+   {
+      this->globalVars.numbers.insert(std::make_pair(name, std::make_unique<gen::v_SystemStat>(stat, p2)));
+   }
+
 }
@@ -15,6 +15,7 @@
 #pragma once
 
 #include "ctx-vars.h"
+#include "../system-stats.h"
 
 
 namespace perun2
@@ -37,6 +38,8 @@ namespace perun2
       VarsContext globalVars;
 
    private:
+      void insertStat(const p_str& name, const SystemStat stat, Perun2Process& p2);
+
       template <typename T>
       Variable<T>* insertVar(const p_str& name)
       {
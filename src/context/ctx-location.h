@@ -20,7 +20,7 @@
 namespace perun2
 {
 
-   struct LocationContext
+   struct LocationContext : ArenaAllocated
    {
    public:
       LocationContext();
@@ -33,6 +33,7 @@ namespace perun2
       this->addOsGen(STRING_RECURSIVEIMAGES, gen::OsElement::oe_RecursiveImages, p2);
       this->addOsGen(STRING_VIDEOS, gen::OsElement::oe_Videos, p2);
       this->addOsGen(STRING_RECURSIVEVIDEOS, gen::OsElement::oe_RecursiveVideos, p2);
+      this->addOsGen(STRING_DUPLICATES, gen::OsElement::oe_Duplicates, p2);
    };
 
    p_bool Contexts::getVar(const Token& tk, Variable<p_bool>*& result, Perun2Process& p2)
@@ -96,6 +97,7 @@ namespace perun2
    void Contexts::addUserVarsContext(UserVarsContext* ctx)
    {
       this->userVarsContexts.push_back(ctx);
+      this->allUserVarsContexts.push_back(ctx);
    }
 
    void Contexts::retreatUserVarsContext()
@@ -250,4 +252,14 @@ namespace perun2
       }
    }
 
+   void Contexts::resetRuntimeState(Perun2Process& p2)
+   {
+      this->success->value = false;
+      this->rootLocation.location->value = p2.arguments.getLocation();
+
+      for (UserVarsContext* uvc : this->allUserVarsContexts) {
+         uvc->userVars.resetUserVars();
+      }
+   }
+
 }
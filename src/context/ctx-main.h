@@ -79,6 +79,9 @@ namespace perun2
       void closeAttributeScope();
       void closeDeepAttributeScope();
 
+      // prepare variables for the next run of already parsed commands
+      void resetRuntimeState(Perun2Process& p2);
+
       p_varptr<p_bool> success;
       std::unordered_map<p_str, gen::DefinitionGenerator> osGenerators;
 
@@ -123,6 +126,8 @@ namespace perun2
       LocationContext rootLocation;
 
       std::vector<UserVarsContext*> userVarsContexts;
+      // every context of user variables ever created during parsing
+      std::vector<UserVarsContext*> allUserVarsContexts;
       std::vector<AggregateContext*> aggregateContexts;
       std::vector<LocationContext*> locationContexts;
       std::vector<IndexContext*> indexContexts;
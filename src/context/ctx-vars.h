@@ -65,6 +65,19 @@ namespace perun2
          return a.first->second.get();
       }
 
+      // values of constant variables are computed during parsing, so they remain
+      void resetUserVars()
+      {
+         this->resetUserVars(this->bools);
+         this->resetUserVars(this->times);
+         this->resetUserVars(this->periods);
+         this->resetUserVars(this->strings);
+         this->resetUserVars(this->numbers);
+         this->resetUserVars(this->timeLists);
+         this->resetUserVars(this->numLists);
+         this->resetUserVars(this->lists);
+      }
+
       p_varptrs<p_bool> bools;
       p_varptrs<p_tim> times;
       p_varptrs<p_per> periods;
@@ -73,10 +86,22 @@ namespace perun2
       p_varptrs<p_tlist> timeLists;
       p_varptrs<p_nlist> numLists;
       p_varptrs<p_list> lists;
+
+   private:
+      template <typename T>
+      void resetUserVars(p_varptrs<T>& vars)
+      {
+         for (auto& v : vars) {
+            Variable<T>& var = *v.second;
+            if (var.type == VarType::vt_User && !var.isConstant_) {
+               var.value = T();
+            }
+         }
+      }
    };
 
 
-   struct UserVarsContext
+   struct UserVarsContext : ArenaAllocated
    {
       VarsContext userVars;
    };
@@ -0,0 +1,255 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "daemon.h"
+#include "cmd.h"
+#include "os/os.h"
+#include <algorithm>
+#include <cwchar>
+#include <ostream>
+
+
+namespace perun2
+{
+
+PipeBuffer::PipeBuffer(p_entry pip)
+   : pipe(pip) { };
+
+PipeBuffer::int_type PipeBuffer::overflow(int_type ch)
+{
+   if (traits_type::eq_int_type(ch, traits_type::eof())) {
+      return traits_type::not_eof(ch);
+   }
+
+   this->buffer.push_back(traits_type::to_char_type(ch));
+
+   if (this->buffer.size() >= DAEMON_OUTPUT_PORTION && !this->send()) {
+      return traits_type::eof();
+   }
+
+   return ch;
+}
+
+int PipeBuffer::sync()
+{
+   return this->send() ? 0 : -1;
+}
+
+p_bool PipeBuffer::send()
+{
+   if (this->buffer.empty()) {
+      return true;
+   }
+
+   const p_bool result = os_writePipeMessage(this->pipe, this->buffer);
+   this->buffer.clear();
+   return result;
+}
+
+
+// daemon that is stopped by Ctrl+C
+static Daemon* activeDaemon = nullptr;
+
+static void stopActiveDaemon()
+{
+   if (activeDaemon != nullptr) {
+      activeDaemon->stop();
+   }
+}
+
+
+int Daemon::run()
+{
+   p_entry pipe = os_createDaemonPipe(true);
+
+   if (pipe == INVALID_HANDLE_VALUE) {
+      if (os_daemonPipeExists()) {
+         cmd::error::daemonPipeTaken();
+      }
+      else {
+         cmd::error::daemonPipe();
+      }
+
+      return EXITCODE_CLI_ERROR;
+   }
+
+   const p_size count = std::max<p_size>(std::thread::hardware_concurrency(), 1);
+
+   for (p_size i = 0; i < count; i++) {
+      this->workers.emplace_back(&Daemon::work, this);
+   }
+
+   activeDaemon = this;
+   Terminator::setShutdown(stopActiveDaemon);
+
+   while (true) {
+      const p_bool connected = os_connectDaemonPipe(pipe);
+
+      // every client gets its own instance of the pipe
+      // the next one is created before this one can be closed by a worker
+      // so the name never disappears and no other process can take it over
+      const p_entry next = os_createDaemonPipe(false);
+
+      {
+         const std::lock_guard<std::mutex> lock(this->mutex);
+
+         if (this->stopped) {
+            if (next != INVALID_HANDLE_VALUE) {
+               os_closeDaemonPipe(next);
+            }
+            break;
+         }
+
+         if (connected) {
+            this->clients.push_back(pipe);
+         }
+      }
+
+      if (connected) {
+         this->condition.notify_one();
+      }
+      else {
+         os_closeDaemonPipe(pipe);
+      }
+
+      pipe = next;
+
+      if (pipe == INVALID_HANDLE_VALUE) {
+         this->stop();
+         break;
+      }
+   }
+
+   if (pipe != INVALID_HANDLE_VALUE) {
+      os_closeDaemonPipe(pipe);
+   }
+
+   Terminator::setShutdown(nullptr);
+   activeDaemon = nullptr;
+
+   for (std::thread& w : this->workers) {
+      w.join();
+   }
+
+   for (p_entry client : this->clients) {
+      os_closeDaemonPipe(client);
+   }
+
+   return EXITCODE_OK;
+}
+
+void Daemon::stop()
+{
+   {
+      const std::lock_guard<std::mutex> lock(this->mutex);
+      if (this->stopped) {
+         return;
+      }
+      this->stopped = true;
+   }
+
+   this->condition.notify_all();
+   os_wakeDaemonPipe();
+}
+
+void Daemon::work()
+{
+   os_initThread();
+   p_scripts scripts;
+   p_entry client;
+
+   while (this->takeClient(client)) {
+      this->serve(client, scripts);
+      os_closeDaemonPipe(client);
+   }
+
+   // parsed scripts have to be destroyed before this thread ends
+   scripts.clear();
+   os_deinitThread();
+}
+
+p_bool Daemon::takeClient(p_entry& result)
+{
+   std::unique_lock<std::mutex> lock(this->mutex);
+   this->condition.wait(lock, [this] {
+      return this->stopped || !this->clients.empty();
+   });
+
+   if (this->stopped) {
+      return false;
+   }
+
+   result = this->clients.front();
+   this->clients.pop_front();
+   return true;
+}
+
+void Daemon::serve(p_entry pipe, p_scripts& scripts)
+{
+   p_str message;
+
+   while (os_readPipeMessage(pipe, message)) {
+      const p_size first = message.find(CHAR_NULL);
+      const p_size second = first == p_str::npos
+         ? p_str::npos
+         : message.find(CHAR_NULL, first + 1);
+
+      if (second == p_str::npos) {
+         os_writePipeMessage(pipe, str(toStr(CHAR_NULL), toStr(EXITCODE_CLI_ERROR)));
+         continue;
+      }
+
+      const p_flags flags = static_cast<p_flags>(std::wcstoul(message.c_str(), nullptr, 10));
+      const p_str location = message.substr(first + 1, second - first - 1);
+      const p_str code = message.substr(second + 1);
+
+      auto found = scripts.find(message);
+
+      if (found == scripts.end()) {
+         if (scripts.size() >= DAEMON_CACHE_LIMIT) {
+            scripts.clear();
+         }
+
+         found = scripts.emplace(message, std::make_unique<Perun2>(location, code, flags, this->caches)).first;
+      }
+
+      Perun2& instance = *found->second;
+      PipeBuffer buffer(pipe);
+      std::wostream output(&buffer);
+      instance.setOutput(output);
+
+      if (instance.hasArgFlag(FLAG_STATIC_ANALYSIS)) {
+         instance.staticallyAnalyze();
+      }
+      else {
+         instance.run();
+      }
+
+      output.flush();
+      instance.setOutput(p_cout);
+
+      if (!os_writePipeMessage(pipe, str(toStr(CHAR_NULL), toStr(instance.getExitCode())))) {
+         return;
+      }
+   }
+}
+
+
+int runDaemon()
+{
+   Daemon daemon;
+   return daemon.run();
+}
+
+}
@@ -0,0 +1,95 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "perun2.h"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <streambuf>
+#include <thread>
+#include <unordered_map>
+
+
+namespace perun2
+{
+
+// every worker remembers this many parsed scripts
+// when the limit is exceeded, it forgets all of them
+p_constexpr p_size DAEMON_CACHE_LIMIT = 32;
+
+// output of a job is sent back to the client in portions of this size
+// or more often, if the job was sent with the flag -g
+p_constexpr p_size DAEMON_OUTPUT_PORTION = 2048;
+
+
+// stream buffer that sends everything written to it through the daemon pipe
+struct PipeBuffer : std::wstreambuf
+{
+public:
+   PipeBuffer() = delete;
+   PipeBuffer(p_entry pip);
+
+protected:
+   int_type overflow(int_type ch) override;
+   int sync() override;
+
+private:
+   p_bool send();
+
+   p_entry pipe;
+   p_str buffer;
+};
+
+
+// the daemon mode
+// Perun2 listens on a named pipe and executes jobs sent by clients
+// one pipe message is one job: flags, location and code separated by null characters
+// the answer is any number of messages with the output of the job
+// and then a final message: null character followed by the exit code
+// every worker thread keeps already parsed scripts, so a job repeated with the same arguments is not parsed again
+// content hashes and metadata of media are shared by all workers
+struct Daemon
+{
+public:
+   Daemon() = default;
+   Daemon(Daemon const&) = delete;
+   Daemon& operator= (Daemon const&) = delete;
+
+   // block the current thread until the daemon is stopped by Ctrl+C
+   int run();
+   void stop();
+
+private:
+   typedef std::unordered_map<p_str, std::unique_ptr<Perun2>> p_scripts;
+
+   void work();
+   void serve(p_entry pipe, p_scripts& scripts);
+   p_bool takeClient(p_entry& result);
+
+   std::mutex mutex;
+   std::condition_variable condition;
+   std::deque<p_entry> clients;
+   std::vector<std::thread> workers;
+   p_bool stopped = false;
+   // the persistent media cache is written back only by scripts with the flag -p
+   FileCaches caches{true};
+};
+
+
+int runDaemon();
+
+}
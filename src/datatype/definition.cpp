@@ -13,11 +13,31 @@
 */
 
 #include "definition.h"
+#include <algorithm>
 
 
 namespace perun2
 {
 
+thread_local DefinitionRegistry* DefinitionRegistry::active = nullptr;
+
+
+Definition::Definition()
+   : registry(DefinitionRegistry::active)
+{
+   if (this->registry != nullptr) {
+      this->registry->add(this);
+   }
+}
+
+
+Definition::~Definition() noexcept
+{
+   if (this->registry != nullptr) {
+      this->registry->remove(this);
+   }
+}
+
 
 p_str Definition::getValue()
 {
@@ -37,4 +57,31 @@ p_bool Definition::setAction(p_daptr& act)
 };
 
 
+
+void DefinitionRegistry::add(Definition* definition)
+{
+   this->definitions.push_back(definition);
+}
+
+
+void DefinitionRegistry::remove(Definition* definition)
+{
+   const auto it = std::find(this->definitions.begin(), this->definitions.end(), definition);
+
+   if (it != this->definitions.end()) {
+      this->definitions.erase(it);
+   }
+}
+
+
+void DefinitionRegistry::resetAll()
+{
+   // resets are idempotent, so the order does not matter
+   // nested definitions can be reset twice, by their owner and by this loop
+   for (Definition* definition : this->definitions) {
+      definition->reset();
+   }
+}
+
+
 }
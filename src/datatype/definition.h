@@ -17,18 +17,23 @@
 #include "definition-action.h"
 #include "generator.h"
 #include <memory>
+#include <vector>
 
 
 namespace perun2
 {
 
 struct FileContext;
+struct DefinitionRegistry;
 
 // a lazy evaluated collection of strings
 // returns next element on demand
 struct Definition : Generator<p_str>
 {
 public:
+   Definition();
+   ~Definition() noexcept;
+
    virtual p_bool hasNext() = 0;
    virtual void reset() = 0;
 
@@ -43,8 +48,30 @@ public:
 protected:
    p_str value;
    p_daptr action;
+
+private:
+   DefinitionRegistry* const registry;
 };
 
 typedef std::unique_ptr<Definition> p_defptr;
 
+
+// every definition created while a script is parsed
+// a run can end in the middle of an iteration (exit, runtime error, cancellation)
+// then some definitions still hold their position and open handles
+// so all of them are reset before the next run of the same parsed script
+struct DefinitionRegistry
+{
+public:
+   void add(Definition* definition);
+   void remove(Definition* definition);
+   void resetAll();
+
+   // registry of the script, that is being parsed on this thread
+   static thread_local DefinitionRegistry* active;
+
+private:
+   std::vector<Definition*> definitions;
+};
+
 }
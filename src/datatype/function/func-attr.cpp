@@ -165,7 +165,7 @@ p_per F_DurationDefinition::getValue()
       }
 
       const p_str v = definition->getValue();
-      total += os_attr_duration(os_leftJoin(this->context->location->value, v));
+      total += os_attr_duration(os_leftJoin(this->context->location->value, v), this->perun2);
    }
 
    return alignPeriod(total);
@@ -190,7 +190,7 @@ p_per F_DurationList::getValue()
 
       const p_str v = os_trim(vs[i]);
       if (!v.empty() && !os_isInvalid(v)) {
-         total += os_attr_duration(os_leftJoin(this->context->location->value, v));
+         total += os_attr_duration(os_leftJoin(this->context->location->value, v), this->perun2);
       }
    }
 
@@ -330,7 +330,7 @@ p_bool F_Attr_IsImage::getValue()
 {
    return this->context.invalid
       ? false
-      : os_attr_isImage(this->context.v_path->value);
+      : os_attr_isImage(this->context.v_path->value, this->perun2);
 }
 
 
@@ -338,7 +338,7 @@ p_bool F_Attr_IsVideo::getValue()
 {
    return this->context.invalid
       ? false
-      : os_attr_isVideo(this->context.v_path->value);
+      : os_attr_isVideo(this->context.v_path->value, this->perun2);
 }
 
 
@@ -346,7 +346,7 @@ p_num F_Attr_Width::getValue()
 {
    return this->context.invalid
       ? P_NaN
-      : os_attr_width(this->context.v_path->value);
+      : os_attr_width(this->context.v_path->value, this->perun2);
 }
 
 
@@ -354,7 +354,29 @@ p_num F_Attr_Height::getValue()
 {
    return this->context.invalid
       ? P_NaN
-      : os_attr_height(this->context.v_path->value);
+      : os_attr_height(this->context.v_path->value, this->perun2);
+}
+
+
+p_str F_Attr_Hash::getValue()
+{
+   ContentHash hash;
+
+   return !this->context.invalid
+      && os_contentHash(this->context.v_path->value, true, false, hash, this->perun2)
+         ? hashToString(hash.hash)
+         : p_str();
+}
+
+
+p_num F_Attr_Crc32::getValue()
+{
+   ContentHash hash;
+
+   return !this->context.invalid
+      && os_contentHash(this->context.v_path->value, false, true, hash, this->perun2)
+         ? p_num(static_cast<p_nint>(hash.crc32))
+         : P_NaN;
 }
 
 
@@ -362,7 +384,7 @@ p_per F_Attr_Duration::getValue()
 {
    return this->context.invalid
       ? p_per()
-      : os_attr_duration(this->context.v_path->value);
+      : os_attr_duration(this->context.v_path->value, this->perun2);
 }
 
 
@@ -339,6 +339,22 @@ public:
 };
 
 
+struct F_Attr_Hash : F_Attribute, Generator<p_str>
+{
+public:
+   F_Attr_Hash(Perun2Process& p2) : F_Attribute(p2) { };
+   p_str getValue() override;
+};
+
+
+struct F_Attr_Crc32 : F_Attribute, Generator<p_num>
+{
+public:
+   F_Attr_Crc32(Perun2Process& p2) : F_Attribute(p2) { };
+   p_num getValue() override;
+};
+
+
 struct F_Attr_Duration : F_Attribute, Generator<p_per>
 {
 public:
@@ -291,7 +291,50 @@ p_bool F_FindText::getValue()
       return true;
    }
 
-   return os_findText(this->context->v_path->value, value);
+   return os_findText(this->context->v_path->value, TextSearch(value));
+}
+
+p_bool F_FindTextConst::getValue()
+{
+   if (!this->context->v_exists->value || !this->context->v_isfile->value) {
+      return false;
+   }
+
+   return os_findText(this->context->v_path->value, this->search);
+}
+
+p_bool F_FindAnyText::getValue()
+{
+   if (!this->context->v_exists->value || !this->context->v_isfile->value) {
+      return false;
+   }
+
+   MultiTextSearch search(this->arg1->getValue());
+   return os_findAnyText(this->context->v_path->value, search);
+}
+
+p_bool F_FindAnyTextConst::getValue()
+{
+   if (!this->context->v_exists->value || !this->context->v_isfile->value) {
+      return false;
+   }
+
+   return os_findAnyText(this->context->v_path->value, this->search);
+}
+
+p_bool F_SameContent::getValue()
+{
+   if (!this->context->v_exists->value || !this->context->v_isfile->value) {
+      return false;
+   }
+
+   const p_str value = os_trim(this->arg1->getValue());
+   if (value.empty()) {
+      return false;
+   }
+
+   const p_str other = os_leftJoin(this->context->locContext->location->value, value);
+   return os_sameContent(this->context->v_path->value, other);
 }
 
 
@@ -15,6 +15,7 @@
 #pragma once
 
 #include "func-generic.h"
+#include "../text/text-search.h"
 #include <wctype.h>
 
 
@@ -242,6 +243,59 @@ private:
 };
 
 
+// the searched text is a constant, so it is encoded only once
+struct F_FindTextConst : Generator<p_bool>
+{
+public:
+   F_FindTextConst(const p_str& value, FileContext* ctx)
+      : search(value), context(ctx) { };
+   p_bool getValue() override;
+
+private:
+   const TextSearch search;
+   FileContext* context;
+};
+
+
+struct F_FindAnyText : Func_1<p_list>, Generator<p_bool>
+{
+public:
+   F_FindAnyText(p_genptr<p_list>& a1, FileContext* ctx)
+      : Func_1(a1), context(ctx) { };
+   p_bool getValue() override;
+
+private:
+   FileContext* context;
+};
+
+
+// the automaton of constant texts is built only once
+struct F_FindAnyTextConst : Generator<p_bool>
+{
+public:
+   F_FindAnyTextConst(const p_list& values, FileContext* ctx)
+      : search(values), context(ctx) { };
+   p_bool getValue() override;
+
+private:
+   MultiTextSearch search;
+   FileContext* context;
+};
+
+
+// byte-to-byte comparison of this file with another one
+struct F_SameContent : Func_1<p_str>, Generator<p_bool>
+{
+public:
+   F_SameContent(p_genptr<p_str>& a1, FileContext* ctx)
+      : Func_1(a1), context(ctx) { };
+   p_bool getValue() override;
+
+private:
+   FileContext* context;
+};
+
+
 
 struct F_IsLetter : Func_1<p_str>, Generator<p_bool>
 {
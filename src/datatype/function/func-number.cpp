@@ -112,6 +112,27 @@ p_num F_Length::getValue()
 }
 
 
+p_num F_CountText::getValue()
+{
+   if (!this->context->v_exists->value || !this->context->v_isfile->value) {
+      return P_NaN;
+   }
+
+   MultiTextSearch search(this->arg1->getValue());
+   return p_num(os_countText(this->context->v_path->value, search));
+}
+
+
+p_num F_CountTextConst::getValue()
+{
+   if (!this->context->v_exists->value || !this->context->v_isfile->value) {
+      return P_NaN;
+   }
+
+   return p_num(os_countText(this->context->v_path->value, this->search));
+}
+
+
 p_num F_Number::getValue()
 {
    const p_str s = this->arg1->getValue();
@@ -16,6 +16,7 @@
 
 #include "func-generic.h"
 #include "../../perun2.h"
+#include "../text/text-search.h"
 
 
 namespace perun2::func
@@ -69,6 +70,32 @@ public:
 };
 
 
+// number of occurrences of given texts in the content of the file
+struct F_CountText : Func_1<p_list>, Generator<p_num>
+{
+public:
+   F_CountText(p_genptr<p_list>& a1, FileContext* ctx)
+      : Func_1(a1), context(ctx) { };
+   p_num getValue() override;
+
+private:
+   FileContext* context;
+};
+
+
+struct F_CountTextConst : Generator<p_num>
+{
+public:
+   F_CountTextConst(const p_list& values, FileContext* ctx)
+      : search(values), context(ctx) { };
+   p_num getValue() override;
+
+private:
+   MultiTextSearch search;
+   FileContext* context;
+};
+
+
 struct F_Number : Func_1<p_str>, Generator<p_num>
 {
 public:
@@ -15,6 +15,7 @@
 #pragma once
 
 #include "primitives.h"
+#include "../arena.h"
 #include <memory>
 
 
@@ -25,9 +26,11 @@ namespace perun2
 // that generates a new instance of a certain data type
 // when its method getValue() is called
 template <typename T>
-struct Generator
+struct Generator : ArenaAllocated
 {
 public:
+   // generators are owned through pointers to their base
+   virtual ~Generator() noexcept = default;
 
    virtual T getValue() = 0;
 
@@ -0,0 +1,215 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gen-duplicates.h"
+#include "../../os/os.h"
+#include "../../perun2.h"
+#include "../../content-hash.h"
+#include <algorithm>
+#include <unordered_map>
+
+
+namespace perun2::gen
+{
+
+// divide candidates into groups of equal keys and keep their original order
+// a candidate is dropped, if its key could not be computed or if nothing else has the same key
+template <typename F>
+static std::vector<p_candidates> splitCandidates(p_candidates& candidates, F getKey)
+{
+   std::vector<p_candidates> groups;
+   std::unordered_map<uint64_t, p_size> indexes;
+
+   for (DuplicateCandidate& candidate : candidates) {
+      uint64_t key;
+      if (!getKey(candidate, key)) {
+         continue;
+      }
+
+      const auto found = indexes.find(key);
+
+      if (found == indexes.end()) {
+         indexes.emplace(key, groups.size());
+         groups.emplace_back();
+         groups.back().push_back(std::move(candidate));
+      }
+      else {
+         groups[found->second].push_back(std::move(candidate));
+      }
+   }
+
+   groups.erase(std::remove_if(groups.begin(), groups.end(),
+      [](const p_candidates& group) { return group.size() < 2; }), groups.end());
+
+   return groups;
+}
+
+// equal hashes do not prove equal content, so candidates with the same hash are compared byte by byte
+// usually they are all copies of the first one and every candidate is compared once
+static std::vector<p_candidates> confirmCandidates(p_candidates& candidates, Perun2Process& p2)
+{
+   std::vector<p_candidates> groups;
+
+   for (DuplicateCandidate& candidate : candidates) {
+      if (p2.isNotRunning()) {
+         return std::vector<p_candidates>();
+      }
+
+      const auto same = std::find_if(groups.begin(), groups.end(),
+         [&candidate](const p_candidates& group) { return os_sameContent(group.front().path, candidate.path); });
+
+      if (same == groups.end()) {
+         groups.emplace_back();
+         groups.back().push_back(std::move(candidate));
+      }
+      else {
+         same->push_back(std::move(candidate));
+      }
+   }
+
+   groups.erase(std::remove_if(groups.begin(), groups.end(),
+      [](const p_candidates& group) { return group.size() < 2; }), groups.end());
+
+   return groups;
+}
+
+
+Duplicates::Duplicates(p_defptr& def, Perun2Process& p2)
+   : perun2(p2), definition(std::move(def)), context(p2)
+{
+   // sizes come from directory listing, so the file system is not accessed for every file
+   FileContext* inner = this->definition->getFileContext();
+   inner->attribute->setCoreCommandBase();
+   inner->attribute->set(ATTR_SIZE_FILE_ONLY);
+};
+
+
+FileContext* Duplicates::getFileContext()
+{
+   return &this->context;
+}
+
+
+void Duplicates::reset()
+{
+   if (!this->first) {
+      this->first = true;
+      this->sizes.clear();
+      this->ready.clear();
+   }
+}
+
+
+void Duplicates::collect()
+{
+   FileContext* inner = this->definition->getFileContext();
+
+   while (this->definition->hasNext()) {
+      if (this->perun2.isNotRunning()) {
+         this->definition->reset();
+         return;
+      }
+
+      // empty files are not considered to be copies of each other
+      const p_nint size = inner->v_size->value.toInt();
+
+      if (size > 0) {
+         this->sizes[size].push_back({ this->definition->getValue(), inner->v_path->value });
+      }
+   }
+}
+
+
+p_bool Duplicates::findNextGroups()
+{
+   while (!this->sizes.empty()) {
+      if (this->perun2.isNotRunning()) {
+         return false;
+      }
+
+      const auto smallest = this->sizes.begin();
+      const p_size size = static_cast<p_size>(smallest->first);
+      p_candidates candidates = std::move(smallest->second);
+      this->sizes.erase(smallest);
+
+      if (candidates.size() < 2) {
+         continue;
+      }
+
+      std::vector<p_candidates> partials = splitCandidates(candidates,
+         [this, size](const DuplicateCandidate& candidate, uint64_t& key) {
+            return this->perun2.isRunning()
+               && os_partialHash(candidate.path, size, key);
+         });
+
+      for (p_candidates& partial : partials) {
+         // small files have already been hashed entirely
+         if (size <= 2 * HASH_PART_SIZE) {
+            for (p_candidates& confirmed : confirmCandidates(partial, this->perun2)) {
+               this->ready.insert(this->ready.end(), confirmed.begin(), confirmed.end());
+            }
+            continue;
+         }
+
+         std::vector<p_candidates> groups = splitCandidates(partial,
+            [this](const DuplicateCandidate& candidate, uint64_t& key) {
+               ContentHash hash;
+               if (this->perun2.isNotRunning()
+                  || !os_contentHash(candidate.path, true, false, hash, this->perun2))
+               {
+                  return false;
+               }
+
+               key = hash.hash;
+               return true;
+            });
+
+         for (p_candidates& group : groups) {
+            for (p_candidates& confirmed : confirmCandidates(group, this->perun2)) {
+               this->ready.insert(this->ready.end(), confirmed.begin(), confirmed.end());
+            }
+         }
+      }
+
+      if (!this->ready.empty()) {
+         return true;
+      }
+   }
+
+   return false;
+}
+
+
+p_bool Duplicates::hasNext()
+{
+   if (this->first) {
+      this->first = false;
+      this->index.setToZero();
+      this->collect();
+   }
+
+   if (this->perun2.isRunning() && (!this->ready.empty() || this->findNextGroups())) {
+      this->value = std::move(this->ready.front().value);
+      this->ready.pop_front();
+      this->context.index->value = this->index;
+      this->index++;
+      this->context.loadData(this->value);
+      return true;
+   }
+
+   this->reset();
+   return false;
+}
+
+}
@@ -0,0 +1,75 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "../definition.h"
+#include "../../context/ctx-file.h"
+#include <deque>
+#include <map>
+#include <vector>
+
+
+namespace perun2
+{
+struct Perun2Process;
+}
+
+namespace perun2::gen
+{
+
+// file, that may have the same content as some other files
+struct DuplicateCandidate
+{
+   p_str value;
+   p_str path;
+};
+
+typedef std::vector<DuplicateCandidate> p_candidates;
+
+
+// files of a directory tree, that have at least one copy somewhere in this tree
+// files are compared in stages, from the cheapest one:
+// first by their size, then by a hash of their first and last bytes, then by a hash of their content
+// and copies are confirmed by comparison of their bytes at the end
+// groups of copies are returned one after another
+// and the next group is searched for only when the previous one has been returned entirely
+struct Duplicates : Definition
+{
+public:
+   Duplicates() = delete;
+   Duplicates(p_defptr& def, Perun2Process& p2);
+
+   p_bool hasNext() override;
+   void reset() override;
+   FileContext* getFileContext() override;
+
+private:
+   void collect();
+   p_bool findNextGroups();
+
+   Perun2Process& perun2;
+   // all files of the tree with only their paths and sizes loaded
+   p_defptr definition;
+   FileContext context;
+   p_bool first = true;
+   p_num index;
+
+   // candidates of equal size, from the smallest ones
+   std::map<p_nint, p_candidates> sizes;
+   // found copies waiting to be returned
+   std::deque<DuplicateCandidate> ready;
+};
+
+}
@@ -14,6 +14,7 @@
 
 #include "gen-number.h"
 #include "gen-generic.h"
+#include "../../perun2.h"
 
 
 namespace perun2::gen
@@ -161,4 +162,9 @@ p_num TimeMember::getValue()
    return P_NaN;
 }
 
+p_num v_SystemStat::getValue()
+{
+   return p_num(static_cast<p_nint>(this->perun2.systemStats.get(this->stat)));
+}
+
 }
@@ -16,8 +16,15 @@
 
 #include "../generator.h"
 #include "gen-generic.h"
+#include "../../var.h"
+#include "../../system-stats.h"
 
 
+namespace perun2
+{
+   struct Perun2Process;
+}
+
 namespace perun2::gen
 {
 
@@ -81,4 +88,21 @@ protected:
    const Period::PeriodUnit unit;
 };
 
+
+
+// file system operations caused by the current run so far
+struct v_SystemStat : Variable<p_num>
+{
+public:
+   v_SystemStat() = delete;
+   v_SystemStat(const SystemStat st, Perun2Process& p2)
+      : Variable<p_num>(VarType::vt_Special), stat(st), perun2(p2) { };
+
+   p_num getValue() override;
+
+private:
+   const SystemStat stat;
+   Perun2Process& perun2;
+};
+
 }
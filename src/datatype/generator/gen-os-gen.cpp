@@ -16,6 +16,7 @@
 #include "gen-os.h"
 #include "gen-string.h"
 #include "gen-definition.h"
+#include "gen-duplicates.h"
 
 
 namespace perun2::gen
@@ -86,6 +87,11 @@ p_bool DefinitionGenerator::generate(p_defptr& result) const
          result = std::make_unique<FileClass>(prev, context, *context->v_isvideo, perun2);
          break;
       }
+      case OsElement::oe_Duplicates: {
+         p_defptr prev = std::make_unique<RecursiveFiles>(P_GEN_OS_ARGS_DEFAULT);
+         result = std::make_unique<Duplicates>(prev, perun2);
+         break;
+      }
       default: {
          return false;
       }
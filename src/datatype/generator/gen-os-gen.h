@@ -38,7 +38,8 @@ enum OsElement
    oe_RecursiveDirectories,
    oe_RecursiveFiles,
    oe_RecursiveImages,
-   oe_RecursiveVideos
+   oe_RecursiveVideos,
+   oe_Duplicates
 };
 
 
@@ -0,0 +1,47 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gen-profile.h"
+
+
+namespace perun2::gen
+{
+
+p_bool ProfiledDefinition::hasNext()
+{
+   const ProfileScope scope(this->profiler, this->site);
+   return this->definition->hasNext();
+}
+
+void ProfiledDefinition::reset()
+{
+   this->definition->reset();
+}
+
+p_str ProfiledDefinition::getValue()
+{
+   return this->definition->getValue();
+}
+
+FileContext* ProfiledDefinition::getFileContext()
+{
+   return this->definition->getFileContext();
+}
+
+p_bool ProfiledDefinition::setAction(p_daptr& act)
+{
+   return this->definition->setAction(act);
+}
+
+}
@@ -0,0 +1,68 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "../generator.h"
+#include "../definition.h"
+#include "../../profiler.h"
+
+
+namespace perun2::gen
+{
+
+// these wrappers exist only if the profiler is turned on
+// otherwise, the syntax tree is the same as always
+
+template <typename T>
+struct ProfiledGenerator : Generator<T>
+{
+public:
+   ProfiledGenerator<T> (p_genptr<T>& val, const p_size st, Profiler& prof)
+      : value(std::move(val)), site(st), profiler(prof) { };
+
+   T getValue() override
+   {
+      const ProfileScope scope(this->profiler, this->site);
+      return this->value->getValue();
+   };
+
+private:
+   p_genptr<T> value;
+   const p_size site;
+   Profiler& profiler;
+};
+
+
+// only iteration is measured
+// the value of a definition is already there after hasNext()
+struct ProfiledDefinition : Definition
+{
+public:
+   ProfiledDefinition(p_defptr& def, const p_size st, Profiler& prof)
+      : definition(std::move(def)), site(st), profiler(prof) { };
+
+   p_bool hasNext() override;
+   void reset() override;
+   p_str getValue() override;
+   FileContext* getFileContext() override;
+   p_bool setAction(p_daptr& act) override;
+
+private:
+   p_defptr definition;
+   const p_size site;
+   Profiler& profiler;
+};
+
+}
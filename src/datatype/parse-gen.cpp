@@ -18,17 +18,18 @@
 #include "../lexer.h"
 #include "../brackets.h"
 #include "parse/parse-function.h"
+#include "generator/gen-profile.h"
 
 
 namespace perun2::parse
 {
 
-p_bool parse(Perun2Process& p2, const Tokens& tks, p_genptr<p_bool>& result)
+static p_bool parseValue(Perun2Process& p2, const Tokens& tks, p_genptr<p_bool>& result)
 {
    return parseBool(result, tks, p2);
 }
 
-p_bool parse(Perun2Process& p2, const Tokens& tks, p_genptr<p_num>& result)
+static p_bool parseValue(Perun2Process& p2, const Tokens& tks, p_genptr<p_num>& result)
 {
    // cast from "bool" to "Number"
    p_genptr<p_bool> boo;
@@ -40,7 +41,7 @@ p_bool parse(Perun2Process& p2, const Tokens& tks, p_genptr<p_num>& result)
    return parseNumber(result, tks, p2);
 }
 
-p_bool parse(Perun2Process& p2, const Tokens& tks, p_genptr<p_str>& result)
+static p_bool parseValue(Perun2Process& p2, const Tokens& tks, p_genptr<p_str>& result)
 {
    // cast from "bool" to "string"
    p_genptr<p_bool> boo;
@@ -73,7 +74,7 @@ p_bool parse(Perun2Process& p2, const Tokens& tks, p_genptr<p_str>& result)
    return parseString(result, tks, p2);
 }
 
-p_bool parse(Perun2Process& p2, const Tokens& tks, p_genptr<p_nlist>& result)
+static p_bool parseValue(Perun2Process& p2, const Tokens& tks, p_genptr<p_nlist>& result)
 {
    // cast from "bool" to "numList"
    p_genptr<p_bool> boo;
@@ -92,7 +93,7 @@ p_bool parse(Perun2Process& p2, const Tokens& tks, p_genptr<p_nlist>& result)
    return parseNumList(result, tks, p2);
 }
 
-p_bool parse(Perun2Process& p2, const Tokens& tks, p_genptr<p_tlist>& result)
+static p_bool parseValue(Perun2Process& p2, const Tokens& tks, p_genptr<p_tlist>& result)
 {
    // cast from "Time" to "timList"
    p_genptr<p_tim> tim;
@@ -104,7 +105,7 @@ p_bool parse(Perun2Process& p2, const Tokens& tks, p_genptr<p_tlist>& result)
    return parseTimList(result, tks, p2);
 }
 
-p_bool parse(Perun2Process& p2, const Tokens& tks, p_genptr<p_list>& result)
+static p_bool parseValue(Perun2Process& p2, const Tokens& tks, p_genptr<p_list>& result)
 {
    // cast from "bool" to "list"
    p_genptr<p_bool> boo;
@@ -165,19 +166,98 @@ p_bool parse(Perun2Process& p2, const Tokens& tks, p_genptr<p_list>& result)
    return parseList(result, tks, p2);
 }
 
-p_bool parse(Perun2Process& p2, const Tokens& tks, p_genptr<p_tim>& result)
+static p_bool parseValue(Perun2Process& p2, const Tokens& tks, p_genptr<p_tim>& result)
 {
    return parseTime(result, tks, p2);
 }
 
-p_bool parse(Perun2Process& p2, const Tokens& tks, p_genptr<p_per>& result)
+static p_bool parseValue(Perun2Process& p2, const Tokens& tks, p_genptr<p_per>& result)
 {
    return parsePeriod(result, tks, p2);
 }
 
-p_bool parse(Perun2Process& p2, const Tokens& tks, p_defptr& result)
+static p_bool parseValue(Perun2Process& p2, const Tokens& tks, p_defptr& result)
 {
    return parseDefinition(result, tks, p2);
 }
 
+
+// with the profiler, every parsed expression is measured separately
+// constants are left as they are, they cost nothing
+template <typename T>
+static void profile(p_genptr<T>& result, const Tokens& tks, const p_char* name, Perun2Process& p2)
+{
+   if (result->isConstant()) {
+      return;
+   }
+
+   const p_size site = p2.profiler.addSite(ProfileKind::pk_Generator, tks.first().line, name);
+   result = std::make_unique<gen::ProfiledGenerator<T>>(result, site, p2.profiler);
+}
+
+static void profile(p_defptr& result, const Tokens& tks, const p_char* name, Perun2Process& p2)
+{
+   const p_size site = p2.profiler.addSite(ProfileKind::pk_Generator, tks.first().line, name);
+   result = std::make_unique<gen::ProfiledDefinition>(result, site, p2.profiler);
+}
+
+template <typename T>
+static p_bool parseProfiled(Perun2Process& p2, const Tokens& tks, T& result, const p_char* name)
+{
+   if (! parseValue(p2, tks, result)) {
+      return false;
+   }
+
+   if (p2.profiler.isEnabled()) {
+      profile(result, tks, name, p2);
+   }
+
+   return true;
+}
+
+p_bool parse(Perun2Process& p2, const Tokens& tks, p_genptr<p_bool>& result)
+{
+   return parseProfiled(p2, tks, result, L"bool");
+}
+
+p_bool parse(Perun2Process& p2, const Tokens& tks, p_genptr<p_num>& result)
+{
+   return parseProfiled(p2, tks, result, L"number");
+}
+
+p_bool parse(Perun2Process& p2, const Tokens& tks, p_genptr<p_str>& result)
+{
+   return parseProfiled(p2, tks, result, L"string");
+}
+
+p_bool parse(Perun2Process& p2, const Tokens& tks, p_genptr<p_nlist>& result)
+{
+   return parseProfiled(p2, tks, result, L"numList");
+}
+
+p_bool parse(Perun2Process& p2, const Tokens& tks, p_genptr<p_tlist>& result)
+{
+   return parseProfiled(p2, tks, result, L"timList");
+}
+
+p_bool parse(Perun2Process& p2, const Tokens& tks, p_genptr<p_list>& result)
+{
+   return parseProfiled(p2, tks, result, L"list");
+}
+
+p_bool parse(Perun2Process& p2, const Tokens& tks, p_genptr<p_tim>& result)
+{
+   return parseProfiled(p2, tks, result, L"time");
+}
+
+p_bool parse(Perun2Process& p2, const Tokens& tks, p_genptr<p_per>& result)
+{
+   return parseProfiled(p2, tks, result, L"period");
+}
+
+p_bool parse(Perun2Process& p2, const Tokens& tks, p_defptr& result)
+{
+   return parseProfiled(p2, tks, result, L"definition");
+}
+
 }
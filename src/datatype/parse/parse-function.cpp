@@ -403,7 +403,55 @@ p_bool boolFunction(p_genptr<p_bool>& result, const Tokens& tks, Perun2Process&
          functionArgException(0, STRING_STRING, word, p2);
       }
 
-      result = std::make_unique<F_FindText>(str_, ctx);
+      if (str_->isConstant()) {
+         result = std::make_unique<F_FindTextConst>(str_->getValue(), ctx);
+      }
+      else {
+         result = std::make_unique<F_FindText>(str_, ctx);
+      }
+
+      return true;
+   }
+   else if (word.isWord(STRING_FINDANYTEXT, p2)) {
+      if (len != 1) {
+         functionArgNumberException(len, word, p2);
+      }
+
+      checkFunctionAttribute(word, p2);
+
+      FileContext* ctx = p2.contexts.getFileContext();
+      ctx->attribute->setCoreCommandBase();
+
+      p_genptr<p_list> list;
+      if (!parse::parse(p2, args[0], list)) {
+         functionArgException(0, STRING_LIST, word, p2);
+      }
+
+      if (list->isConstant()) {
+         result = std::make_unique<F_FindAnyTextConst>(list->getValue(), ctx);
+      }
+      else {
+         result = std::make_unique<F_FindAnyText>(list, ctx);
+      }
+
+      return true;
+   }
+   else if (word.isWord(STRING_SAMECONTENT, p2)) {
+      if (len != 1) {
+         functionArgNumberException(len, word, p2);
+      }
+
+      checkFunctionAttribute(word, p2);
+
+      FileContext* ctx = p2.contexts.getFileContext();
+      ctx->attribute->setCoreCommandBase();
+
+      p_genptr<p_str> str_;
+      if (!parse::parse(p2, args[0], str_)) {
+         functionArgException(0, STRING_STRING, word, p2);
+      }
+
+      result = std::make_unique<F_SameContent>(str_, ctx);
       return true;
    }
    else if (word.isWord(STRING_ISNAN, p2)) {
@@ -475,6 +523,30 @@ p_bool numberFunction(p_genptr<p_num>& result, const Tokens& tks, Perun2Process&
 
       return simpleNumberFunction(result, args[0], word, p2);
    }
+   else if (word.isWord(STRING_COUNTTEXT, p2)) {
+      if (len != 1) {
+         functionArgNumberException(len, word, p2);
+      }
+
+      checkFunctionAttribute(word, p2);
+
+      FileContext* ctx = p2.contexts.getFileContext();
+      ctx->attribute->setCoreCommandBase();
+
+      p_genptr<p_list> list;
+      if (!parse::parse(p2, args[0], list)) {
+         functionArgException(0, STRING_LIST, word, p2);
+      }
+
+      if (list->isConstant()) {
+         result = std::make_unique<F_CountTextConst>(list->getValue(), ctx);
+      }
+      else {
+         result = std::make_unique<F_CountText>(list, ctx);
+      }
+
+      return true;
+   }
    else if (word.isWord(STRING_LENGTH, p2)) {
       if (len != 1)
          functionArgNumberException(len, word, p2);
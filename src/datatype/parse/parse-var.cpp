@@ -75,6 +75,16 @@ namespace perun2::parse
       return false;
    }
 
+   p_bool makeVarRefAsFunction(const Token& tk, p_genptr<p_str>& result, Perun2Process& p2)
+   {
+      if (tk.isVariable(STRING_HASH, p2)) {
+         result = std::make_unique<func::F_Attr_Hash>(p2);
+         return true;
+      }
+
+      return false;
+   }
+
    p_bool makeVarRefAsFunction(const Token& tk, p_genptr<p_num>& result, Perun2Process& p2)
    {
       if (tk.isVariable(STRING_SIZE, p2)) {
@@ -89,6 +99,10 @@ namespace perun2::parse
          result = std::make_unique<func::F_Attr_Height>(p2);
          return true;
       }
+      else if (tk.isVariable(STRING_CRC32, p2)) {
+         result = std::make_unique<func::F_Attr_Crc32>(p2);
+         return true;
+      }
 
       return false;
    }
@@ -22,6 +22,7 @@ namespace perun2::parse
    p_bool isAlterableAttribute(const Token& tk, Perun2Process& p2);
 
    p_bool makeVarRefAsFunction(const Token& tk, p_genptr<p_bool>& result, Perun2Process& p2);
+   p_bool makeVarRefAsFunction(const Token& tk, p_genptr<p_str>& result, Perun2Process& p2);
    p_bool makeVarRefAsFunction(const Token& tk, p_genptr<p_num>& result, Perun2Process& p2);
    p_bool makeVarRefAsFunction(const Token& tk, p_genptr<p_per>& result, Perun2Process& p2);
    p_bool makeVarRefAsFunction(const Token& tk, p_genptr<p_tim>& result, Perun2Process& p2);
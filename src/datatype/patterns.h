@@ -23,7 +23,7 @@
       this->perun2.state = State::s_Running; \
       continue; \
    } \
-   else if (this->perun2.state == State::s_Exit) { \
+   else if (this->perun2.isNotRunning()) { \
       return; \
    }
 
@@ -37,7 +37,7 @@
       this->perun2.state = State::s_Running; \
       continue; \
    } \
-   else if (this->perun2.state == State::s_Exit) { \
+   else if (this->perun2.isNotRunning()) { \
       return; \
    }
 
@@ -51,6 +51,11 @@
       case State::s_Exit: { \
          return; \
       } \
+      default: { \
+         if (this->perun2.cancellation.isCancelled()) { \
+            return; \
+         } \
+      } \
    }
 
 
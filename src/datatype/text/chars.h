@@ -68,6 +68,7 @@ p_constexpr p_char CHAR_TILDE =                  L'~';
 
 p_constexpr p_char CHAR_NULL =                   L'\0';
 p_constexpr p_char CHAR_NULL_2 =                 L'\1';
+p_constexpr p_char CHAR_ASCII_LAST =             L'\x7F';
 
 p_constexpr p_char CHAR_b =                      L'b';
 p_constexpr p_char CHAR_B =                      L'B';
@@ -13,6 +13,7 @@
 */
 
 #include "strings.h"
+#include <cwchar>
 
 namespace perun2
 {
@@ -65,6 +66,53 @@ void str_toUpper(p_str& value)
    }
 }
 
+p_str str_toJson(const p_str& value)
+{
+   p_str result;
+   result.reserve(value.size() + 2);
+   result += CHAR_QUOTATION_MARK;
+   str_appendJsonEscaped(result, value);
+   result += CHAR_QUOTATION_MARK;
+   return result;
+}
+
+void str_appendJsonEscaped(p_str& result, const p_str& value)
+{
+   for (const p_char ch : value) {
+      switch (ch) {
+         case CHAR_QUOTATION_MARK:
+         case CHAR_BACKSLASH: {
+            result += CHAR_BACKSLASH;
+            result += ch;
+            break;
+         }
+         case L'\n': {
+            result += L"\\n";
+            break;
+         }
+         case L'\r': {
+            result += L"\\r";
+            break;
+         }
+         case L'\t': {
+            result += L"\\t";
+            break;
+         }
+         default: {
+            if (ch < 0x20) {
+               p_char hex[7];
+               std::swprintf(hex, 7, L"\\u%04x", static_cast<unsigned int>(ch));
+               result += hex;
+            }
+            else {
+               result += ch;
+            }
+            break;
+         }
+      }
+   }
+}
+
 const p_list STRINGS_MONTHS = 
 {
    STRING_JANUARY, STRING_FEBRUARY, STRING_MARCH,
@@ -100,7 +148,8 @@ const p_list STRINGS_ATTR =
    STRING_HIDDEN, STRING_ISDIRECTORY, STRING_ISFILE, STRING_LIFETIME,
    STRING_MODIFICATION, STRING_NAME, STRING_PARENT, STRING_PATH,
    STRING_READONLY, STRING_SIZE, 
-   STRING_WIDTH, STRING_HEIGHT, STRING_DURATION, STRING_ISIMAGE, STRING_ISVIDEO
+   STRING_WIDTH, STRING_HEIGHT, STRING_DURATION, STRING_ISIMAGE, STRING_ISVIDEO,
+   STRING_HASH, STRING_CRC32
 };
 
 const p_list STRINGS_TIME_ATTR = 
@@ -120,7 +169,8 @@ const p_list STRINGS_ALTERABLE_ATTR =
    STRING_CREATION, STRING_EMPTY, STRING_EXISTS, STRING_ENCRYPTED,
    STRING_HIDDEN, STRING_ISDIRECTORY, STRING_ISFILE, STRING_LIFETIME,
    STRING_MODIFICATION, STRING_READONLY, STRING_SIZE, 
-   STRING_ISIMAGE, STRING_ISVIDEO, STRING_WIDTH, STRING_HEIGHT, STRING_DURATION
+   STRING_ISIMAGE, STRING_ISVIDEO, STRING_WIDTH, STRING_HEIGHT, STRING_DURATION,
+   STRING_HASH, STRING_CRC32
 };
 
 const p_list STRINGS_VARS_IMMUTABLES = 
@@ -141,7 +191,10 @@ const p_list STRINGS_VARS_IMMUTABLES =
    STRING_PERUN2, STRING_ORIGIN, STRING_DIRECTORIES,
    STRING_FILES, STRING_RECURSIVEFILES, STRING_RECURSIVEDIRECTORIES,
    STRING_WIDTH, STRING_HEIGHT, STRING_DURATION, STRING_ISIMAGE, STRING_ISVIDEO,
-   STRING_VIDEOS, STRING_RECURSIVEVIDEOS, STRING_IMAGES, STRING_RECURSIVEIMAGES
+   STRING_VIDEOS, STRING_RECURSIVEVIDEOS, STRING_IMAGES, STRING_RECURSIVEIMAGES,
+   STRING_HASH, STRING_CRC32, STRING_DUPLICATES,
+   STRING_DIRECTORYOPENS, STRING_ENTRYREADS, STRING_ATTRIBUTEQUERIES,
+   STRING_FILEOPENS, STRING_BYTESREAD, STRING_BYTESWRITTEN
 };
 
 const p_list STRINGS_FUNC_BOO_STR = 
@@ -38,13 +38,20 @@ p_ndouble stringToDouble(const p_str& value);
 void str_toLower(p_str& value);
 void str_toUpper(p_str& value);
 
+// the value as a JSON string literal, quotation marks included
+p_str str_toJson(const p_str& value);
+
+// the same, but appended to the result, without quotation marks and without new memory for every value
+void str_appendJsonEscaped(p_str& result, const p_str& value);
+
+p_constexpr p_char STRING_JSON_NULL[] =            L"null";
+
 p_constexpr p_int LETTERS_IN_ENGLISH_ALPHABET = 26;
 
 p_constexpr p_char ROMAN_VINCULUM_THOUSAND[] =     L"I" L"̅";
 extern const p_list ROMAN_STRING_LITERALS;
 extern const p_list STRINGS_ASCII;
 
-p_constexpr p_char STRING_FILE_OPEN_MODE[] =       L"rtS, ccs=UTF-8";
 p_constexpr p_char STRING_WINDOWS_PATH_PREFIX[] =  L"\\\\?\\";
 p_constexpr p_char STRING_POPUP_TITLE[] =          L"Perun2";
 p_constexpr p_char STRING_GOOD[] =                 L"good";
@@ -54,11 +61,22 @@ p_constexpr p_char STRING_NO_PERIOD[] =            L"no period";
 p_constexpr p_char STRING_NOTHING[] =              L"nothing";
 p_constexpr p_char STRING_NEVER[] =                L"never";
 p_constexpr p_char STRING_DOWNLOADS[] =            L"downloads";
+p_constexpr p_char STRING_CACHE[] =                L"cache";
+p_constexpr p_char STRING_DAEMON_PIPE[] =          L"\\\\.\\pipe\\perun2";
 
 p_constexpr p_char STRING_ARG_VERSION[] =          L"--version";
 p_constexpr p_char STRING_ARG_DOCS[] =             L"--docs";
 p_constexpr p_char STRING_ARG_WEBSITE[] =          L"--website";
 p_constexpr p_char STRING_ARG_HELP[] =             L"--help";
+p_constexpr p_char STRING_ARG_DAEMON[] =           L"--daemon";
+p_constexpr p_char STRING_ARG_PROFILE[] =          L"--profile";
+p_constexpr p_char STRING_ARG_PROFILE_JSON[] =     L"--profile=json";
+p_constexpr p_char STRING_ARG_PROFILE_TRACE[] =    L"--profile=trace";
+p_constexpr p_char STRING_ARG_STATS[] =            L"--stats";
+p_constexpr p_char STRING_ARG_OUTPUT_TEXT[] =      L"--output=text";
+p_constexpr p_char STRING_ARG_OUTPUT_JSON[] =      L"--output=json";
+p_constexpr p_char STRING_ARG_JOBS[] =             L"--jobs=";
+p_constexpr p_char STRING_ARG_WATCH[] =            L"--watch";
 
 p_constexpr p_char STRING_ICON_SUFFIX[] =          L".ico";
 p_constexpr p_size STRING_ICON_SUFFIX_LEN =        _countof(STRING_ICON_SUFFIX) - 1;
@@ -103,6 +121,7 @@ p_constexpr p_char STRING_ACCESS[] =               L"access";
 p_constexpr p_char STRING_ARCHIVE[] =              L"archive";
 p_constexpr p_char STRING_CHANGE[] =               L"change";
 p_constexpr p_char STRING_COMPRESSED[] =           L"compressed";
+p_constexpr p_char STRING_CRC32[] =                L"crc32";
 p_constexpr p_char STRING_CREATION[] =             L"creation";
 p_constexpr p_char STRING_DEPTH[] =                L"depth";
 p_constexpr p_char STRING_DRIVE[] =                L"drive";
@@ -112,6 +131,7 @@ p_constexpr p_char STRING_ENCRYPTED[] =            L"encrypted";
 p_constexpr p_char STRING_EXISTS[] =               L"exists";
 p_constexpr p_char STRING_EXTENSION[] =            L"extension";
 p_constexpr p_char STRING_FULLNAME[] =             L"fullname";
+p_constexpr p_char STRING_HASH[] =                 L"hash";
 p_constexpr p_char STRING_HEIGHT[] =               L"height";
 p_constexpr p_char STRING_HIDDEN[] =               L"hidden";
 p_constexpr p_char STRING_INDEX[] =                L"index";
@@ -167,6 +187,13 @@ p_constexpr p_char STRING_RECURSIVEDIRECTORIES[] = L"recursivedirectories";
 p_constexpr p_char STRING_RECURSIVEFILES[] =       L"recursivefiles";
 p_constexpr p_char STRING_RECURSIVEIMAGES[] =      L"recursiveimages";
 p_constexpr p_char STRING_RECURSIVEVIDEOS[] =      L"recursivevideos";
+p_constexpr p_char STRING_DUPLICATES[] =           L"duplicates";
+p_constexpr p_char STRING_DIRECTORYOPENS[] =       L"directoryopens";
+p_constexpr p_char STRING_ENTRYREADS[] =           L"entryreads";
+p_constexpr p_char STRING_ATTRIBUTEQUERIES[] =     L"attributequeries";
+p_constexpr p_char STRING_FILEOPENS[] =            L"fileopens";
+p_constexpr p_char STRING_BYTESREAD[] =            L"bytesread";
+p_constexpr p_char STRING_BYTESWRITTEN[] =         L"byteswritten";
 p_constexpr p_char STRING_YEAR[] =                 L"year";
 p_constexpr p_char STRING_MONTH[] =                L"month";
 p_constexpr p_char STRING_WEEK[] =                 L"week";
@@ -201,6 +228,9 @@ p_constexpr p_char STRING_EXISTINSIDE[] =          L"existinside";
 p_constexpr p_char STRING_STARTSWITH[] =           L"startswith";
 p_constexpr p_char STRING_ENDSWITH[] =             L"endswith";
 p_constexpr p_char STRING_FINDTEXT[] =             L"findtext";
+p_constexpr p_char STRING_FINDANYTEXT[] =          L"findanytext";
+p_constexpr p_char STRING_COUNTTEXT[] =            L"counttext";
+p_constexpr p_char STRING_SAMECONTENT[] =          L"samecontent";
 p_constexpr p_char STRING_ABSOLUTE[] =             L"absolute";
 p_constexpr p_char STRING_CEIL[] =                 L"ceil";
 p_constexpr p_char STRING_FLOOR[] =                L"floor";
@@ -0,0 +1,275 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "text-decode.h"
+#include <algorithm>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+
+namespace perun2
+{
+
+p_constexpr p_char REPLACEMENT_CHARACTER = static_cast<p_char>(0xFFFD);
+
+// a part is never smaller than this, so every part contains at least one character
+p_constexpr p_size TEXT_DECODER_MIN_PART = 4;
+
+
+static inline p_bool isContinuation(const unsigned char byte)
+{
+   return (byte & 0xC0) == 0x80;
+}
+
+// characters above 16 bits become surrogate pairs, if wide characters have only 16 bits
+static inline p_char* putCodePoint(p_char* out, const uint32_t code)
+{
+   if (sizeof(p_char) == 2 && code >= 0x10000) {
+      const uint32_t value = code - 0x10000;
+      *out++ = static_cast<p_char>(0xD800 + (value >> 10));
+      *out++ = static_cast<p_char>(0xDC00 + (value & 0x3FF));
+   }
+   else {
+      *out++ = static_cast<p_char>(code);
+   }
+
+   return out;
+}
+
+#ifdef __SSE2__
+
+// 16 ASCII bytes become 16 wide characters
+static inline void widenAscii(const __m128i block, p_char* out)
+{
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i low = _mm_unpacklo_epi8(block, zero);
+   const __m128i high = _mm_unpackhi_epi8(block, zero);
+
+   if (sizeof(p_char) == 2) {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out), low);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), high);
+   }
+   else {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi16(low, zero));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), _mm_unpackhi_epi16(low, zero));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_unpacklo_epi16(high, zero));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 12), _mm_unpackhi_epi16(high, zero));
+   }
+}
+
+#endif
+
+
+TextDecoder::TextDecoder(const char* data, const p_size size)
+   : data(reinterpret_cast<const unsigned char*>(data)), size(size), position(0)
+{
+   this->encoding = detectEncoding(data, size, this->position);
+};
+
+p_bool TextDecoder::next(p_str& result, const p_size limit)
+{
+   result.clear();
+
+   if (this->position >= this->size) {
+      return false;
+   }
+
+   p_size end = this->size;
+
+   if (limit < this->size - this->position) {
+      end = std::min(this->size, this->position + std::max(limit, TEXT_DECODER_MIN_PART));
+   }
+
+   switch (this->encoding) {
+      case TextEncoding::te_Utf16LE:
+      case TextEncoding::te_Utf16BE: {
+         const p_bool bigEndian = this->encoding == TextEncoding::te_Utf16BE;
+         end -= (end - this->position) % 2;
+
+         // do not separate two halves of a surrogate pair
+         if (end < this->size && end >= this->position + 2) {
+            const unsigned char* last = this->data + end - 2;
+            const uint32_t unit = bigEndian
+               ? (static_cast<uint32_t>(last[0]) << 8) | last[1]
+               : last[0] | (static_cast<uint32_t>(last[1]) << 8);
+
+            if (unit >= 0xD800 && unit <= 0xDBFF) {
+               end = std::min(this->size, end + 2);
+            }
+         }
+
+         this->decodeUtf16(end, bigEndian, result);
+         break;
+      }
+      default: {
+         // binary files are decoded as UTF-8 too
+         while (end < this->size && isContinuation(this->data[end])) {
+            end++;
+         }
+
+         this->decodeUtf8(end, result);
+         break;
+      }
+   }
+
+   return true;
+}
+
+void TextDecoder::rest(p_str& result)
+{
+   this->next(result, this->size);
+}
+
+void TextDecoder::decodeUtf8(const p_size end, p_str& result)
+{
+   // every byte gives at most one wide character
+   result.resize(end - this->position);
+   p_char* const begin = &result[0];
+   p_char* out = begin;
+   p_size i = this->position;
+
+   while (i < end) {
+
+#ifdef __SSE2__
+      // ASCII text other than CR is copied 16 bytes at once
+      if (i + 16 <= end) {
+         const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(this->data + i));
+         const unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(block)
+            | _mm_movemask_epi8(_mm_cmpeq_epi8(block, _mm_set1_epi8('\r'))));
+
+         if (mask == 0) {
+            widenAscii(block, out);
+            out += 16;
+            i += 16;
+            continue;
+         }
+
+         const p_size ascii = static_cast<p_size>(__builtin_ctz(mask));
+
+         for (p_size k = 0; k < ascii; k++) {
+            *out++ = static_cast<p_char>(this->data[i + k]);
+         }
+
+         i += ascii;
+      }
+#endif
+
+      const unsigned char first = this->data[i];
+
+      if (first < 0x80) {
+         // the next byte may belong to the next part, but it is already in the memory
+         if (first != '\r' || i + 1 >= this->size || this->data[i + 1] != '\n') {
+            *out++ = static_cast<p_char>(first);
+         }
+
+         i++;
+         continue;
+      }
+
+      p_size length;
+      uint32_t code;
+
+      if (first >= 0xC2 && first <= 0xDF) {
+         length = 2;
+         code = first & 0x1F;
+      }
+      else if (first >= 0xE0 && first <= 0xEF) {
+         length = 3;
+         code = first & 0x0F;
+      }
+      else if (first >= 0xF0 && first <= 0xF4) {
+         length = 4;
+         code = first & 0x07;
+      }
+      else {
+         *out++ = REPLACEMENT_CHARACTER;
+         i++;
+         continue;
+      }
+
+      p_bool valid = i + length <= end;
+
+      for (p_size k = 1; valid && k < length; k++) {
+         const unsigned char byte = this->data[i + k];
+
+         if (isContinuation(byte)) {
+            code = (code << 6) | (byte & 0x3F);
+         }
+         else {
+            valid = false;
+         }
+      }
+
+      // overlong forms, surrogates and values beyond Unicode
+      if (valid && ((length == 3 && (code < 0x800 || (code >= 0xD800 && code <= 0xDFFF)))
+         || (length == 4 && (code < 0x10000 || code > 0x10FFFF))))
+      {
+         valid = false;
+      }
+
+      if (valid) {
+         out = putCodePoint(out, code);
+         i += length;
+      }
+      else {
+         *out++ = REPLACEMENT_CHARACTER;
+         i++;
+      }
+   }
+
+   result.resize(static_cast<p_size>(out - begin));
+   this->position = end;
+}
+
+void TextDecoder::decodeUtf16(const p_size end, const p_bool bigEndian, p_str& result)
+{
+   const auto unitAt = [this, bigEndian](const p_size index) -> uint32_t {
+      const unsigned char* bytes = this->data + index;
+      return bigEndian
+         ? (static_cast<uint32_t>(bytes[0]) << 8) | bytes[1]
+         : bytes[0] | (static_cast<uint32_t>(bytes[1]) << 8);
+   };
+
+   result.resize((end - this->position) / 2);
+   p_char* const begin = result.empty() ? nullptr : &result[0];
+   p_char* out = begin;
+
+   for (p_size i = this->position; i + 2 <= end; i += 2) {
+      const uint32_t unit = unitAt(i);
+
+      if (unit == '\r' && i + 4 <= this->size && unitAt(i + 2) == '\n') {
+         continue;
+      }
+
+      // wide characters of 32 bits hold entire code points
+      if (sizeof(p_char) == 4 && unit >= 0xD800 && unit <= 0xDBFF && i + 4 <= end) {
+         const uint32_t low = unitAt(i + 2);
+
+         if (low >= 0xDC00 && low <= 0xDFFF) {
+            *out++ = static_cast<p_char>(0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00));
+            i += 2;
+            continue;
+         }
+      }
+
+      *out++ = static_cast<p_char>(unit);
+   }
+
+   result.resize(static_cast<p_size>(out - begin));
+   this->position = end;
+}
+
+}
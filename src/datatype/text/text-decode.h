@@ -0,0 +1,51 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "text-search.h"
+
+
+namespace perun2
+{
+
+// conversion of raw bytes of a text file into wide characters
+// the encoding comes from the byte order mark, UTF-8 is the default
+// line endings CR LF become LF, as if the file was read in text mode
+// invalid UTF-8 sequences become the replacement character
+struct TextDecoder
+{
+public:
+   TextDecoder() = delete;
+   TextDecoder(const char* data, const p_size size);
+
+   // decode the next part of about 'limit' bytes
+   // a character is never split between two parts
+   // return false, if there is nothing more to decode
+   p_bool next(p_str& result, const p_size limit);
+
+   // decode everything that is left at once
+   void rest(p_str& result);
+
+private:
+   void decodeUtf8(const p_size end, p_str& result);
+   void decodeUtf16(const p_size end, const p_bool bigEndian, p_str& result);
+
+   const unsigned char* const data;
+   const p_size size;
+   p_size position;
+   TextEncoding encoding;
+};
+
+}
@@ -0,0 +1,406 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "text-search.h"
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+
+namespace perun2
+{
+
+TextEncoding detectEncoding(const char* data, const p_size size, p_size& offset)
+{
+   const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+
+   if (size >= 3 && bytes[0] == 0xEF && bytes[1] == 0xBB && bytes[2] == 0xBF) {
+      offset = 3;
+      return TextEncoding::te_Utf8;
+   }
+
+   if (size >= 2) {
+      if (bytes[0] == 0xFF && bytes[1] == 0xFE) {
+         offset = 2;
+         return TextEncoding::te_Utf16LE;
+      }
+      if (bytes[0] == 0xFE && bytes[1] == 0xFF) {
+         offset = 2;
+         return TextEncoding::te_Utf16BE;
+      }
+   }
+
+   offset = 0;
+
+   if (size == 0) {
+      return TextEncoding::te_Utf8;
+   }
+
+   return std::memchr(data, 0, std::min(size, TEXT_BINARY_PROBE)) == nullptr
+      ? TextEncoding::te_Utf8
+      : TextEncoding::te_Binary;
+}
+
+p_size findBytes(const char* data, const p_size size, const std::string& needle, const p_size from)
+{
+   const p_size length = needle.size();
+
+   if (length == 0) {
+      return from <= size ? from : std::string::npos;
+   }
+
+   if (length > size || from > size - length) {
+      return std::string::npos;
+   }
+
+   // last position, where the needle could start
+   const p_size last = size - length;
+   const char* rest = needle.data() + 1;
+   const p_size restLength = length - 1;
+   p_size index = from;
+
+#ifdef __SSE2__
+   // compare 16 positions at once
+   // only where both the first and the last byte of the needle match, the rest is compared
+   const __m128i firstByte = _mm_set1_epi8(needle[0]);
+   const __m128i lastByte = _mm_set1_epi8(needle[length - 1]);
+
+   while (index + 16 <= last + 1) {
+      const __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index));
+      const __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index + length - 1));
+      unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(
+         _mm_and_si128(_mm_cmpeq_epi8(blockFirst, firstByte), _mm_cmpeq_epi8(blockLast, lastByte))));
+
+      while (mask != 0) {
+         const p_size position = index + static_cast<p_size>(__builtin_ctz(mask));
+
+         if (std::memcmp(data + position + 1, rest, restLength) == 0) {
+            return position;
+         }
+
+         mask &= mask - 1;
+      }
+
+      index += 16;
+   }
+#endif
+
+   while (index <= last) {
+      const void* found = std::memchr(data + index, needle[0], last - index + 1);
+
+      if (found == nullptr) {
+         return std::string::npos;
+      }
+
+      const p_size position = static_cast<p_size>(static_cast<const char*>(found) - data);
+
+      if (std::memcmp(data + position + 1, rest, restLength) == 0) {
+         return position;
+      }
+
+      index = position + 1;
+   }
+
+   return std::string::npos;
+}
+
+p_size findAlignedBytes(const char* data, const p_size size, const std::string& needle,
+   const p_size offset, const p_size charSize)
+{
+   p_size position = findBytes(data, size, needle, offset);
+
+   while (position != std::string::npos && (position - offset) % charSize != 0) {
+      position = findBytes(data, size, needle, position + 1);
+   }
+
+   return position;
+}
+
+std::string encodeText(const p_str& value, const TextEncoding encoding)
+{
+   std::string result;
+
+   switch (encoding) {
+      case TextEncoding::te_Utf16LE: {
+         result.reserve(value.size() * 2);
+         for (const p_char ch : value) {
+            result.push_back(static_cast<char>(ch & 0xFF));
+            result.push_back(static_cast<char>((ch >> 8) & 0xFF));
+         }
+         break;
+      }
+      case TextEncoding::te_Utf16BE: {
+         result.reserve(value.size() * 2);
+         for (const p_char ch : value) {
+            result.push_back(static_cast<char>((ch >> 8) & 0xFF));
+            result.push_back(static_cast<char>(ch & 0xFF));
+         }
+         break;
+      }
+      case TextEncoding::te_Utf8: {
+         result.reserve(value.size());
+         const p_size length = value.size();
+
+         for (p_size i = 0; i < length; i++) {
+            uint32_t code = static_cast<uint32_t>(value[i]);
+
+            // surrogate pair of UTF-16
+            if (code >= 0xD800 && code <= 0xDBFF && i + 1 < length) {
+               const uint32_t next = static_cast<uint32_t>(value[i + 1]);
+               if (next >= 0xDC00 && next <= 0xDFFF) {
+                  code = 0x10000 + ((code - 0xD800) << 10) + (next - 0xDC00);
+                  i++;
+               }
+            }
+
+            if (code < 0x80) {
+               result.push_back(static_cast<char>(code));
+            }
+            else if (code < 0x800) {
+               result.push_back(static_cast<char>(0xC0 | (code >> 6)));
+               result.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+            }
+            else if (code < 0x10000) {
+               result.push_back(static_cast<char>(0xE0 | (code >> 12)));
+               result.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+               result.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+            }
+            else {
+               result.push_back(static_cast<char>(0xF0 | (code >> 18)));
+               result.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+               result.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+               result.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+            }
+         }
+         break;
+      }
+   }
+
+   return result;
+}
+
+
+TextSearch::TextSearch(const p_str& needle)
+   : empty(needle.empty()),
+     utf8(encodeText(needle, TextEncoding::te_Utf8)),
+     utf16le(encodeText(needle, TextEncoding::te_Utf16LE)),
+     utf16be(encodeText(needle, TextEncoding::te_Utf16BE)) { };
+
+p_bool TextSearch::isFoundIn(const char* data, const p_size size) const
+{
+   if (this->empty) {
+      return true;
+   }
+
+   p_size offset;
+
+   switch (detectEncoding(data, size, offset)) {
+      case TextEncoding::te_Utf8: {
+         return findBytes(data, size, this->utf8, offset) != std::string::npos;
+      }
+      case TextEncoding::te_Utf16LE: {
+         return findAlignedBytes(data, size, this->utf16le, offset, 2) != std::string::npos;
+      }
+      case TextEncoding::te_Utf16BE: {
+         return findAlignedBytes(data, size, this->utf16be, offset, 2) != std::string::npos;
+      }
+      default: {
+         return false;
+      }
+   }
+}
+
+
+
+// transitions of a state occupy this many cells, one for every byte value
+p_constexpr p_size AHO_CORASICK_ALPHABET = 256;
+
+AhoCorasick::AhoCorasick(const std::vector<std::string>& needles, const p_size charSize)
+   : transitions(AHO_CORASICK_ALPHABET, 0), matches(1, 0), charSize(charSize)
+{
+   // at first, build a trie of needles
+   // state 0 is the root
+   for (const std::string& needle : needles) {
+      uint32_t state = 0;
+
+      for (const char ch : needle) {
+         const p_size cell = state * AHO_CORASICK_ALPHABET + static_cast<unsigned char>(ch);
+
+         if (this->transitions[cell] == 0) {
+            const uint32_t created = static_cast<uint32_t>(this->matches.size());
+            this->transitions[cell] = created;
+            this->transitions.resize(this->transitions.size() + AHO_CORASICK_ALPHABET, 0);
+            this->matches.push_back(0);
+         }
+
+         state = this->transitions[state * AHO_CORASICK_ALPHABET + static_cast<unsigned char>(ch)];
+      }
+
+      this->matches[state]++;
+   }
+
+   // then, go breadth-first and replace missing transitions with transitions of the failure state
+   // a state is always visited after its failure state, as that one is closer to the root
+   std::vector<uint32_t> failures(this->matches.size(), 0);
+   std::vector<uint32_t> queue;
+   queue.reserve(this->matches.size());
+
+   for (p_size b = 0; b < AHO_CORASICK_ALPHABET; b++) {
+      const uint32_t child = this->transitions[b];
+      if (child != 0) {
+         queue.push_back(child);
+      }
+   }
+
+   for (p_size i = 0; i < queue.size(); i++) {
+      const uint32_t state = queue[i];
+      const uint32_t failure = failures[state];
+      this->matches[state] += this->matches[failure];
+
+      for (p_size b = 0; b < AHO_CORASICK_ALPHABET; b++) {
+         uint32_t& cell = this->transitions[state * AHO_CORASICK_ALPHABET + b];
+         const uint32_t fallback = this->transitions[failure * AHO_CORASICK_ALPHABET + b];
+
+         if (cell == 0) {
+            cell = fallback;
+         }
+         else {
+            failures[cell] = fallback;
+            queue.push_back(cell);
+         }
+      }
+   }
+}
+
+p_bool AhoCorasick::isAnyFoundIn(const char* data, const p_size size, const p_size offset) const
+{
+   uint32_t state = 0;
+
+   for (p_size i = offset; i < size; i++) {
+      state = this->transitions[state * AHO_CORASICK_ALPHABET + static_cast<unsigned char>(data[i])];
+
+      // all needles have length that is a multiple of the character size
+      // so only the end of a match has to be aligned
+      if (this->matches[state] != 0 && (i + 1 - offset) % this->charSize == 0) {
+         return true;
+      }
+   }
+
+   return false;
+}
+
+p_nint AhoCorasick::countIn(const char* data, const p_size size, const p_size offset) const
+{
+   uint32_t state = 0;
+   p_nint result = 0;
+
+   for (p_size i = offset; i < size; i++) {
+      state = this->transitions[state * AHO_CORASICK_ALPHABET + static_cast<unsigned char>(data[i])];
+
+      if (this->matches[state] != 0 && (i + 1 - offset) % this->charSize == 0) {
+         result += static_cast<p_nint>(this->matches[state]);
+      }
+   }
+
+   return result;
+}
+
+
+MultiTextSearch::MultiTextSearch(const p_list& values)
+{
+   std::unordered_set<p_str> unique;
+
+   for (const p_str& value : values) {
+      if (value.empty()) {
+         this->anyEmpty = true;
+      }
+      else if (unique.insert(value).second) {
+         this->needles.push_back(value);
+      }
+   }
+}
+
+const AhoCorasick* MultiTextSearch::getAutomaton(const TextEncoding encoding)
+{
+   std::unique_ptr<AhoCorasick>* automaton;
+
+   switch (encoding) {
+      case TextEncoding::te_Utf8: {
+         automaton = &this->utf8;
+         break;
+      }
+      case TextEncoding::te_Utf16LE: {
+         automaton = &this->utf16le;
+         break;
+      }
+      case TextEncoding::te_Utf16BE: {
+         automaton = &this->utf16be;
+         break;
+      }
+      default: {
+         return nullptr;
+      }
+   }
+
+   if (! *automaton) {
+      std::vector<std::string> encoded;
+      encoded.reserve(this->needles.size());
+
+      for (const p_str& needle : this->needles) {
+         encoded.push_back(encodeText(needle, encoding));
+      }
+
+      *automaton = std::make_unique<AhoCorasick>(encoded,
+         encoding == TextEncoding::te_Utf8 ? 1 : 2);
+   }
+
+   return automaton->get();
+}
+
+p_bool MultiTextSearch::isAnyFoundIn(const char* data, const p_size size)
+{
+   if (this->anyEmpty) {
+      return true;
+   }
+
+   if (this->needles.empty()) {
+      return false;
+   }
+
+   p_size offset;
+   const AhoCorasick* automaton = this->getAutomaton(detectEncoding(data, size, offset));
+
+   return automaton != nullptr
+      && automaton->isAnyFoundIn(data, size, offset);
+}
+
+p_nint MultiTextSearch::countIn(const char* data, const p_size size)
+{
+   if (this->needles.empty()) {
+      return 0;
+   }
+
+   p_size offset;
+   const AhoCorasick* automaton = this->getAutomaton(detectEncoding(data, size, offset));
+
+   return automaton == nullptr
+      ? 0
+      : automaton->countIn(data, size, offset);
+}
+
+}
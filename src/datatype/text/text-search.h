@@ -0,0 +1,114 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "../primitives.h"
+#include <memory>
+#include <string>
+
+
+namespace perun2
+{
+
+// encoding of a text file is recognized by its byte order mark
+// a file with no mark is UTF-8, unless there is a null byte near its beginning
+enum TextEncoding
+{
+   te_Utf8 = 0,
+   te_Utf16LE,
+   te_Utf16BE,
+   te_Binary
+};
+
+// only this many bytes at the beginning of a file are checked for null bytes
+p_constexpr p_size TEXT_BINARY_PROBE = 8000;
+
+// the offset is set to the first byte after the byte order mark
+TextEncoding detectEncoding(const char* data, const p_size size, p_size& offset);
+
+// position of the first occurrence of the needle at or after the position 'from'
+// or std::string::npos, if there is none
+p_size findBytes(const char* data, const p_size size, const std::string& needle, const p_size from);
+
+// the same, but the position has to be a multiple of the character size counted from the offset
+p_size findAlignedBytes(const char* data, const p_size size, const std::string& needle,
+   const p_size offset, const p_size charSize);
+
+// bytes of the text in certain encoding
+std::string encodeText(const p_str& value, const TextEncoding encoding);
+
+
+// search for a text in raw bytes of a file, without decoding them
+// the needle is encoded only once for every encoding a file may have
+struct TextSearch
+{
+public:
+   TextSearch() = delete;
+   TextSearch(const p_str& needle);
+
+   p_bool isFoundIn(const char* data, const p_size size) const;
+
+private:
+   const p_bool empty;
+   const std::string utf8;
+   const std::string utf16le;
+   const std::string utf16be;
+};
+
+
+// Aho-Corasick automaton, that finds many byte sequences during one pass over the data
+// transitions of all states are computed in advance, so every byte costs one lookup
+struct AhoCorasick
+{
+public:
+   AhoCorasick() = delete;
+   // needles should be unique and not empty
+   // charSize 2 means that only matches at positions aligned to UTF-16 characters count
+   AhoCorasick(const std::vector<std::string>& needles, const p_size charSize);
+
+   p_bool isAnyFoundIn(const char* data, const p_size size, const p_size offset) const;
+   // every occurrence of every needle, overlapping ones too
+   p_nint countIn(const char* data, const p_size size, const p_size offset) const;
+
+private:
+   std::vector<uint32_t> transitions;
+   // how many needles end in this state
+   std::vector<uint32_t> matches;
+   const p_size charSize;
+};
+
+
+// search for many texts at once
+// automatons for UTF-16 files are built only when such a file appears
+struct MultiTextSearch
+{
+public:
+   MultiTextSearch() = delete;
+   MultiTextSearch(const p_list& needles);
+
+   p_bool isAnyFoundIn(const char* data, const p_size size);
+   p_nint countIn(const char* data, const p_size size);
+
+private:
+   const AhoCorasick* getAutomaton(const TextEncoding encoding);
+
+   p_list needles;
+   p_bool anyEmpty = false;
+   std::unique_ptr<AhoCorasick> utf8;
+   std::unique_ptr<AhoCorasick> utf16le;
+   std::unique_ptr<AhoCorasick> utf16be;
+};
+
+}
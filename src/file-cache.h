@@ -0,0 +1,75 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "datatype/primitives.h"
+#include <mutex>
+#include <unordered_map>
+
+
+namespace perun2
+{
+
+// the cache forgets everything, when it grows above this number of files
+p_constexpr p_size FILE_CACHE_LIMIT = 65536;
+
+
+// values computed from the content of files
+// an entry is valid as long as its file has the same size and modification time
+// the daemon shares one cache between scripts running on many threads, so every access is synchronized
+template <typename T>
+struct FileCache
+{
+public:
+   p_bool get(const p_str& path, const p_nint size, const uint64_t modification, T& result) const
+   {
+      const std::lock_guard<std::mutex> lock(this->mutex);
+      const auto found = this->entries.find(path);
+
+      if (found == this->entries.end()
+         || found->second.size != size
+         || found->second.modification != modification)
+      {
+         return false;
+      }
+
+      result = found->second.value;
+      return true;
+   }
+
+   void put(const p_str& path, const p_nint size, const uint64_t modification, const T& value)
+   {
+      const std::lock_guard<std::mutex> lock(this->mutex);
+
+      if (this->entries.size() >= FILE_CACHE_LIMIT) {
+         this->entries.clear();
+      }
+
+      this->entries[path] = { size, modification, value };
+   }
+
+protected:
+   struct Entry
+   {
+      p_nint size;
+      uint64_t modification;
+      T value;
+   };
+
+   std::unordered_map<p_str, Entry> entries;
+   mutable std::mutex mutex;
+};
+
+}
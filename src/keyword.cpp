@@ -14,112 +14,239 @@
 
 #include "keyword.h"
 #include "datatype/text/strings.h"
-#include "perun2.h"
+#include "datatype/time-const.h"
+#include <cwchar>
 
 
 namespace perun2
 {
 
-KeywordsData::KeywordsData() : KEYWORDS( 
+#define P_RESERVED_WORD(text, type, value) { text, _countof(text) - 1, ReservedWordType::type, value }
+
+p_constexpr ReservedWord RESERVED_WORDS[] =
 {
    // core commands:
-   { STRING_COPY, Keyword::kw_Copy },
-   { STRING_CREATE, Keyword::kw_Create },
-   { STRING_CREATEFILE, Keyword::kw_CreateFile },
-   { STRING_CREATEDIRECTORY, Keyword::kw_CreateDirectory },
-   { STRING_CREATEFILES, Keyword::kw_CreateFiles },
-   { STRING_CREATEDIRECTORIES, Keyword::kw_CreateDirectories },
-   { STRING_DELETE, Keyword::kw_Delete },
-   { STRING_DROP, Keyword::kw_Drop },
-   { STRING_HIDE, Keyword::kw_Hide },
-   { STRING_LOCK, Keyword::kw_Lock },
-   { STRING_MOVE, Keyword::kw_Move },
-   { STRING_OPEN, Keyword::kw_Open },
-   { STRING_REACCESS, Keyword::kw_Reaccess },
-   { STRING_RECREATE, Keyword::kw_Recreate },
-   { STRING_RECHANGE, Keyword::kw_Rechange },
-   { STRING_REMODIFY, Keyword::kw_Remodify },
-   { STRING_RENAME, Keyword::kw_Rename },
-   { STRING_SELECT, Keyword::kw_Select },
-   { STRING_UNHIDE, Keyword::kw_Unhide },
-   { STRING_UNLOCK, Keyword::kw_Unlock },
+   P_RESERVED_WORD(STRING_COPY, rw_Keyword, Keyword::kw_Copy),
+   P_RESERVED_WORD(STRING_CREATE, rw_Keyword, Keyword::kw_Create),
+   P_RESERVED_WORD(STRING_CREATEFILE, rw_Keyword, Keyword::kw_CreateFile),
+   P_RESERVED_WORD(STRING_CREATEDIRECTORY, rw_Keyword, Keyword::kw_CreateDirectory),
+   P_RESERVED_WORD(STRING_CREATEFILES, rw_Keyword, Keyword::kw_CreateFiles),
+   P_RESERVED_WORD(STRING_CREATEDIRECTORIES, rw_Keyword, Keyword::kw_CreateDirectories),
+   P_RESERVED_WORD(STRING_DELETE, rw_Keyword, Keyword::kw_Delete),
+   P_RESERVED_WORD(STRING_DROP, rw_Keyword, Keyword::kw_Drop),
+   P_RESERVED_WORD(STRING_HIDE, rw_Keyword, Keyword::kw_Hide),
+   P_RESERVED_WORD(STRING_LOCK, rw_Keyword, Keyword::kw_Lock),
+   P_RESERVED_WORD(STRING_MOVE, rw_Keyword, Keyword::kw_Move),
+   P_RESERVED_WORD(STRING_OPEN, rw_Keyword, Keyword::kw_Open),
+   P_RESERVED_WORD(STRING_REACCESS, rw_Keyword, Keyword::kw_Reaccess),
+   P_RESERVED_WORD(STRING_RECREATE, rw_Keyword, Keyword::kw_Recreate),
+   P_RESERVED_WORD(STRING_RECHANGE, rw_Keyword, Keyword::kw_Rechange),
+   P_RESERVED_WORD(STRING_REMODIFY, rw_Keyword, Keyword::kw_Remodify),
+   P_RESERVED_WORD(STRING_RENAME, rw_Keyword, Keyword::kw_Rename),
+   P_RESERVED_WORD(STRING_SELECT, rw_Keyword, Keyword::kw_Select),
+   P_RESERVED_WORD(STRING_UNHIDE, rw_Keyword, Keyword::kw_Unhide),
+   P_RESERVED_WORD(STRING_UNLOCK, rw_Keyword, Keyword::kw_Unlock),
    // core command flags:
-   { STRING_FORCE, Keyword::kw_Force },
-   { STRING_STACK, Keyword::kw_Stack },
+   P_RESERVED_WORD(STRING_FORCE, rw_Keyword, Keyword::kw_Force),
+   P_RESERVED_WORD(STRING_STACK, rw_Keyword, Keyword::kw_Stack),
    // logic:
-   { STRING_TRUE, Keyword::kw_True },
-   { STRING_FALSE, Keyword::kw_False },
-   { STRING_AND, Keyword::kw_And },
-   { STRING_OR, Keyword::kw_Or },
-   { STRING_XOR, Keyword::kw_Xor },
-   { STRING_NOT, Keyword::kw_Not },
+   P_RESERVED_WORD(STRING_TRUE, rw_Keyword, Keyword::kw_True),
+   P_RESERVED_WORD(STRING_FALSE, rw_Keyword, Keyword::kw_False),
+   P_RESERVED_WORD(STRING_AND, rw_Keyword, Keyword::kw_And),
+   P_RESERVED_WORD(STRING_OR, rw_Keyword, Keyword::kw_Or),
+   P_RESERVED_WORD(STRING_XOR, rw_Keyword, Keyword::kw_Xor),
+   P_RESERVED_WORD(STRING_NOT, rw_Keyword, Keyword::kw_Not),
    // other commands:
-   { STRING_PRINT, Keyword::kw_Print },
-   { STRING_RUN, Keyword::kw_Run },
-   { STRING_SLEEP, Keyword::kw_Sleep },
-   { STRING_POPUP, Keyword::kw_Popup },
+   P_RESERVED_WORD(STRING_PRINT, rw_Keyword, Keyword::kw_Print),
+   P_RESERVED_WORD(STRING_RUN, rw_Keyword, Keyword::kw_Run),
+   P_RESERVED_WORD(STRING_SLEEP, rw_Keyword, Keyword::kw_Sleep),
+   P_RESERVED_WORD(STRING_POPUP, rw_Keyword, Keyword::kw_Popup),
    // expression elements:
-   { STRING_IN, Keyword::kw_In },
-   { STRING_LIKE, Keyword::kw_Like },
-   { STRING_RESEMBLES, Keyword::kw_Resembles },
-   { STRING_BETWEEN, Keyword::kw_Between },
-   { STRING_REGEXP, Keyword::kw_Regexp },
+   P_RESERVED_WORD(STRING_IN, rw_Keyword, Keyword::kw_In),
+   P_RESERVED_WORD(STRING_LIKE, rw_Keyword, Keyword::kw_Like),
+   P_RESERVED_WORD(STRING_RESEMBLES, rw_Keyword, Keyword::kw_Resembles),
+   P_RESERVED_WORD(STRING_BETWEEN, rw_Keyword, Keyword::kw_Between),
+   P_RESERVED_WORD(STRING_REGEXP, rw_Keyword, Keyword::kw_Regexp),
    // command structs:
-   { STRING_ELSE, Keyword::kw_Else },
-   { STRING_IF, Keyword::kw_If },
-   { STRING_INSIDE, Keyword::kw_Inside },
-   { STRING_TIMES, Keyword::kw_Times },
-   { STRING_WHILE, Keyword::kw_While },
-   { STRING_FOREACH, Keyword::kw_Foreach },
+   P_RESERVED_WORD(STRING_ELSE, rw_Keyword, Keyword::kw_Else),
+   P_RESERVED_WORD(STRING_IF, rw_Keyword, Keyword::kw_If),
+   P_RESERVED_WORD(STRING_INSIDE, rw_Keyword, Keyword::kw_Inside),
+   P_RESERVED_WORD(STRING_TIMES, rw_Keyword, Keyword::kw_Times),
+   P_RESERVED_WORD(STRING_WHILE, rw_Keyword, Keyword::kw_While),
+   P_RESERVED_WORD(STRING_FOREACH, rw_Keyword, Keyword::kw_Foreach),
    // filthers:
-   { STRING_EVERY, Keyword::kw_Every },
-   { STRING_FINAL, Keyword::kw_Final },
-   { STRING_LIMIT, Keyword::kw_Limit },
-   { STRING_ORDER, Keyword::kw_Order },
-   { STRING_SKIP, Keyword::kw_Skip },
-   { STRING_WHERE, Keyword::kw_Where },
+   P_RESERVED_WORD(STRING_EVERY, rw_Keyword, Keyword::kw_Every),
+   P_RESERVED_WORD(STRING_FINAL, rw_Keyword, Keyword::kw_Final),
+   P_RESERVED_WORD(STRING_LIMIT, rw_Keyword, Keyword::kw_Limit),
+   P_RESERVED_WORD(STRING_ORDER, rw_Keyword, Keyword::kw_Order),
+   P_RESERVED_WORD(STRING_SKIP, rw_Keyword, Keyword::kw_Skip),
+   P_RESERVED_WORD(STRING_WHERE, rw_Keyword, Keyword::kw_Where),
    // rest:
-   { STRING_AS, Keyword::kw_As },
-   { STRING_BY, Keyword::kw_By },
-   { STRING_TO, Keyword::kw_To },
-   { STRING_EXTENSIONLESS, Keyword::kw_Extensionless },
-   { STRING_WITH, Keyword::kw_With },
-   { STRING_FROM, Keyword::kw_From },
+   P_RESERVED_WORD(STRING_AS, rw_Keyword, Keyword::kw_As),
+   P_RESERVED_WORD(STRING_BY, rw_Keyword, Keyword::kw_By),
+   P_RESERVED_WORD(STRING_TO, rw_Keyword, Keyword::kw_To),
+   P_RESERVED_WORD(STRING_EXTENSIONLESS, rw_Keyword, Keyword::kw_Extensionless),
+   P_RESERVED_WORD(STRING_WITH, rw_Keyword, Keyword::kw_With),
+   P_RESERVED_WORD(STRING_FROM, rw_Keyword, Keyword::kw_From),
    // order:
-   { STRING_ASC, Keyword::kw_Asc },
-   { STRING_DESC, Keyword::kw_Desc },
+   P_RESERVED_WORD(STRING_ASC, rw_Keyword, Keyword::kw_Asc),
+   P_RESERVED_WORD(STRING_DESC, rw_Keyword, Keyword::kw_Desc),
    // one-word command:
-   { STRING_BREAK, Keyword::kw_Break },
-   { STRING_CONTINUE, Keyword::kw_Continue },
-   { STRING_EXIT, Keyword::kw_Exit },
-   { STRING_ERROR, Keyword::kw_Error }
-}),
-
-MONTHS({
-   { STRING_JANUARY,    TNUM_JANUARY },
-   { STRING_FEBRUARY,   TNUM_FEBRUARY },
-   { STRING_MARCH,      TNUM_MARCH },
-   { STRING_APRIL,      TNUM_APRIL },
-   { STRING_MAY,        TNUM_MAY },
-   { STRING_JUNE,       TNUM_JUNE },
-   { STRING_JULY,       TNUM_JULY },
-   { STRING_AUGUST,     TNUM_AUGUST },
-   { STRING_SEPTEMBER,  TNUM_SEPTEMBER },
-   { STRING_OCTOBER,    TNUM_OCTOBER },
-   { STRING_NOVEMBER,   TNUM_NOVEMBER },
-   { STRING_DECEMBER,   TNUM_DECEMBER }
-}),
-
-WEEKDAYS({
-   { STRING_MONDAY,     TNUM_MONDAY },
-   { STRING_TUESDAY,    TNUM_TUESDAY },
-   { STRING_WEDNESDAY,  TNUM_WEDNESDAY },
-   { STRING_THURSDAY,   TNUM_THURSDAY },
-   { STRING_FRIDAY,     TNUM_FRIDAY },
-   { STRING_SATURDAY,   TNUM_SATURDAY },
-   { STRING_SUNDAY,     TNUM_SUNDAY }
-})
-
-{ };
+   P_RESERVED_WORD(STRING_BREAK, rw_Keyword, Keyword::kw_Break),
+   P_RESERVED_WORD(STRING_CONTINUE, rw_Keyword, Keyword::kw_Continue),
+   P_RESERVED_WORD(STRING_EXIT, rw_Keyword, Keyword::kw_Exit),
+   P_RESERVED_WORD(STRING_ERROR, rw_Keyword, Keyword::kw_Error),
+   // months:
+   P_RESERVED_WORD(STRING_JANUARY, rw_Month, TNUM_JANUARY),
+   P_RESERVED_WORD(STRING_FEBRUARY, rw_Month, TNUM_FEBRUARY),
+   P_RESERVED_WORD(STRING_MARCH, rw_Month, TNUM_MARCH),
+   P_RESERVED_WORD(STRING_APRIL, rw_Month, TNUM_APRIL),
+   P_RESERVED_WORD(STRING_MAY, rw_Month, TNUM_MAY),
+   P_RESERVED_WORD(STRING_JUNE, rw_Month, TNUM_JUNE),
+   P_RESERVED_WORD(STRING_JULY, rw_Month, TNUM_JULY),
+   P_RESERVED_WORD(STRING_AUGUST, rw_Month, TNUM_AUGUST),
+   P_RESERVED_WORD(STRING_SEPTEMBER, rw_Month, TNUM_SEPTEMBER),
+   P_RESERVED_WORD(STRING_OCTOBER, rw_Month, TNUM_OCTOBER),
+   P_RESERVED_WORD(STRING_NOVEMBER, rw_Month, TNUM_NOVEMBER),
+   P_RESERVED_WORD(STRING_DECEMBER, rw_Month, TNUM_DECEMBER),
+   // days of the week:
+   P_RESERVED_WORD(STRING_MONDAY, rw_WeekDay, TNUM_MONDAY),
+   P_RESERVED_WORD(STRING_TUESDAY, rw_WeekDay, TNUM_TUESDAY),
+   P_RESERVED_WORD(STRING_WEDNESDAY, rw_WeekDay, TNUM_WEDNESDAY),
+   P_RESERVED_WORD(STRING_THURSDAY, rw_WeekDay, TNUM_THURSDAY),
+   P_RESERVED_WORD(STRING_FRIDAY, rw_WeekDay, TNUM_FRIDAY),
+   P_RESERVED_WORD(STRING_SATURDAY, rw_WeekDay, TNUM_SATURDAY),
+   P_RESERVED_WORD(STRING_SUNDAY, rw_WeekDay, TNUM_SUNDAY)
+};
+
+#undef P_RESERVED_WORD
+
+
+p_constexpr p_size RESERVED_WORDS_COUNT = _countof(RESERVED_WORDS);
+
+// table has many more slots than words
+// so it is easy to find a hash function without collisions
+p_constexpr p_size RESERVED_TABLE_SIZE = 1024;
+p_constexpr p_size RESERVED_TABLE_MASK = RESERVED_TABLE_SIZE - 1;
+p_constexpr uint8_t RESERVED_EMPTY_SLOT = 0xFF;
+
+static_assert(RESERVED_WORDS_COUNT < RESERVED_EMPTY_SLOT, "too many reserved words for the hash table");
+
+
+// FNV-1a with a seed
+// characters are expected to be lowercase
+static constexpr uint32_t reservedHash(const p_char* word, const p_size length, const uint32_t seed)
+{
+   uint32_t hash = 2166136261u ^ seed;
+
+   for (p_size i = 0; i < length; i++) {
+      hash ^= static_cast<uint32_t>(word[i]);
+      hash *= 16777619u;
+   }
+
+   return hash ^ (hash >> 16);
+}
+
+
+struct ReservedTable
+{
+   uint32_t seed;
+   p_size maxLength;
+   uint8_t slots[RESERVED_TABLE_SIZE];
+};
+
+
+// try consecutive seeds until every reserved word gets its own slot
+static constexpr ReservedTable makeReservedTable()
+{
+   ReservedTable table {};
+
+   for (p_size i = 0; i < RESERVED_WORDS_COUNT; i++) {
+      if (RESERVED_WORDS[i].length > table.maxLength) {
+         table.maxLength = RESERVED_WORDS[i].length;
+      }
+   }
+
+   for (uint32_t seed = 0; ; seed++) {
+      table.seed = seed;
+      p_bool collision = false;
+
+      for (p_size i = 0; i < RESERVED_TABLE_SIZE; i++) {
+         table.slots[i] = RESERVED_EMPTY_SLOT;
+      }
+
+      for (p_size i = 0; i < RESERVED_WORDS_COUNT; i++) {
+         const ReservedWord& rw = RESERVED_WORDS[i];
+         const p_size slot = reservedHash(rw.text, rw.length, seed) & RESERVED_TABLE_MASK;
+
+         if (table.slots[slot] != RESERVED_EMPTY_SLOT) {
+            collision = true;
+            break;
+         }
+
+         table.slots[slot] = static_cast<uint8_t>(i);
+      }
+
+      if (! collision) {
+         return table;
+      }
+   }
+}
+
+p_constexpr ReservedTable RESERVED_TABLE = makeReservedTable();
+p_constexpr p_size RESERVED_MAX_LENGTH = RESERVED_TABLE.maxLength;
+
+
+static const ReservedWord* findNonAsciiReservedWord(const p_char* word, const p_size length)
+{
+   // locale-aware conversion to lowercase may turn some exotic letters into ordinary ones
+   // for example, Kelvin sign K becomes k
+   p_str lower(word, length);
+   str_toLower(lower);
+
+   for (const p_char ch : lower) {
+      if (ch > CHAR_ASCII_LAST) {
+         return nullptr;
+      }
+   }
+
+   return findReservedWord(lower.c_str(), length);
+}
+
+const ReservedWord* findReservedWord(const p_char* word, const p_size length)
+{
+   if (length > RESERVED_MAX_LENGTH) {
+      return nullptr;
+   }
+
+   p_char lower[RESERVED_MAX_LENGTH];
+
+   for (p_size i = 0; i < length; i++) {
+      const p_char ch = word[i];
+
+      if (ch >= CHAR_A && ch <= CHAR_Z) {
+         lower[i] = static_cast<p_char>(ch - CHAR_A + CHAR_a);
+      }
+      else if (ch > CHAR_ASCII_LAST) {
+         return findNonAsciiReservedWord(word, length);
+      }
+      else {
+         lower[i] = ch;
+      }
+   }
+
+   const p_size slot = reservedHash(lower, length, RESERVED_TABLE.seed) & RESERVED_TABLE_MASK;
+   const uint8_t index = RESERVED_TABLE.slots[slot];
+
+   if (index == RESERVED_EMPTY_SLOT) {
+      return nullptr;
+   }
+
+   const ReservedWord& rw = RESERVED_WORDS[index];
+
+   return rw.length == length && std::wmemcmp(rw.text, lower, length) == 0
+      ? &rw
+      : nullptr;
+}
 
 }
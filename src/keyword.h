@@ -15,7 +15,6 @@
 #pragma once
 
 #include "datatype/primitives.h"
-#include <unordered_map>
 
 
 namespace perun2
@@ -100,13 +99,28 @@ enum Keyword
 };
 
 
-struct KeywordsData
+enum ReservedWordType
 {
-public:
-   KeywordsData();
-   const std::unordered_map<p_str, Keyword> KEYWORDS;
-   const std::unordered_map<p_str, p_nint> MONTHS;
-   const std::unordered_map<p_str, p_nint> WEEKDAYS;
+   rw_Keyword = 0,
+   rw_Month,
+   rw_WeekDay
 };
 
+
+// element of the fixed vocabulary of the language
+// value is a Keyword or a number of month or day of the week
+struct ReservedWord
+{
+   const p_char* text;
+   p_size length;
+   ReservedWordType type;
+   p_int value;
+};
+
+
+// case-insensitive search of a reserved word in a fragment of code
+// uses a perfect hash table generated during compilation
+// returns nullptr if this is an ordinary word
+const ReservedWord* findReservedWord(const p_char* word, const p_size length);
+
 }
@@ -369,25 +369,23 @@ static Token wordToken(const p_str& code, const p_size start, const p_size lengt
    }
 
    if (dots == 0) {
-      p_str word = code.substr(start, length);
-      str_toLower(word);
+      const ReservedWord* reserved = findReservedWord(code.c_str() + start, length);
 
-      auto fm = p2.keywordsData.MONTHS.find(word);
-      if (fm != p2.keywordsData.MONTHS.end()) {
-         return Token(p_num(fm->second), line, start, length, NumberMode::nm_Month, p2);
-      }
-
-      auto fw = p2.keywordsData.WEEKDAYS.find(word);
-      if (fw != p2.keywordsData.WEEKDAYS.end()) {
-         return Token(p_num(fw->second), line, start, length, NumberMode::nm_WeekDay, p2);
-      }
-
-      auto fk = p2.keywordsData.KEYWORDS.find(word);
-      if (fk == p2.keywordsData.KEYWORDS.end()) {
+      if (reserved == nullptr) {
          return Token(line, start, length, p2);
       }
 
-      return Token(fk->second, line, start, length, p2);
+      switch (reserved->type) {
+         case ReservedWordType::rw_Month: {
+            return Token(p_num(static_cast<p_nint>(reserved->value)), line, start, length, NumberMode::nm_Month, p2);
+         }
+         case ReservedWordType::rw_WeekDay: {
+            return Token(p_num(static_cast<p_nint>(reserved->value)), line, start, length, NumberMode::nm_WeekDay, p2);
+         }
+         default: {
+            return Token(static_cast<Keyword>(reserved->value), line, start, length, p2);
+         }
+      }
    }
 
    if (dots == 1) {
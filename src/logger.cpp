@@ -11,42 +11,287 @@
     You should have received a copy of the GNU General Public License
     along with Perun2. If not, see <http://www.gnu.org/licenses/>.
 */
-#include "logger.h"
+
 #include "perun2.h"
+#include <ctime>
 
 namespace perun2
 {
 
+const p_char* const LOG_OPERATION_NAMES[LogOperation::lo_Count] =
+{
+   L"copy",
+   L"move",
+   L"create",
+   L"create file",
+   L"create directory",
+   L"delete",
+   L"drop",
+   L"rename",
+   L"open",
+   L"run",
+   L"select",
+   L"hide",
+   L"unhide",
+   L"lock",
+   L"unlock",
+   L"reaccess",
+   L"rechange",
+   L"recreate",
+   L"remodify"
+};
+
+
+thread_local p_str Logger::line;
+thread_local p_str Logger::array;
+thread_local p_bool Logger::arrayEmpty = true;
+
+
+LogWriter::LogWriter(std::wostream& out)
+   : output(&out) { };
+
+LogWriter::~LogWriter() noexcept
+{
+   {
+      std::lock_guard<std::mutex> lock(this->pendingMutex);
+      this->stopped = true;
+   }
+
+   this->wakeUp.notify_one();
+
+   if (this->writer.joinable()) {
+      this->writer.join();
+   }
+}
+
+void LogWriter::add(const p_str& text)
+{
+   std::lock_guard<std::mutex> lock(this->pendingMutex);
+   const p_bool wasEmpty = this->pending.empty();
+   this->pending += text;
+
+   if (! this->writer.joinable()) {
+      this->writer = std::thread(&LogWriter::work, this);
+   }
+   else if (wasEmpty || this->pending.size() >= LOG_BATCH_SIZE) {
+      this->wakeUp.notify_one();
+   }
+}
+
+void LogWriter::flush()
+{
+   std::unique_lock<std::mutex> lock(this->pendingMutex);
+   this->writeBatch(lock);
+}
+
+void LogWriter::setOutput(std::wostream& out)
+{
+   std::unique_lock<std::mutex> lock(this->pendingMutex);
+   this->writeBatch(lock);
+   lock.lock();
+
+   const std::lock_guard<std::mutex> outputLock(this->outputMutex);
+   this->output = &out;
+}
+
+void LogWriter::work()
+{
+   std::unique_lock<std::mutex> lock(this->pendingMutex);
+
+   while (true) {
+      this->wakeUp.wait(lock, [this]() {
+         return this->stopped || ! this->pending.empty();
+      });
+
+      // the first line waits a moment for the next ones
+      this->wakeUp.wait_for(lock, LOG_FLUSH_INTERVAL, [this]() {
+         return this->stopped || this->pending.size() >= LOG_BATCH_SIZE;
+      });
+
+      if (! this->pending.empty()) {
+         this->writeBatch(lock);
+         lock.lock();
+      }
+
+      if (this->stopped && this->pending.empty()) {
+         return;
+      }
+   }
+}
+
+void LogWriter::writeBatch(std::unique_lock<std::mutex>& pendingLock)
+{
+   // the output is taken before pending lines are released
+   // so batches are written in the same order as they were taken
+   const std::lock_guard<std::mutex> outputLock(this->outputMutex);
+   this->batch.swap(this->pending);
+   pendingLock.unlock();
+
+   if (! this->batch.empty()) {
+      *this->output << this->batch;
+      this->batch.clear();
+   }
+
+   this->output->flush();
+}
+
+
 Logger::Logger()
-    : isSilent(false), flushBuffer(true) { };
+    : isSilent(false), format(OutputFormat::of_Text), writer(std::make_unique<LogWriter>(p_cout)) { };
 
 Logger::Logger(const Perun2Process& p2)
-    : isSilent(p2.arguments.hasFlag(FLAG_SILENT)),
-      flushBuffer(p2.arguments.hasFlag(FLAG_GUI)) { };
+    : isSilent(p2.arguments.hasFlag(FLAG_SILENT)), format(p2.arguments.getOutputFormat()),
+      writer(std::make_unique<LogWriter>(p_cout)) { };
 
 void Logger::print(const p_str& value) const
 {
-   if (this->flushBuffer) {
-      p_cout << value << std::endl;
+   Logger::line.assign(value);
+   Logger::line += CHAR_NEW_LINE;
+   this->writer->add(Logger::line);
+}
+
+void Logger::printValue(const p_str& value) const
+{
+   if (this->format == OutputFormat::of_Text) {
+      this->print(value);
+      return;
    }
-   else {
-      p_cout << value << CHAR_NEW_LINE;
+
+   Logger::line.assign(1, CHAR_QUOTATION_MARK);
+   str_appendJsonEscaped(Logger::line, value);
+   Logger::line += CHAR_QUOTATION_MARK;
+   Logger::line += CHAR_NEW_LINE;
+   this->writer->add(Logger::line);
+}
+
+void Logger::printArrayStart() const
+{
+   if (this->format == OutputFormat::of_JsonLines) {
+      Logger::array.assign(1, CHAR_OPENING_SQUARE_BRACKET);
+      Logger::arrayEmpty = true;
    }
 }
 
-void Logger::emptyLine() const
+void Logger::printArrayElement(const p_str& value) const
 {
-   if (this->flushBuffer) {
-      p_cout << std::endl;
+   if (this->format == OutputFormat::of_Text) {
+      this->print(value);
+      return;
+   }
+
+   if (Logger::arrayEmpty) {
+      Logger::arrayEmpty = false;
    }
    else {
-      p_cout << CHAR_NEW_LINE;
+      Logger::array += CHAR_COMMA;
+   }
+
+   Logger::array += CHAR_QUOTATION_MARK;
+   str_appendJsonEscaped(Logger::array, value);
+   Logger::array += CHAR_QUOTATION_MARK;
+
+   // a long definition is not kept in memory until its end
+   if (Logger::array.size() >= LOG_BATCH_SIZE) {
+      this->writer->add(Logger::array);
+      Logger::array.clear();
    }
 }
 
-void Logger::write(const p_str& first) const
+void Logger::printArrayEnd() const
+{
+   if (this->format == OutputFormat::of_JsonLines) {
+      Logger::array += CHAR_CLOSING_SQUARE_BRACKET;
+      Logger::array += CHAR_NEW_LINE;
+      this->writer->add(Logger::array);
+      Logger::array.clear();
+   }
+}
+
+void Logger::emptyLine() const
+{
+   Logger::line.assign(1, CHAR_NEW_LINE);
+   this->writer->add(Logger::line);
+}
+
+void Logger::flush() const
+{
+   this->writer->flush();
+}
+
+void Logger::setOutput(std::wostream& out)
 {
-   p_cout << first;
+   this->writer->setOutput(out);
+}
+
+void Logger::append(const p_str& first) const
+{
+   Logger::line += first;
+}
+
+void Logger::appendEscaped(const p_str& first) const
+{
+   str_appendJsonEscaped(Logger::line, first);
+}
+
+void Logger::appendRecord(const LogOperation operation, const p_str& source,
+   const p_str& destination, const p_bool success) const
+{
+   Logger::line += CHAR_OPENING_CURLY_BRACKET;
+   this->appendField(L"timestamp");
+   this->appendTimestamp();
+   Logger::line += CHAR_COMMA;
+   this->appendField(L"operation");
+   Logger::line += CHAR_QUOTATION_MARK;
+   Logger::line += LOG_OPERATION_NAMES[operation];
+   Logger::line += CHAR_QUOTATION_MARK;
+   Logger::line += CHAR_COMMA;
+   this->appendField(L"source");
+   this->appendNullableString(source);
+   Logger::line += CHAR_COMMA;
+   this->appendField(L"destination");
+   this->appendNullableString(destination);
+   Logger::line += CHAR_COMMA;
+   this->appendField(L"success");
+   Logger::line += success ? STRING_TRUE : STRING_FALSE;
+   Logger::line += CHAR_COMMA;
+   this->appendField(L"error");
+}
+
+// ISO 8601 in UTC with milliseconds, formatted on the stack
+void Logger::appendTimestamp() const
+{
+   const std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+   const std::time_t seconds = std::chrono::system_clock::to_time_t(now);
+   const p_int millis = static_cast<p_int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+      now.time_since_epoch()).count() % 1000);
+
+   p_char buffer[32];
+   const p_size length = std::wcsftime(buffer, 32, L"%Y-%m-%dT%H:%M:%S", std::gmtime(&seconds));
+   std::swprintf(buffer + length, 32 - length, L".%03dZ", millis);
+
+   Logger::line += CHAR_QUOTATION_MARK;
+   Logger::line += buffer;
+   Logger::line += CHAR_QUOTATION_MARK;
+}
+
+void Logger::appendField(const p_char* name) const
+{
+   Logger::line += CHAR_QUOTATION_MARK;
+   Logger::line += name;
+   Logger::line += CHAR_QUOTATION_MARK;
+   Logger::line += CHAR_COLON;
+}
+
+void Logger::appendNullableString(const p_str& value) const
+{
+   if (value.empty()) {
+      Logger::line += STRING_JSON_NULL;
+      return;
+   }
+
+   Logger::line += CHAR_QUOTATION_MARK;
+   str_appendJsonEscaped(Logger::line, value);
+   Logger::line += CHAR_QUOTATION_MARK;
 }
 
 }
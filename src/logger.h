@@ -16,7 +16,13 @@
 
 #include "datatype/primitives.h"
 #include "datatype/text/chars.h"
+#include "datatype/text/strings.h"
+#include <chrono>
+#include <condition_variable>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 
 namespace perun2
@@ -24,6 +30,92 @@ namespace perun2
 
 struct Perun2Process;
 
+
+// format of messages, chosen by the command-line option --output
+enum OutputFormat : uint8_t
+{
+   of_Text = 0,
+   // one JSON record in every line, for other programs
+   of_JsonLines
+};
+
+
+// what a command did with a file or a directory
+enum LogOperation : uint8_t
+{
+   lo_Copy = 0,
+   lo_Move,
+   lo_Create,
+   lo_CreateFile,
+   lo_CreateDirectory,
+   lo_Delete,
+   lo_Drop,
+   lo_Rename,
+   lo_Open,
+   lo_Run,
+   lo_Select,
+   lo_Hide,
+   lo_Unhide,
+   lo_Lock,
+   lo_Unlock,
+   lo_Reaccess,
+   lo_Rechange,
+   lo_Recreate,
+   lo_Remodify,
+   lo_Count
+};
+
+// names of operations in JSON records, in the order of the enum
+extern const p_char* const LOG_OPERATION_NAMES[LogOperation::lo_Count];
+
+
+// lines wait at most this long before they are written
+p_constexpr std::chrono::milliseconds LOG_FLUSH_INTERVAL(50);
+
+// if this many characters are waiting, they are written at once
+p_constexpr p_size LOG_BATCH_SIZE = 32 * 1024;
+
+
+// complete lines are collected here and written to the output by a separate thread
+// a loop that logs every element does not wait for the console anymore
+// the output gets one big write and one flush for a batch of many lines
+// lines come out in the order they were added, no matter which thread added them
+struct LogWriter
+{
+public:
+   LogWriter() = delete;
+   LogWriter(std::wostream& out);
+   LogWriter(LogWriter const&) = delete;
+   LogWriter& operator= (LogWriter const&) = delete;
+   ~LogWriter() noexcept;
+
+   // the text should end with a new line
+   void add(const p_str& text);
+
+   // return after everything added so far is written and flushed
+   void flush();
+
+   void setOutput(std::wostream& out);
+
+private:
+   void work();
+
+   // the lock of pending lines is released, when they are taken
+   void writeBatch(std::unique_lock<std::mutex>& pendingLock);
+
+   std::wostream* output;
+   p_str pending;
+   p_str batch;
+   // always locked in this order: pending lines first, then the output
+   std::mutex pendingMutex;
+   std::mutex outputMutex;
+   std::condition_variable wakeUp;
+   p_bool stopped = false;
+   // started with the first line
+   std::thread writer;
+};
+
+
 struct Logger
 {
 public:
@@ -42,37 +134,110 @@ public:
          return;
       }
 
-      this->write(args...);
+      Logger::line.clear();
+      this->append(args...);
+      Logger::line += CHAR_NEW_LINE;
+      this->writer->add(Logger::line);
+   }
+    
+   // print the log of a command, that did something with a file or a directory
+   // in the text format, this is the same as log() of the message
+   // in JSON Lines, a record is printed instead and the message of a failure becomes its error
+   // empty source or destination is null
+   template<typename... Args>
+   void logOperation(const LogOperation operation, const p_str& source, const p_str& destination,
+      const p_bool success, const Args&... message) const
+   {
+      if (this->isSilent) {
+         return;
+      }
 
-      if (this->flushBuffer) {
-         p_cout << std::endl;
+      Logger::line.clear();
+
+      if (this->format == OutputFormat::of_JsonLines) {
+         this->appendRecord(operation, source, destination, success);
+
+         if (success) {
+            Logger::line += STRING_JSON_NULL;
+         }
+         else {
+            Logger::line += CHAR_QUOTATION_MARK;
+            this->appendEscaped(message...);
+            Logger::line += CHAR_QUOTATION_MARK;
+         }
+
+         Logger::line += CHAR_CLOSING_CURLY_BRACKET;
       }
       else {
-         p_cout << CHAR_NEW_LINE;
+         this->append(message...);
       }
+
+      Logger::line += CHAR_NEW_LINE;
+      this->writer->add(Logger::line);
    }
-    
+
+   // print a value of the command Print
+   // in JSON Lines, it is a string literal
+   void printValue(const p_str& value) const;
+
+   // the command Print of a list or a definition
+   // in JSON Lines, its elements are streamed as one array in one line
+   // in the text format, every element is in its own line
+   void printArrayStart() const;
+   void printArrayElement(const p_str& value) const;
+   void printArrayEnd() const;
+
    // print an empty line
    void emptyLine() const;
 
+   // wait until every message is written
+   void flush() const;
+
+   // messages go to the console by default
+   void setOutput(std::wostream& out);
+
 private:
    template<typename... Args>
-   void write(const p_str& first, const Args&... args) const
+   void append(const p_str& first, const Args&... args) const
+   {
+      Logger::line += first;
+      append(args...);
+   }
+
+   void append(const p_str& first) const;
+
+   template<typename... Args>
+   void appendEscaped(const p_str& first, const Args&... args) const
    {
-      p_cout << first;
-      write(args...);
+      str_appendJsonEscaped(Logger::line, first);
+      appendEscaped(args...);
    }
 
-   void write(const p_str& first) const;
+   void appendEscaped(const p_str& first) const;
+
+   // every field of a record, except of the error at the end
+   void appendRecord(const LogOperation operation, const p_str& source,
+      const p_str& destination, const p_bool success) const;
+   void appendTimestamp() const;
+   void appendField(const p_char* name) const;
+   void appendNullableString(const p_str& value) const;
 
    // if program was called with -s
    // it runs in silent mode and there are no logs of filesystem commands
    // however, critical error messages and Print should still work
    const p_bool isSilent;
+   const OutputFormat format;
+
+   std::unique_ptr<LogWriter> writer;
+
+   // a line is formatted here before it is handed over to the writer
+   // every thread reuses its own memory
+   static thread_local p_str line;
 
-   // if the logger sends messages to the GUI program, flush the buffer every line
-   // otherwise (messages go straight to the console), do not do that
-   const p_bool flushBuffer;
+   // the array of the command Print is streamed from here
+   // parts of it are handed over to the writer, when it grows big
+   static thread_local p_str array;
+   static thread_local p_bool arrayEmpty;
 };
 
 }
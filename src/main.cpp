@@ -14,6 +14,8 @@
 
 #include "perun2.h"
 #include "cmd.h"
+#include "daemon.h"
+#include "watch.h"
 
 
 int main(void)
@@ -33,9 +35,18 @@ int main(void)
 
    perun2::Perun2 instance(argc, argv);
 
+   if (instance.getArgsParseState() == perun2::ArgsParseState::aps_Daemon) {
+      LocalFree(argv);
+      return perun2::runDaemon();
+   }
+
    if (instance.hasArgFlag(perun2::FLAG_STATIC_ANALYSIS)) {
       instance.staticallyAnalyze();
    }
+   else if (instance.hasArgFlag(perun2::FLAG_WATCH)) {
+      LocalFree(argv);
+      return perun2::runWatch(instance);
+   }
    else {
       instance.run();
    }
@@ -0,0 +1,498 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "media.h"
+#include "os/os.h"
+#include <algorithm>
+#include <cstring>
+
+
+namespace perun2
+{
+
+static uint32_t readBigEndian16(const unsigned char* data)
+{
+   return (static_cast<uint32_t>(data[0]) << 8) | data[1];
+}
+
+static uint32_t readBigEndian32(const unsigned char* data)
+{
+   return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16)
+      | (static_cast<uint32_t>(data[2]) << 8) | data[3];
+}
+
+static uint32_t readLittleEndian16(const unsigned char* data)
+{
+   return data[0] | (static_cast<uint32_t>(data[1]) << 8);
+}
+
+static uint32_t readLittleEndian24(const unsigned char* data)
+{
+   return data[0] | (static_cast<uint32_t>(data[1]) << 8) | (static_cast<uint32_t>(data[2]) << 16);
+}
+
+static uint32_t readLittleEndian32(const unsigned char* data)
+{
+   return data[0] | (static_cast<uint32_t>(data[1]) << 8)
+      | (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+static p_bool startsWith(const unsigned char* data, const p_size size, const char* value, const p_size length)
+{
+   return size >= length && std::memcmp(data, value, length) == 0;
+}
+
+static MediaHeader imageHeader(const int64_t width, const int64_t height, MediaInfo& result)
+{
+   if (width <= 0 || height <= 0) {
+      return MediaHeader::mh_Unknown;
+   }
+
+   result.kind = MediaKind::mk_Image;
+   result.width = width;
+   result.height = height;
+   result.duration = 0;
+   return MediaHeader::mh_Image;
+}
+
+static MediaHeader probePng(const unsigned char* data, const p_size size, MediaInfo& result)
+{
+   // the first chunk is always IHDR
+   if (size < 24 || std::memcmp(data + 12, "IHDR", 4) != 0) {
+      return MediaHeader::mh_Unknown;
+   }
+
+   return imageHeader(readBigEndian32(data + 16), readBigEndian32(data + 20), result);
+}
+
+static MediaHeader probeGif(const unsigned char* data, const p_size size, MediaInfo& result)
+{
+   if (size < 10) {
+      return MediaHeader::mh_Unknown;
+   }
+
+   return imageHeader(readLittleEndian16(data + 6), readLittleEndian16(data + 8), result);
+}
+
+static MediaHeader probeBmp(const unsigned char* data, const p_size size, MediaInfo& result)
+{
+   if (size < 26) {
+      return MediaHeader::mh_Unknown;
+   }
+
+   // old OS/2 header has 16-bit dimensions
+   if (readLittleEndian32(data + 14) == 12) {
+      return imageHeader(readLittleEndian16(data + 18), readLittleEndian16(data + 20), result);
+   }
+
+   // negative height means that rows go from the top
+   const int64_t width = static_cast<int32_t>(readLittleEndian32(data + 18));
+   const int64_t height = static_cast<int32_t>(readLittleEndian32(data + 22));
+   return imageHeader(width, height < 0 ? -height : height, result);
+}
+
+static MediaHeader probeWebp(const unsigned char* data, const p_size size, MediaInfo& result)
+{
+   if (size < 30) {
+      return MediaHeader::mh_Unknown;
+   }
+
+   const unsigned char* chunk = data + 12;
+
+   // lossy
+   if (std::memcmp(chunk, "VP8 ", 4) == 0) {
+      if (data[23] != 0x9D || data[24] != 0x01 || data[25] != 0x2A) {
+         return MediaHeader::mh_Unknown;
+      }
+
+      return imageHeader(readLittleEndian16(data + 26) & 0x3FFF, readLittleEndian16(data + 28) & 0x3FFF, result);
+   }
+
+   // lossless
+   if (std::memcmp(chunk, "VP8L", 4) == 0) {
+      if (data[20] != 0x2F) {
+         return MediaHeader::mh_Unknown;
+      }
+
+      const uint32_t bits = readLittleEndian32(data + 21);
+      return imageHeader(1 + (bits & 0x3FFF), 1 + ((bits >> 14) & 0x3FFF), result);
+   }
+
+   // extended, may be animated
+   if (std::memcmp(chunk, "VP8X", 4) == 0) {
+      return imageHeader(1 + readLittleEndian24(data + 24), 1 + readLittleEndian24(data + 27), result);
+   }
+
+   return MediaHeader::mh_Unknown;
+}
+
+static MediaHeader probeJpeg(const unsigned char* data, const p_size size, MediaInfo& result)
+{
+   p_size position = 2;
+
+   // go through segments until the frame header
+   // if it is beyond the read part of the file, FFmpeg will find it
+   while (position + 4 <= size) {
+      if (data[position] != 0xFF) {
+         return MediaHeader::mh_Unknown;
+      }
+
+      const unsigned char marker = data[position + 1];
+
+      // padding
+      if (marker == 0xFF) {
+         position++;
+         continue;
+      }
+
+      // markers without content
+      if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD8)) {
+         position += 2;
+         continue;
+      }
+
+      // end of the image or the beginning of compressed data
+      if (marker == 0xD9 || marker == 0xDA) {
+         return MediaHeader::mh_Unknown;
+      }
+
+      const p_size length = readBigEndian16(data + position + 2);
+
+      // start of frame, but not the Huffman table, arithmetic coding conditioning or other markers from this range
+      if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC) {
+         if (position + 9 > size) {
+            return MediaHeader::mh_Unknown;
+         }
+
+         return imageHeader(readBigEndian16(data + position + 7), readBigEndian16(data + position + 5), result);
+      }
+
+      if (length < 2) {
+         return MediaHeader::mh_Unknown;
+      }
+
+      position += 2 + length;
+   }
+
+   return MediaHeader::mh_Unknown;
+}
+
+MediaHeader probeMediaHeader(const char* data, const p_size size, MediaInfo& result)
+{
+   const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+
+   if (startsWith(bytes, size, "\x89PNG\r\n\x1A\n", 8)) {
+      return probePng(bytes, size, result);
+   }
+
+   if (startsWith(bytes, size, "\xFF\xD8\xFF", 3)) {
+      return probeJpeg(bytes, size, result);
+   }
+
+   if (startsWith(bytes, size, "GIF87a", 6) || startsWith(bytes, size, "GIF89a", 6)) {
+      return probeGif(bytes, size, result);
+   }
+
+   if (startsWith(bytes, size, "BM", 2)) {
+      return probeBmp(bytes, size, result);
+   }
+
+   if (size >= 12 && std::memcmp(bytes, "RIFF", 4) == 0 && std::memcmp(bytes + 8, "WEBP", 4) == 0) {
+      return probeWebp(bytes, size, result);
+   }
+
+   return MediaHeader::mh_Unknown;
+}
+
+
+p_bool hasMediaSignature(const char* data, const p_size size)
+{
+   const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+
+   // formats with a magic number at the very beginning
+   static const std::string SIGNATURES[] = {
+      // images
+      std::string("\x89PNG", 4), std::string("\xFF\xD8\xFF", 3), "GIF8", "BM",
+      std::string("II*\0", 4), std::string("MM\0*", 4), std::string("\0\0\1\0", 4),
+      "8BPS", "qoif", std::string("\x76\x2F\x31\x01", 4), std::string("\xFF\x4F\xFF\x51", 4),
+      std::string("\0\0\0\x0CjP  ", 8), std::string("\0\0\0\x0CJXL ", 8), std::string("\xFF\x0A", 2),
+      "#?RADIANCE", "#?RGBE", "SIMPLE  =", "SDPX", "XPDS", std::string("\x01\xDA", 2), "<svg",
+      // videos
+      std::string("\x1A\x45\xDF\xA3", 4), "FLV", "OggS", ".RMF", "BIK", "SMK",
+      std::string("\0\0\1\xBA", 4), std::string("\0\0\1\xB3", 4),
+      std::string("\x30\x26\xB2\x75\x8E\x66\xCF\x11", 8), std::string("\x06\x0E\x2B\x34", 4)
+   };
+
+   for (const std::string& signature : SIGNATURES) {
+      if (startsWith(bytes, size, signature.data(), signature.size())) {
+         return true;
+      }
+   }
+
+   // ISO base media: MP4, MOV, 3GP, but also AVIF and HEIC images
+   if (size >= 8 && std::memcmp(bytes + 4, "ftyp", 4) == 0) {
+      return true;
+   }
+
+   if (size >= 12 && std::memcmp(bytes, "RIFF", 4) == 0) {
+      return std::memcmp(bytes + 8, "AVI ", 4) == 0
+         || std::memcmp(bytes + 8, "WEBP", 4) == 0;
+   }
+
+   // MPEG transport stream is a sequence of packets of 188 bytes
+   if (size > 188 && bytes[0] == 0x47 && bytes[188] == 0x47) {
+      return true;
+   }
+
+   // Netpbm
+   if (size >= 3 && bytes[0] == 'P' && bytes[1] >= '1' && bytes[1] <= '7'
+      && (bytes[2] == ' ' || bytes[2] == '\n' || bytes[2] == '\r' || bytes[2] == '\t'))
+   {
+      return true;
+   }
+
+   // SVG may start with an XML declaration
+   if (startsWith(bytes, size, "<?xml", 5)) {
+      static const std::string SVG = "<svg";
+      return std::search(data, data + size, SVG.begin(), SVG.end()) != data + size;
+   }
+
+   return false;
+}
+
+
+struct ExtensionClass
+{
+   const p_char* extension;
+   MediaExtension kind;
+};
+
+// sorted, so it can be searched by bisection
+p_constexpr ExtensionClass MEDIA_EXTENSIONS[] = {
+   { L"3g2", me_Video }, { L"3gp", me_Video }, { L"7z", me_Other }, { L"aac", me_Other },
+   { L"amv", me_Video }, { L"apng", me_Image }, { L"asf", me_Video }, { L"avi", me_Video },
+   { L"avif", me_Image }, { L"bat", me_Other }, { L"bmp", me_Image }, { L"c", me_Other },
+   { L"cfg", me_Other }, { L"cpp", me_Other }, { L"cs", me_Other }, { L"css", me_Other },
+   { L"csv", me_Other }, { L"dib", me_Image }, { L"dll", me_Other }, { L"doc", me_Other },
+   { L"docx", me_Other }, { L"dpx", me_Image }, { L"exe", me_Other }, { L"exr", me_Image },
+   { L"f4v", me_Video }, { L"fits", me_Image }, { L"flac", me_Other }, { L"flv", me_Video },
+   { L"gif", me_Image }, { L"gz", me_Other }, { L"h", me_Other }, { L"hdr", me_Image },
+   { L"heic", me_Image }, { L"heif", me_Image }, { L"hpp", me_Other }, { L"htm", me_Other },
+   { L"html", me_Other }, { L"ico", me_Image }, { L"ini", me_Other }, { L"iso", me_Other },
+   { L"j2k", me_Image }, { L"jar", me_Other }, { L"java", me_Other }, { L"jfif", me_Image },
+   { L"jp2", me_Image }, { L"jpe", me_Image }, { L"jpeg", me_Image }, { L"jpg", me_Image },
+   { L"js", me_Other }, { L"json", me_Other }, { L"jxl", me_Image }, { L"lib", me_Other },
+   { L"lnk", me_Other }, { L"log", me_Other }, { L"m2ts", me_Video }, { L"m2v", me_Video },
+   { L"m4a", me_Other }, { L"m4v", me_Video }, { L"md", me_Other }, { L"mkv", me_Video },
+   { L"mov", me_Video }, { L"mp3", me_Other }, { L"mp4", me_Video }, { L"mpeg", me_Video },
+   { L"mpg", me_Video }, { L"msi", me_Other }, { L"mts", me_Video }, { L"mxf", me_Video },
+   { L"o", me_Other }, { L"obj", me_Other }, { L"ogv", me_Video }, { L"otf", me_Other },
+   { L"pbm", me_Image }, { L"pcx", me_Image }, { L"pdb", me_Other }, { L"pdf", me_Other },
+   { L"peru", me_Other }, { L"pfm", me_Image }, { L"pgm", me_Image }, { L"php", me_Other },
+   { L"png", me_Image }, { L"ppm", me_Image }, { L"ppt", me_Other }, { L"pptx", me_Other },
+   { L"psd", me_Image }, { L"py", me_Other }, { L"qoi", me_Image }, { L"rar", me_Other },
+   { L"rm", me_Video }, { L"rmvb", me_Video }, { L"rs", me_Other }, { L"sgi", me_Image },
+   { L"sh", me_Other }, { L"sql", me_Other }, { L"svg", me_Image }, { L"sys", me_Other },
+   { L"tar", me_Other }, { L"tga", me_Image }, { L"tif", me_Image }, { L"tiff", me_Image },
+   { L"tmp", me_Other }, { L"toml", me_Other }, { L"ttf", me_Other }, { L"txt", me_Other },
+   { L"vob", me_Video }, { L"wav", me_Other }, { L"webm", me_Video }, { L"webp", me_Image },
+   { L"wma", me_Other }, { L"wmv", me_Video }, { L"woff", me_Other }, { L"xbm", me_Image },
+   { L"xls", me_Other }, { L"xlsx", me_Other }, { L"xml", me_Other }, { L"xpm", me_Image },
+   { L"xwd", me_Image }, { L"y4m", me_Video }, { L"yaml", me_Other }, { L"yml", me_Other },
+   { L"zip", me_Other }
+};
+
+static constexpr p_bool extensionLess(const p_char* left, const p_char* right)
+{
+   while (*left != 0 && *left == *right) {
+      left++;
+      right++;
+   }
+
+   return *left < *right;
+}
+
+static constexpr p_bool extensionsAreSorted()
+{
+   for (p_size i = 1; i < sizeof(MEDIA_EXTENSIONS) / sizeof(ExtensionClass); i++) {
+      if (!extensionLess(MEDIA_EXTENSIONS[i - 1].extension, MEDIA_EXTENSIONS[i].extension)) {
+         return false;
+      }
+   }
+
+   return true;
+}
+
+static_assert(extensionsAreSorted(), "media extensions are not sorted");
+
+MediaExtension classifyMediaExtension(const p_str& extension)
+{
+   if (extension.empty()) {
+      return MediaExtension::me_Unknown;
+   }
+
+   const p_char* value = extension.c_str();
+   const auto end = std::end(MEDIA_EXTENSIONS);
+   const auto found = std::lower_bound(std::begin(MEDIA_EXTENSIONS), end, value,
+      [](const ExtensionClass& ec, const p_char* v) { return extensionLess(ec.extension, v); });
+
+   return found != end && !extensionLess(value, found->extension)
+      ? found->kind
+      : MediaExtension::me_Unknown;
+}
+
+
+MediaCache::MediaCache(const p_bool persistent)
+   : persistent(persistent) { };
+
+p_bool MediaCache::get(const p_str& path, const p_nint size, const uint64_t modification, MediaInfo& result)
+{
+   if (this->persistent) {
+      std::call_once(this->loading, &MediaCache::load, this);
+   }
+
+   return FileCache<MediaInfo>::get(path, size, modification, result);
+}
+
+void MediaCache::put(const p_str& path, const p_nint size, const uint64_t modification, const MediaInfo& info)
+{
+   FileCache<MediaInfo>::put(path, size, modification, info);
+   this->changed = true;
+}
+
+p_str MediaCache::getFilePath() const
+{
+   const p_str directory = os_scriptCachePath();
+
+   return directory.empty()
+      ? p_str()
+      : str(directory, OS_SEPARATOR, MEDIA_CACHE_FILE_NAME);
+}
+
+void MediaCache::load()
+{
+   const p_str path = this->getFilePath();
+   if (path.empty()) {
+      return;
+   }
+
+   MappedFile file;
+   if (!os_mapFile(file, path)) {
+      return;
+   }
+
+   MediaCacheHeader header;
+
+   if (file.size < sizeof(MediaCacheHeader)) {
+      os_unmapFile(file);
+      return;
+   }
+
+   std::memcpy(&header, file.data, sizeof(MediaCacheHeader));
+
+   if (std::memcmp(header.magic, MEDIA_CACHE_MAGIC, sizeof(header.magic)) != 0
+      || header.format != MEDIA_CACHE_FORMAT
+      || header.charSize != sizeof(p_char))
+   {
+      os_unmapFile(file);
+      return;
+   }
+
+   p_size position = sizeof(MediaCacheHeader);
+   CachedMedia cm;
+
+   for (uint64_t i = 0; i < header.count; i++) {
+      if (file.size - position < sizeof(CachedMedia)) {
+         break;
+      }
+
+      std::memcpy(&cm, file.data + position, sizeof(CachedMedia));
+      position += sizeof(CachedMedia);
+
+      const p_size pathSize = static_cast<p_size>(cm.pathLength) * sizeof(p_char);
+      if (file.size - position < pathSize || cm.kind > MediaKind::mk_Video) {
+         break;
+      }
+
+      p_str entryPath(cm.pathLength, CHAR_SPACE);
+      std::memcpy(&entryPath[0], file.data + position, pathSize);
+      position += pathSize;
+
+      MediaInfo info;
+      info.kind = static_cast<MediaKind>(cm.kind);
+      info.width = cm.width;
+      info.height = cm.height;
+      info.duration = cm.duration;
+
+      // entries found during this run are more recent
+      const std::lock_guard<std::mutex> lock(this->mutex);
+      this->entries.emplace(entryPath, Entry{ cm.size, cm.modification, info });
+   }
+
+   os_unmapFile(file);
+}
+
+void MediaCache::save()
+{
+   if (!this->persistent || !this->changed.exchange(false)) {
+      return;
+   }
+
+   const p_str path = this->getFilePath();
+   if (path.empty()) {
+      return;
+   }
+
+   const p_str directory = os_parent(path);
+   if (!os_directoryExists(directory) && !os_createDirectory(directory)) {
+      return;
+   }
+
+   MediaCacheHeader header;
+   std::memcpy(header.magic, MEDIA_CACHE_MAGIC, sizeof(header.magic));
+   header.format = MEDIA_CACHE_FORMAT;
+   header.charSize = sizeof(p_char);
+   header.reserved = 0;
+   std::string content;
+
+   // other scripts of the daemon can use the cache in the meantime
+   // so it is locked only while its entries are copied, not during writing
+   {
+      const std::lock_guard<std::mutex> lock(this->mutex);
+      header.count = this->entries.size();
+      content.append(reinterpret_cast<const char*>(&header), sizeof(MediaCacheHeader));
+
+      for (const auto& pair : this->entries) {
+         CachedMedia cm = {};
+         cm.size = pair.second.size;
+         cm.modification = pair.second.modification;
+         cm.width = pair.second.value.width;
+         cm.height = pair.second.value.height;
+         cm.duration = pair.second.value.duration;
+         cm.pathLength = static_cast<uint32_t>(pair.first.size());
+         cm.kind = static_cast<uint8_t>(pair.second.value.kind);
+
+         content.append(reinterpret_cast<const char*>(&cm), sizeof(CachedMedia));
+         content.append(reinterpret_cast<const char*>(pair.first.data()), pair.first.size() * sizeof(p_char));
+      }
+   }
+
+   // failure is not an error
+   // media will be probed again next time
+   if (!os_writeBinaryFile(path, content)) {
+      this->changed = true;
+   }
+}
+
+}
@@ -0,0 +1,144 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "file-cache.h"
+#include <atomic>
+
+
+namespace perun2
+{
+
+// only this many bytes at the beginning of a file are read to recognize its format
+p_constexpr p_size MEDIA_HEADER_SIZE = 64 * 1024;
+
+
+enum MediaKind : uint8_t
+{
+   mk_None = 0,
+   mk_Image,
+   mk_Video
+};
+
+
+// metadata of an image or a video in a form, that can be written to a file
+struct MediaInfo
+{
+   MediaKind kind = MediaKind::mk_None;
+   int64_t width = 0;
+   int64_t height = 0;
+   // in units of FFmpeg, AV_TIME_BASE of them make one second
+   int64_t duration = 0;
+};
+
+
+enum MediaHeader
+{
+   // format and dimensions are known from the header alone
+   mh_Image = 0,
+   // the file has to be opened by FFmpeg
+   mh_Unknown
+};
+
+// dimensions of PNG, JPEG, GIF, BMP and WebP images are read directly from their headers
+MediaHeader probeMediaHeader(const char* data, const p_size size, MediaInfo& result);
+
+// the file starts with a magic number of a format, that FFmpeg may recognize as an image or a video
+p_bool hasMediaSignature(const char* data, const p_size size);
+
+
+// what the extension of a file says about its content
+enum MediaExtension : uint8_t
+{
+   // no extension or an extension not listed anywhere
+   // the beginning of the file decides
+   me_Unknown = 0,
+   me_Image,
+   me_Video,
+   // certainly not an image or a video, so the file is never opened
+   me_Other
+};
+
+// the extension should be in lowercase
+MediaExtension classifyMediaExtension(const p_str& extension);
+
+
+// how files were classified
+// every file counted here, except the last group, has not been opened by FFmpeg
+struct MediaStats
+{
+   p_size skippedByExtension = 0;
+   p_size skippedBySignature = 0;
+   p_size readFromHeader = 0;
+   p_size readFromCache = 0;
+   p_size openedByFfmpeg = 0;
+};
+
+
+// increment this number whenever the layout of cached data changes
+p_constexpr uint32_t MEDIA_CACHE_FORMAT = 1;
+p_constexpr char MEDIA_CACHE_MAGIC[] = "P2MC";
+p_constexpr p_char MEDIA_CACHE_FILE_NAME[] = L"media.p2m";
+
+
+// beginning of the cache file
+struct MediaCacheHeader
+{
+   char magic[4];
+   uint32_t format;
+   uint32_t charSize;
+   uint32_t reserved;
+   uint64_t count;
+};
+
+
+// one file in the cache file
+// characters of its path come right after it
+struct CachedMedia
+{
+   int64_t size;
+   uint64_t modification;
+   int64_t width;
+   int64_t height;
+   int64_t duration;
+   uint32_t pathLength;
+   uint8_t kind;
+   uint8_t reserved[3];
+};
+
+
+// metadata of images and videos shared by all media attributes
+// a persistent cache is read from the cache directory when it is needed for the first time
+// and written back there after every run
+struct MediaCache : FileCache<MediaInfo>
+{
+public:
+   MediaCache() = delete;
+   MediaCache(const p_bool persistent);
+
+   p_bool get(const p_str& path, const p_nint size, const uint64_t modification, MediaInfo& result);
+   void put(const p_str& path, const p_nint size, const uint64_t modification, const MediaInfo& info);
+   void save();
+
+private:
+   void load();
+   p_str getFilePath() const;
+
+   const p_bool persistent;
+   std::once_flag loading;
+   std::atomic<p_bool> changed{false};
+};
+
+}
@@ -63,15 +63,8 @@ void os_sleepForMs(const p_nint ms, Perun2Process& p2)
       return;
    }
 
-   p_nint loops = ms / OS_SLEEP_UNIT;
-   const p_nint remainder = ms % OS_SLEEP_UNIT;
-
-   os_rawSleepForMs(remainder);
-
-   while (p2.state == State::s_Running && loops != NINT_ZERO) {
-      os_rawSleepForMs(OS_SLEEP_UNIT);
-      loops--;
-   }
+   // the thread is blocked until the time passes or Perun2 is cancelled
+   p2.cancellation.waitFor(ms);
 }
 
 // attributes of something, that cannot exist (file name is empty string, contains not allowed chars, ...)
@@ -170,6 +163,14 @@ void os_loadEmptyAttributes(FileContext& context)
       context.v_height->value = P_NaN;
       context.v_duration->value = p_per();
    }
+
+   if (attribute->has(ATTR_HASH)) {
+      context.v_hash->value.clear();
+   }
+
+   if (attribute->has(ATTR_CRC32)) {
+      context.v_crc32->value = P_NaN;
+   }
 }
 
 p_str os_extension(const p_str& value)
@@ -246,33 +247,33 @@ p_str os_parent(const p_str& path)
 }
 
 
-p_bool os_attr_isImage(const p_str& path)
+p_bool os_attr_isImage(const p_str& path, Perun2Process& p2)
 {
-   const MediaAttributes media = os_ffmpegAttributes(path);
+   const MediaAttributes media = os_mediaAttributes(path, p2);
    return media.isImage;
 }
 
-p_bool os_attr_isVideo(const p_str& path)
+p_bool os_attr_isVideo(const p_str& path, Perun2Process& p2)
 {
-   const MediaAttributes media = os_ffmpegAttributes(path);
+   const MediaAttributes media = os_mediaAttributes(path, p2);
    return media.isVideo;
 }
 
-p_num os_attr_width(const p_str& path)
+p_num os_attr_width(const p_str& path, Perun2Process& p2)
 {
-   const MediaAttributes media = os_ffmpegAttributes(path);
+   const MediaAttributes media = os_mediaAttributes(path, p2);
    return media.width;
 }
 
-p_num os_attr_height(const p_str& path)
+p_num os_attr_height(const p_str& path, Perun2Process& p2)
 {
-   const MediaAttributes media = os_ffmpegAttributes(path);
+   const MediaAttributes media = os_mediaAttributes(path, p2);
    return media.height;
 }
 
-p_per os_attr_duration(const p_str& path)
+p_per os_attr_duration(const p_str& path, Perun2Process& p2)
 {
-   const MediaAttributes media = os_ffmpegAttributes(path);
+   const MediaAttributes media = os_mediaAttributes(path, p2);
    return media.duration;
 }
 
@@ -396,11 +397,93 @@ static p_str os_toWideString(const std::string& str)
    return p_str(buffer.begin(), buffer.end());
 }
 
-MediaAttributes os_ffmpegAttributes(const p_str& filePath)
+MediaAttributes os_mediaAttributes(const p_str& path, Perun2Process& p2)
+{
+   p_nint size;
+   uint64_t modification;
+
+   return os_fileStamp(path, size, modification)
+      ? os_mediaAttributes(path, size, modification, p2)
+      : MediaAttributes();
+}
+
+MediaAttributes os_mediaAttributes(const p_str& path, const p_nint size, const uint64_t modification, Perun2Process& p2)
+{
+   const SystemCallScope call(SystemCall::sc_MediaAttributes);
+
+   const MediaExtension extension = classifyMediaExtension(os_extension(path));
+
+   if (extension == MediaExtension::me_Other) {
+      p2.mediaStats.skippedByExtension++;
+      return MediaAttributes();
+   }
+
+   MediaInfo info;
+
+   if (p2.mediaCache.get(path, size, modification, info)) {
+      p2.mediaStats.readFromCache++;
+   }
+   else {
+      info = os_probeMedia(path, extension, p2.mediaStats);
+      p2.mediaCache.put(path, size, modification, info);
+   }
+
+   MediaAttributes result;
+
+   switch (info.kind) {
+      case MediaKind::mk_Image: {
+         result.isImage = true;
+         result.width = info.width;
+         result.height = info.height;
+         break;
+      }
+      case MediaKind::mk_Video: {
+         result.isVideo = true;
+         result.width = info.width;
+         result.height = info.height;
+         result.duration = os_ffmpegPeriod(info.duration);
+         break;
+      }
+      default: {
+         break;
+      }
+   }
+
+   return result;
+}
+
+static MediaInfo os_probeMedia(const p_str& path, const MediaExtension extension, MediaStats& stats)
+{
+   // headers of video containers do not tell enough
+   if (extension != MediaExtension::me_Video) {
+      std::string header;
+      MediaInfo result;
+
+      if (!os_readFileStart(path, header, MEDIA_HEADER_SIZE)) {
+         return result;
+      }
+
+      if (probeMediaHeader(header.data(), header.size(), result) == MediaHeader::mh_Image) {
+         stats.readFromHeader++;
+         return result;
+      }
+
+      // a file without a known extension goes to FFmpeg only if it starts like some media
+      if (extension == MediaExtension::me_Unknown && !hasMediaSignature(header.data(), header.size())) {
+         stats.skippedBySignature++;
+         return result;
+      }
+   }
+
+   stats.openedByFfmpeg++;
+   return os_ffmpegMedia(path);
+}
+
+static MediaInfo os_ffmpegMedia(const p_str& filePath)
 {
    const std::string path = os_toUtf8(filePath);
    AVFormatContext* formatCtx = nullptr;
-   MediaAttributes result;
+   MediaInfo result;
 
    if (avformat_open_input(&formatCtx, path.c_str(), nullptr, nullptr) != 0) {
       return result;
@@ -439,17 +522,17 @@ MediaAttributes os_ffmpegAttributes(const p_str& filePath)
 
    if (hasAudio) {
       if (os_isFfmpegVideoFormat(formatCtx->iformat->name)) {
-         result.isVideo = true;
+         result.kind = MediaKind::mk_Video;
          result.width = static_cast<int64_t>(codecParams->width);
          result.height = static_cast<int64_t>(codecParams->height);
-         result.duration = os_ffmpegPeriod(formatCtx->duration);
+         result.duration = formatCtx->duration;
          avformat_close_input(&formatCtx);
          return result;
       }
    }
    else {
       if (os_isFfmpegImageFormat(formatCtx->iformat->name)) {
-         result.isImage = true;
+         result.kind = MediaKind::mk_Image;
          result.width = static_cast<int64_t>(codecParams->width);
          result.height = static_cast<int64_t>(codecParams->height);
          avformat_close_input(&formatCtx);
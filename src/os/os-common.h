@@ -16,16 +16,12 @@
 
 #include "..\datatype\incr-constr.h"
 #include "..\attribute.h"
+#include "..\media.h"
 
 
 namespace perun2
 {
 
-// while sleeping
-// check every 300 ms if the program received an interruption signal
-p_constexpr p_nint OS_SLEEP_UNIT = NINT_300;
-
-
 p_tim os_yesterday();
 p_tim os_tomorrow();
 void os_sleepForMs(const p_nint ms, Perun2Process& p2);
@@ -52,11 +48,16 @@ struct MediaAttributes
     p_per duration;
 };
 
-p_bool os_attr_isImage(const p_str& path);
-p_bool os_attr_isVideo(const p_str& path);
-p_num os_attr_width(const p_str& path);
-p_num os_attr_height(const p_str& path);
-p_per os_attr_duration(const p_str& path);
+p_bool os_attr_isImage(const p_str& path, Perun2Process& p2);
+p_bool os_attr_isVideo(const p_str& path, Perun2Process& p2);
+p_num os_attr_width(const p_str& path, Perun2Process& p2);
+p_num os_attr_height(const p_str& path, Perun2Process& p2);
+p_per os_attr_duration(const p_str& path, Perun2Process& p2);
+
+// metadata of an image or a video comes from the cache, from the header of the file or from FFmpeg
+// the last one is used only if the previous ones were not enough
+MediaAttributes os_mediaAttributes(const p_str& path, Perun2Process& p2);
+MediaAttributes os_mediaAttributes(const p_str& path, const p_nint size, const uint64_t modification, Perun2Process& p2);
 
 p_bool os_bothAreSeparators(const p_char left, const p_char right);
 p_str os_softTrim(const p_str& value);
@@ -66,7 +67,8 @@ p_str os_makeArg(const p_str& value);
 p_str os_quoteEmbraced(const p_str& value);
 
 static p_str os_toWideString(const std::string& str);
-MediaAttributes os_ffmpegAttributes(const p_str& filePath);
+static MediaInfo os_probeMedia(const p_str& path, const MediaExtension extension, MediaStats& stats);
+static MediaInfo os_ffmpegMedia(const p_str& filePath);
 static p_per os_ffmpegPeriod(const int64_t units);
 static bool os_isFfmpegVideoFormat(const std::string& value);
 static bool os_isFfmpegImageFormat(const std::string& value);
@@ -30,7 +30,10 @@
 #include <shellapi.h>
 #include <shlwapi.h>
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <fstream>
+#include <thread>
 #include <combaseapi.h>
 #include <fcntl.h>
 #include <setupapi.h>
@@ -52,6 +55,16 @@ void os_deinit()
    // nothing as expected
 }
 
+void os_initThread()
+{
+   CoInitializeEx(0, COINIT_MULTITHREADED);
+}
+
+void os_deinitThread()
+{
+   CoUninitialize();
+}
+
 p_tim os_now()
 {
    time_t raw;
@@ -79,6 +92,8 @@ void os_rawSleepForMs(const p_nint ms)
 // explanation of attributes is in file 'attribute.h'
 void os_loadAttributes(FileContext& context)
 {
+   const SystemCallScope call(SystemCall::sc_LoadAttributes);
+
    const p_attrptr& attribute = context.attribute;
    context.trimmed = os_trim(context.this_->value);
    context.invalid = os_isInvalid(context.trimmed);
@@ -273,19 +288,30 @@ void os_loadAttributes(FileContext& context)
    }
    
    if (attribute->has(ATTR_IMAGE_OR_VIDEO)) {
-      const MediaAttributes media = os_ffmpegAttributes(context.v_path->value);
+      const MediaAttributes media = context.v_exists->value && context.v_isfile->value
+         ? os_mediaAttributes(context.v_path->value,
+            static_cast<p_nint>(os_bigInteger(data.nFileSizeLow, data.nFileSizeHigh)),
+            os_bigInteger(data.ftLastWriteTime.dwLowDateTime, data.ftLastWriteTime.dwHighDateTime),
+            attribute->perun2)
+         : MediaAttributes();
       context.v_isimage->value = media.isImage;
       context.v_isvideo->value = media.isVideo;
       context.v_width->value = media.width;
       context.v_height->value = media.height;
       context.v_duration->value = media.duration;
    }
+
+   if (attribute->has(ATTR_HASH) || attribute->has(ATTR_CRC32)) {
+      os_loadContentHash(context);
+   }
 }
 
 // load attributes, but we already have some data
 // we do not need to read it again from the file system
 void os_loadDataAttributes(FileContext& context, const p_fdata& data)
 {
+   const SystemCallScope call(SystemCall::sc_LoadDataAttributes);
+
    const p_attrptr& attribute = context.attribute;
    context.trimmed = os_trim(context.this_->value);
    context.invalid = false;
@@ -406,13 +432,22 @@ void os_loadDataAttributes(FileContext& context, const p_fdata& data)
    }
 
    if (attribute->has(ATTR_IMAGE_OR_VIDEO)) {
-      const MediaAttributes media = os_ffmpegAttributes(context.v_path->value);
+      const MediaAttributes media = context.v_isfile->value
+         ? os_mediaAttributes(context.v_path->value,
+            static_cast<p_nint>(os_bigInteger(data.nFileSizeLow, data.nFileSizeHigh)),
+            os_bigInteger(data.ftLastWriteTime.dwLowDateTime, data.ftLastWriteTime.dwHighDateTime),
+            attribute->perun2)
+         : MediaAttributes();
       context.v_isimage->value = media.isImage;
       context.v_isvideo->value = media.isVideo;
       context.v_width->value = media.width;
       context.v_height->value = media.height;
       context.v_duration->value = media.duration;
    }
+
+   if (attribute->has(ATTR_HASH) || attribute->has(ATTR_CRC32)) {
+      os_loadContentHash(context);
+   }
 }
 
 p_tim os_access(const p_str& path)
@@ -884,6 +919,8 @@ p_bool os_sizeDirectorySatisfies(const p_str& path, IncrementalConstraint& const
 
 p_bool os_exists(const p_str& path)
 {
+   const SystemCallScope call(SystemCall::sc_Exists);
+
    if (!os_isAbsolute(path)) {
       return false;
    }
@@ -893,6 +930,8 @@ p_bool os_exists(const p_str& path)
 
 p_bool os_fileExists(const p_str& path)
 {
+   const SystemCallScope call(SystemCall::sc_FileExists);
+
    if (!os_isAbsolute(path)) {
       return false;
    }
@@ -903,6 +942,8 @@ p_bool os_fileExists(const p_str& path)
 
 p_bool os_directoryExists(const p_str& path)
 {
+   const SystemCallScope call(SystemCall::sc_DirectoryExists);
+
    if (!os_isAbsolute(path)) {
       return false;
    }
@@ -914,12 +955,16 @@ p_bool os_directoryExists(const p_str& path)
 
 p_bool os_hasFirstFile(const p_str& path, p_entry& entry, p_fdata& output)
 {
+   const SystemCallScope call(SystemCall::sc_HasFirstFile);
+
    entry = FindFirstFileEx(P_WINDOWS_PATH(path), FindExInfoBasic, &output, FindExSearchNameMatch, NULL, FIND_FIRST_EX_LARGE_FETCH); 
    return entry != INVALID_HANDLE_VALUE;
 }
 
 p_bool os_hasNextFile(p_entry& entry, p_fdata& output)
 {
+   const SystemCallScope call(SystemCall::sc_HasNextFile);
+
    return FindNextFile(entry, &output);
 }
 
@@ -936,6 +981,8 @@ void os_closeEntry(p_entry& entry)
 
 p_bool os_delete(const p_str& path)
 {
+   const SystemCallScope call(SystemCall::sc_Delete);
+
    p_char wszFrom[MAX_PATH] = { 0 };
    wcscpy(wszFrom, path.c_str());
    CopyMemory(wszFrom + lstrlenW(wszFrom), "\0\0", 2);
@@ -952,6 +999,8 @@ p_bool os_delete(const p_str& path)
 
 p_bool os_drop(const p_str& path, Perun2Process& p2)
 {
+   const SystemCallScope call(SystemCall::sc_Drop);
+
    return os_isFile(path)
       ? os_dropFile(path)
       : os_dropDirectory(path, p2);
@@ -959,6 +1008,8 @@ p_bool os_drop(const p_str& path, Perun2Process& p2)
 
 p_bool os_drop(const p_str& path, const p_bool isFile, Perun2Process& p2)
 {
+   const SystemCallScope call(SystemCall::sc_Drop);
+
    return isFile
       ? os_dropFile(path)
       : os_dropDirectory(path, p2);
@@ -969,77 +1020,172 @@ p_bool os_dropFile(const p_str& path)
    return DeleteFileW(P_WINDOWS_PATH(path)) != 0;
 }
 
-p_bool os_dropDirectory(const p_str& path, Perun2Process& p2)
+static p_bool dropTree(const p_str& path, const CancellationToken* cancellation)
 {
-   p_entry hFind;
-   p_fdata FindFileData;
+   std::vector<p_str> directories;
+   std::vector<TreeFile> files;
+
+   if (!os_listTree(path, directories, files, cancellation)) {
+      return false;
+   }
 
-   p_char DirPath[MAX_PATH];
-   p_char FileName[MAX_PATH];
+   const p_bool dropped = os_forEachTreeFile(files, [&path](const TreeFile& file) {
+      const p_str filePath = str(path, OS_SEPARATOR, file.path);
 
-   wcscpy(DirPath, const_cast<p_char*>(path.c_str()));
-   wcscat(DirPath, str(OS_SEPARATOR, CHAR_ASTERISK).c_str());
-   wcscpy(FileName, const_cast<p_char*>(path.c_str()));
-   wcscat(FileName, toStr(OS_SEPARATOR).c_str());
+      if (file.readOnly) {
+         os_unlock(filePath);
+      }
+
+      return DeleteFileW(P_WINDOWS_PATH(filePath)) != 0;
+   }, cancellation);
 
-   if (!os_hasFirstFile(DirPath, hFind, FindFileData)) {
+   if (!dropped) {
       return false;
    }
 
-   wcscpy(DirPath, FileName);
+   // the deepest directories go first
+   for (auto it = directories.rbegin(); it != directories.rend(); it++) {
+      if (cancellation != nullptr && cancellation->isCancelled()) {
+         return false;
+      }
+
+      const p_str dirPath = str(path, OS_SEPARATOR, *it);
+      RemoveDirectoryW(P_WINDOWS_PATH(dirPath));
+   }
+
+   return RemoveDirectoryW(const_cast<p_char*>(P_WINDOWS_PATH(path))) != 0;
+}
+
+p_bool os_dropDirectory(const p_str& path, Perun2Process& p2)
+{
+   return dropTree(path, &p2.cancellation);
+}
+
+p_bool os_dropIncompleteDirectory(const p_str& path)
+{
+   return dropTree(path, nullptr);
+}
+
+p_bool os_listTree(const p_str& root, std::vector<p_str>& directories, std::vector<TreeFile>& files,
+   const CancellationToken* cancellation)
+{
+   // index of the directory in the vector 'directories', that is going to be listed next
+   // the root itself is not there, so it is listed first
+   p_size next = 0;
+   p_bool isRoot = true;
+
+   while (isRoot || next < directories.size()) {
+      const p_str relative = isRoot ? p_str() : directories[next];
+      const p_str prefix = isRoot ? p_str() : str(relative, OS_SEPARATOR);
+      const p_str pattern = isRoot
+         ? str(root, OS_SEPARATOR, CHAR_ASTERISK)
+         : str(root, OS_SEPARATOR, relative, OS_SEPARATOR, CHAR_ASTERISK);
+
+      if (isRoot) {
+         isRoot = false;
+      }
+      else {
+         next++;
+      }
+
+      p_entry handle;
+      p_fdata data;
+
+      if (!os_hasFirstFile(pattern, handle, data)) {
+         return false;
+      }
 
-   p_bool bSearch = true;
-   while (bSearch) {
-      if (os_hasNextFile(hFind, FindFileData)) {
-         if (p2.isNotRunning()) {
-            os_closeEntry(hFind);
+      do {
+         if (cancellation != nullptr && cancellation->isCancelled()) {
+            os_closeEntry(handle);
             return false;
          }
 
-         const p_str v = FindFileData.cFileName;
+         const p_str v = data.cFileName;
 
          if (os_isBrowsePath(v)) {
             continue;
          }
 
-         wcscat(FileName,FindFileData.cFileName);
-         if ((FindFileData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
-            if (!os_dropDirectory(FileName, p2)) {
-               os_closeEntry(hFind);
-               return false;
-            }
-
-            RemoveDirectoryW(FileName);
-            wcscpy(FileName,DirPath);
+         if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+            directories.emplace_back(str(prefix, v));
          }
          else {
-            if (FindFileData.dwFileAttributes & FILE_ATTRIBUTE_READONLY)
-               os_unlock(FileName);
+            files.push_back({ str(prefix, v),
+               static_cast<p_nint>(os_bigInteger(data.nFileSizeLow, data.nFileSizeHigh)),
+               (data.dwFileAttributes & FILE_ATTRIBUTE_READONLY) != 0 });
+         }
+      }
+      while (os_hasNextFile(handle, data));
 
-            if (!DeleteFileW(FileName)) {
-               os_closeEntry(hFind);
-               return false;
-            }
+      const p_bool finished = GetLastError() == ERROR_NO_MORE_FILES;
+      os_closeEntry(handle);
 
-            wcscpy(FileName,DirPath);
-         }
+      if (!finished) {
+         return false;
       }
-      else {
-         if (GetLastError() == ERROR_NO_MORE_FILES)
-            bSearch = false;
-         else {
-            os_closeEntry(hFind);
+   }
+
+   return true;
+}
+
+p_bool os_forEachTreeFile(const std::vector<TreeFile>& files, const std::function<p_bool(const TreeFile&)>& action,
+   const CancellationToken* cancellation)
+{
+   if (files.size() < OS_TREE_PARALLEL_MINIMUM) {
+      for (const TreeFile& file : files) {
+         if ((cancellation != nullptr && cancellation->isCancelled()) || !action(file)) {
             return false;
          }
       }
+
+      return true;
    }
-   os_closeEntry(hFind);
 
-   return RemoveDirectoryW(const_cast<p_char*>(P_WINDOWS_PATH(path))) != 0;
+   // time of these operations is spent mostly on waiting for the file system
+   // so many of them at once are faster, even on a single disk
+   std::atomic<p_size> next(0);
+   std::atomic<p_bool> failed(false);
+
+   auto work = [&]() {
+      while (!failed.load(std::memory_order_relaxed)) {
+         const p_size index = next.fetch_add(1, std::memory_order_relaxed);
+
+         if (index >= files.size()) {
+            return;
+         }
+
+         if ((cancellation != nullptr && cancellation->isCancelled()) || !action(files[index])) {
+            failed.store(true, std::memory_order_relaxed);
+            return;
+         }
+      }
+   };
+
+   const p_size count = std::min<p_size>(OS_TREE_WORKERS,
+      std::max<p_size>(std::thread::hardware_concurrency(), 2));
+
+   std::vector<std::thread> workers;
+   workers.reserve(count - 1);
+
+   for (p_size i = 1; i < count; i++) {
+      workers.emplace_back(work);
+   }
+
+   // the calling thread is one of workers
+   work();
+
+   for (std::thread& w : workers) {
+      w.join();
+   }
+
+   return !failed.load();
 }
 
 p_bool os_hide(const p_str& path)
 {
+   const SystemCallScope call(SystemCall::sc_Hide);
+
    const DWORD attr = GetFileAttributesW(P_WINDOWS_PATH(path));
 
    if (attr == INVALID_FILE_ATTRIBUTES) {
@@ -1055,6 +1201,8 @@ p_bool os_hide(const p_str& path)
 
 p_bool os_lock(const p_str& path)
 {
+   const SystemCallScope call(SystemCall::sc_Lock);
+
    const DWORD attr = GetFileAttributesW(P_WINDOWS_PATH(path));
 
    if (attr == INVALID_FILE_ATTRIBUTES) {
@@ -1070,12 +1218,16 @@ p_bool os_lock(const p_str& path)
 
 p_bool os_open(const p_str& path)
 {
+   const SystemCallScope call(SystemCall::sc_Open);
+
    const p_str location = os_parent(path);
    return (INT_PTR)ShellExecuteW(0, 0, P_WINDOWS_PATH(path), 0, P_WINDOWS_PATH(location) , SW_SHOW) > 32;
 }
 
 p_bool os_openAsCommand(const p_str& command, const p_str& location)
 {
+   const SystemCallScope call(SystemCall::sc_OpenAsCommand);
+
    STARTUPINFO si;
    PROCESS_INFORMATION pi;
 
@@ -1101,6 +1253,8 @@ p_bool os_openAsCommand(const p_str& command, const p_str& location)
 
 p_bool os_unhide(const p_str& path)
 {
+   const SystemCallScope call(SystemCall::sc_Unhide);
+
    const DWORD attr = GetFileAttributesW(P_WINDOWS_PATH(path));
 
    if (attr == INVALID_FILE_ATTRIBUTES) {
@@ -1116,6 +1270,8 @@ p_bool os_unhide(const p_str& path)
 
 p_bool os_unlock(const p_str& path)
 {
+   const SystemCallScope call(SystemCall::sc_Unlock);
+
    const DWORD attr = GetFileAttributesW(P_WINDOWS_PATH(path));
 
    if (attr == INVALID_FILE_ATTRIBUTES) {
@@ -1133,6 +1289,8 @@ p_bool os_unlock(const p_str& path)
 p_bool os_setTime(const p_str& path, const p_tim& creation,
    const p_tim& access, const p_tim& modification)
 {
+   const SystemCallScope call(SystemCall::sc_SetTime);
+
    p_ftim time_c;
    p_ftim time_a;
    p_ftim time_m;
@@ -1159,6 +1317,8 @@ p_bool os_setTime(const p_str& path, const p_tim& creation,
 
 p_bool os_createFile(const p_str& path)
 {
+   const SystemCallScope call(SystemCall::sc_CreateFile);
+
    if (os_hasParentDirectory(path)) {
       const p_str p = os_parent(path);
       if (!os_exists(p)) {
@@ -1191,6 +1351,8 @@ p_bool os_createFile(const p_str& path)
 
 p_bool os_createDirectory(const p_str& path)
 {
+   const SystemCallScope call(SystemCall::sc_CreateDirectory);
+
    if (os_hasParentDirectory(path)) {
       const p_str p = os_parent(path);
       if (!os_exists(p)) {
@@ -1209,13 +1371,17 @@ p_bool os_createDirectory(const p_str& path)
 
 p_bool os_moveTo(const p_str& oldPath, const p_str& newPath)
 {
+   const SystemCallScope call(SystemCall::sc_MoveTo);
+
    return MoveFileExW(P_WINDOWS_PATH(oldPath), P_WINDOWS_PATH(newPath), MOVEFILE_COPY_ALLOWED) != 0;
 }
 
 p_bool os_copyTo(const p_str& oldPath, const p_str& newPath, const p_bool isFile, Perun2Process& p2)
 {
+   const SystemCallScope call(SystemCall::sc_CopyTo);
+
    if (isFile) {
-      return os_copyToFile(oldPath, newPath);
+      return os_copyToFile(oldPath, newPath, p2);
    }
 
    if (os_isAncestor(oldPath, newPath)) {
@@ -1223,92 +1389,85 @@ p_bool os_copyTo(const p_str& oldPath, const p_str& newPath, const p_bool isFile
    }
 
    const p_bool success = os_copyToDirectory(oldPath, newPath, p2);
-   if (!success && p2.isNotRunning() && os_directoryExists(newPath)) {
+   if (!success && p2.cancellation.isCancelled() && os_directoryExists(newPath)) {
       // if directory copy operation
       // was stopped by the user
       // delete recent partially copied directory if it is there
-      os_dropDirectory(newPath, p2);
+      os_dropIncompleteDirectory(newPath);
    }
 
    return success;
 }
 
-p_bool os_copyToFile(const p_str& oldPath, const p_str& newPath)
+// called by the system after every copied chunk of a file
+// if Perun2 has been stopped, the copy is cancelled and its incomplete result is deleted
+static DWORD CALLBACK os_copyProgress(LARGE_INTEGER totalSize, LARGE_INTEGER totalTransferred,
+   LARGE_INTEGER streamSize, LARGE_INTEGER streamTransferred, DWORD streamNumber,
+   DWORD callbackReason, HANDLE sourceFile, HANDLE destinationFile, LPVOID data)
 {
-   return CopyFileW(P_WINDOWS_PATH(oldPath), P_WINDOWS_PATH(newPath), true) != 0;
+   const Perun2Process* p2 = static_cast<const Perun2Process*>(data);
+   return p2->cancellation.isCancelled()
+      ? PROGRESS_CANCEL
+      : PROGRESS_CONTINUE;
 }
 
-p_bool os_copyToDirectory(const p_str& oldPath, const p_str& newPath, Perun2Process& p2)
+// CopyFileExW clones blocks instead of copying data on file systems that support it (ReFS, Dev Drive)
+// very big files skip the system cache, so they do not push everything else out of memory
+static p_bool os_copyFileData(const p_str& oldPath, const p_str& newPath, const p_nint size, Perun2Process& p2)
 {
-   if (!os_createDirectory(newPath)) {
-      return false;
-   }
-
-   const p_size length = oldPath.size() + 1;
+   DWORD flags = COPY_FILE_FAIL_IF_EXISTS;
 
-   p_entry hFind;
-   p_fdata FindFileData;
-
-   p_char DirPath[MAX_PATH];
-   p_char FileName[MAX_PATH];
-
-   wcscpy(DirPath, const_cast<p_char*>(oldPath.c_str()));
-   wcscat(DirPath, str(OS_SEPARATOR, CHAR_ASTERISK).c_str());
-   wcscpy(FileName, const_cast<p_char*>(oldPath.c_str()));
-   wcscat(FileName, toStr(OS_SEPARATOR).c_str());
+   if (size >= OS_UNBUFFERED_COPY_SIZE) {
+      flags |= COPY_FILE_NO_BUFFERING;
+   }
 
-   if (!os_hasFirstFile(DirPath, hFind, FindFileData)) {
+   if (CopyFileExW(P_WINDOWS_PATH(oldPath), P_WINDOWS_PATH(newPath), os_copyProgress, &p2, NULL, flags) == 0) {
       return false;
    }
 
-   wcscpy(DirPath, FileName);
-
-   p_bool bSearch = true;
-   while (bSearch) {
-      if (os_hasNextFile(hFind, FindFileData)) {
-         if (p2.isNotRunning()) {
-            os_closeEntry(hFind);
-            return false;
-         }
+   // it may run on a worker thread, so the process is known from the argument
+   p2.systemStats.addBytesRead(static_cast<uint64_t>(size));
+   p2.systemStats.addBytesWritten(static_cast<uint64_t>(size));
+   return true;
+}
 
-         const p_str v = FindFileData.cFileName;
+p_bool os_copyToFile(const p_str& oldPath, const p_str& newPath, Perun2Process& p2)
+{
+   p_adata data;
+   if (!GetFileAttributesExW(P_WINDOWS_PATH(oldPath), GetFileExInfoStandard, &data)) {
+      return false;
+   }
 
-         if (os_isBrowsePath(v)) {
-            continue;
-         }
+   return os_copyFileData(oldPath, newPath,
+      static_cast<p_nint>(os_bigInteger(data.nFileSizeLow, data.nFileSizeHigh)), p2);
+}
 
-         wcscat(FileName, FindFileData.cFileName);
-         const p_str np = str(newPath, OS_SEPARATOR, p_str(FileName).substr(length));
+p_bool os_copyToDirectory(const p_str& oldPath, const p_str& newPath, Perun2Process& p2)
+{
+   if (!os_createDirectory(newPath)) {
+      return false;
+   }
 
-         if ((FindFileData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
-            if (!os_copyToDirectory(FileName, np, p2)) {
-               os_closeEntry(hFind);
-               return false;
-            }
+   std::vector<p_str> directories;
+   std::vector<TreeFile> files;
 
-            wcscpy(FileName, DirPath);
-         }
-         else {
-            if (!os_copyToFile(FileName, np)) {
-               os_closeEntry(hFind);
-               return false;
-            }
+   if (!os_listTree(oldPath, directories, files, &p2.cancellation)) {
+      return false;
+   }
 
-            wcscpy(FileName, DirPath);
-         }
-      }
-      else {
-         if (GetLastError() == ERROR_NO_MORE_FILES)
-            bSearch = false;
-         else {
-            os_closeEntry(hFind);
-            return false;
-         }
+   // the whole skeleton of directories is created first
+   // so files can be copied in any order
+   for (const p_str& dir : directories) {
+      if (p2.cancellation.isCancelled() || !os_createDirectory(str(newPath, OS_SEPARATOR, dir))) {
+         return false;
       }
    }
 
-   os_closeEntry(hFind);
-   return true;
+   // the size is already known from the directory listing
+   return os_forEachTreeFile(files, [&oldPath, &newPath, &p2](const TreeFile& file) {
+      return os_copyFileData(str(oldPath, OS_SEPARATOR, file.path),
+         str(newPath, OS_SEPARATOR, file.path), file.size, p2);
+   }, &p2.cancellation);
 }
 
 p_bool os_copy(const p_set& paths)
@@ -1359,20 +1518,21 @@ p_bool os_select(const p_str& parent, const p_set& paths)
    return hr == S_OK;
 }
 
-p_bool os_run(const p_str& command, const p_str& location, Perun2Process& p2)
+// the child is registered, so termination of Perun2 kills it
+static p_bool startProcess(const p_str& command, const p_str& location, p_process& process, Perun2Process& p2)
 {
-   p2.sideProcess.running = true;
    STARTUPINFO si;
+   PROCESS_INFORMATION info;
 
    ZeroMemory(&si, sizeof(si));
    si.cb = sizeof(si);
-   ZeroMemory(&p2.sideProcess.info, sizeof(p2.sideProcess.info));
+   ZeroMemory(&info, sizeof(info));
 
    std::unique_ptr<p_char[]> cmd = std::make_unique<p_char[]>(command.size() + 1);
    wcscpy(cmd.get(), command.c_str());
    cmd[command.size()] = CHAR_NULL;
 
-   CreateProcessW
+   const BOOL created = CreateProcessW
    (
       NULL,
       cmd.get(),
@@ -1380,20 +1540,162 @@ p_bool os_run(const p_str& command, const p_str& location, Perun2Process& p2)
       CREATE_NEW_PROCESS_GROUP | CREATE_NO_WINDOW,
       NULL,
       location.c_str(),
-      &si, &p2.sideProcess.info
+      &si, &info
    );
 
-   WaitForSingleObject(p2.sideProcess.info.hProcess, INFINITE);
+   if (! created) {
+      return false;
+   }
+
+   CloseHandle(info.hThread);
+
+   if (! p2.sideProcess.add(info.hProcess)) {
+      os_terminate(info.hProcess);
+      CloseHandle(info.hProcess);
+      return false;
+   }
+
+   process = info.hProcess;
+   return true;
+}
+
+p_bool os_run(const p_str& command, const p_str& location, Perun2Process& p2)
+{
+   const SystemCallScope call(SystemCall::sc_Run);
+   p_process process;
+   return startProcess(command, location, process, p2)
+      && os_endProcess(process, p2);
+}
+
+p_bool os_startProcess(const p_str& command, const p_str& location, p_process& process, Perun2Process& p2)
+{
+   const SystemCallScope call(SystemCall::sc_Run);
+   return startProcess(command, location, process, p2);
+}
+
+p_size os_awaitAnyProcess(const std::vector<p_process>& processes)
+{
+   const DWORD result = WaitForMultipleObjects(static_cast<DWORD>(processes.size()),
+      processes.data(), FALSE, INFINITE);
+
+   return result >= WAIT_OBJECT_0 && result < WAIT_OBJECT_0 + processes.size()
+      ? static_cast<p_size>(result - WAIT_OBJECT_0)
+      : 0;
+}
+
+p_bool os_endProcess(const p_process process, Perun2Process& p2)
+{
+   WaitForSingleObject(process, INFINITE);
    DWORD dwExitCode = 0;
-   ::GetExitCodeProcess(p2.sideProcess.info.hProcess, &dwExitCode);
+   ::GetExitCodeProcess(process, &dwExitCode);
+
+   p2.sideProcess.remove(process);
+   CloseHandle(process);
+   return p2.isRunning() && dwExitCode == 0;
+}
 
-   p2.sideProcess.running = false;
-   return p2.state == State::s_Running && dwExitCode == 0;
+p_bool os_terminate(const p_process process)
+{
+   return TerminateProcess(process, 0) != 0;
 }
 
-p_bool os_terminate(SideProcess& process)
+static p_bool requestChanges(DirectoryWatch& watch)
 {
-   return TerminateProcess(process.info.hProcess, 0) != 0;
+   ZeroMemory(&watch.overlapped, sizeof(watch.overlapped));
+   watch.overlapped.hEvent = watch.changed;
+
+   watch.pending = ReadDirectoryChangesW(watch.directory, watch.buffer.get(),
+      static_cast<DWORD>(WATCH_BUFFER_SIZE), TRUE,
+      FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME
+         | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE,
+      NULL, &watch.overlapped, NULL) != 0;
+
+   return watch.pending;
+}
+
+p_bool os_startWatch(const p_str& path, DirectoryWatch& watch)
+{
+   watch.directory = CreateFileW(path.c_str(), FILE_LIST_DIRECTORY,
+      FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING,
+      FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, NULL);
+
+   if (watch.directory == INVALID_HANDLE_VALUE) {
+      return false;
+   }
+
+   watch.changed = CreateEventW(NULL, TRUE, FALSE, NULL);
+   watch.woken = CreateEventW(NULL, TRUE, FALSE, NULL);
+   watch.buffer = std::make_unique<DWORD[]>(WATCH_BUFFER_SIZE / sizeof(DWORD));
+
+   return watch.changed != NULL
+      && watch.woken != NULL
+      && requestChanges(watch);
+}
+
+WatchEvent os_awaitChange(DirectoryWatch& watch, const p_int timeout)
+{
+   const HANDLE events[] = { watch.woken, watch.changed };
+   const DWORD result = WaitForMultipleObjects(2, events, FALSE,
+      timeout == WATCH_FOREVER ? INFINITE : static_cast<DWORD>(timeout));
+
+   switch (result) {
+      case WAIT_OBJECT_0: {
+         return WatchEvent::we_Woken;
+      }
+      case WAIT_OBJECT_0 + 1: {
+         DWORD bytes = 0;
+         watch.pending = false;
+
+         // names of changed files are not needed, the script runs again anyway
+         // zero bytes mean an overflow of the buffer, which is a change as well
+         if (! GetOverlappedResult(watch.directory, &watch.overlapped, &bytes, FALSE)) {
+            return WatchEvent::we_Failure;
+         }
+
+         ResetEvent(watch.changed);
+
+         return requestChanges(watch)
+            ? WatchEvent::we_Change
+            : WatchEvent::we_Failure;
+      }
+      case WAIT_TIMEOUT: {
+         return WatchEvent::we_Timeout;
+      }
+      default: {
+         return WatchEvent::we_Failure;
+      }
+   }
+}
+
+void os_wakeWatch(DirectoryWatch& watch)
+{
+   SetEvent(watch.woken);
+}
+
+void os_stopWatch(DirectoryWatch& watch)
+{
+   if (watch.directory != INVALID_HANDLE_VALUE) {
+      if (watch.pending) {
+         // the request has to end, before its buffer is released
+         DWORD bytes = 0;
+         CancelIoEx(watch.directory, &watch.overlapped);
+         GetOverlappedResult(watch.directory, &watch.overlapped, &bytes, TRUE);
+         watch.pending = false;
+      }
+
+      CloseHandle(watch.directory);
+      watch.directory = INVALID_HANDLE_VALUE;
+   }
+
+   if (watch.changed != NULL) {
+      CloseHandle(watch.changed);
+      watch.changed = NULL;
+   }
+
+   if (watch.woken != NULL) {
+      CloseHandle(watch.woken);
+      watch.woken = NULL;
+   }
 }
 
 p_bool os_popup(const p_str& text)
@@ -2447,31 +2749,273 @@ p_str os_downloadsPath()
    }
 }
 
-p_size os_readFileSize(const p_str& path)
+p_str os_scriptCachePath()
 {
-   struct _stat fileinfo;
-   _wstat(path.c_str(), &fileinfo);
-   return fileinfo.st_size;
+   p_char path[MAX_PATH];
+   return SHGetSpecialFolderPathW(0, path, CSIDL_LOCAL_APPDATA, FALSE)
+      ? str(path, OS_SEPARATOR, metadata::NAME, OS_SEPARATOR, STRING_CACHE)
+      : p_str();
 }
 
 p_bool os_readFile(p_str& result, const p_str& path)
 {
-   FILE* f = _wfopen(path.c_str(), STRING_FILE_OPEN_MODE);
+   const SystemCallScope call(SystemCall::sc_ReadFile);
+
+   MappedFile file;
+   if (!os_mapFile(file, path)) {
+      return false;
+   }
+
+   // characters are decoded straight from the mapped memory
+   // so the file content is never copied into an intermediate buffer
+   TextDecoder decoder(file.data, file.size);
+   decoder.rest(result);
+   os_unmapFile(file);
+   return true;
+}
+
+p_bool os_readFileStart(const p_str& path, std::string& result, const p_size limit)
+{
+   const SystemCallScope call(SystemCall::sc_ReadFileStart);
+
+   if (limit == 0) {
+      result.clear();
+      return true;
+   }
+
+   HANDLE file = CreateFileW(P_WINDOWS_PATH(path), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+      NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+   if (file == INVALID_HANDLE_VALUE) {
+      return false;
+   }
+
+   result.resize(limit);
+   DWORD read = 0;
+   const p_bool success = ReadFile(file, &result[0], static_cast<DWORD>(limit), &read, NULL);
+   CloseHandle(file);
+
+   result.resize(success ? static_cast<p_size>(read) : 0);
+   SystemStats::countRead(result.size());
+   return success;
+}
+
+// some files cannot be mapped, but can still be read in the usual way
+static p_bool os_readMappedFallback(MappedFile& result)
+{
+   if (result.mapping != NULL) {
+      CloseHandle(result.mapping);
+      result.mapping = NULL;
+   }
+
+   result.buffer.resize(result.size);
+   p_size position = 0;
+
+   while (position < result.size) {
+      const DWORD part = static_cast<DWORD>(std::min<p_size>(result.size - position, OS_FILE_READ_PART));
+      DWORD read = 0;
+
+      if (!ReadFile(result.file, &result.buffer[position], part, &read, NULL)) {
+         return false;
+      }
+
+      // the file has been truncated in the meantime
+      if (read == 0) {
+         break;
+      }
+
+      position += read;
+   }
+
+   result.buffer.resize(position);
+   result.size = position;
+   result.data = result.buffer.data();
+   return true;
+}
+
+p_bool os_mapFile(MappedFile& result, const p_str& path)
+{
+   const SystemCallScope call(SystemCall::sc_MapFile);
+
+   // files open for writing by other programs (logs...) can be read too
+   // while the view exists, they can grow, but cannot be truncated
+   result.file = CreateFileW(P_WINDOWS_PATH(path), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+      NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+
+   if (result.file == INVALID_HANDLE_VALUE) {
+      return false;
+   }
+
+   LARGE_INTEGER size;
+
+   if (!GetFileSizeEx(result.file, &size)) {
+      os_unmapFile(result);
+      return false;
+   }
+
+   result.size = static_cast<p_size>(size.QuadPart);
+
+   if (result.size == 0) {
+      // empty file cannot be mapped
+      // but it is still a valid file with no content
+      return true;
+   }
+
+   result.mapping = CreateFileMappingW(result.file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+   if (result.mapping != NULL) {
+      result.data = static_cast<const char*>(MapViewOfFile(result.mapping, FILE_MAP_READ, 0, 0, 0));
+   }
+
+   if (result.data == nullptr && !os_readMappedFallback(result)) {
+      os_unmapFile(result);
+      return false;
+   }
+
+   // the whole mapped file is counted, even if only its part is going to be read
+   SystemStats::countRead(result.size);
+
+   return true;
+}
+
+void os_unmapFile(MappedFile& file)
+{
+   // without the mapping, the view points to the buffer
+   if (file.data != nullptr && file.mapping != NULL) {
+      UnmapViewOfFile(file.data);
+   }
+
+   file.data = nullptr;
+   file.buffer.clear();
+   file.buffer.shrink_to_fit();
+
+   if (file.mapping != NULL) {
+      CloseHandle(file.mapping);
+      file.mapping = NULL;
+   }
+
+   if (file.file != INVALID_HANDLE_VALUE) {
+      CloseHandle(file.file);
+      file.file = INVALID_HANDLE_VALUE;
+   }
+
+   file.size = 0;
+}
+
+p_entry os_createDaemonPipe(const p_bool first)
+{
+   // without this flag, another process could create the pipe before us and read scripts of clients
+   const DWORD mode = first
+      ? PIPE_ACCESS_DUPLEX | FILE_FLAG_FIRST_PIPE_INSTANCE
+      : PIPE_ACCESS_DUPLEX;
+
+   return CreateNamedPipeW(STRING_DAEMON_PIPE, mode,
+      PIPE_TYPE_MESSAGE | PIPE_READMODE_MESSAGE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+      PIPE_UNLIMITED_INSTANCES, OS_PIPE_BUFFER_SIZE, OS_PIPE_BUFFER_SIZE, 0, NULL);
+}
+
+p_bool os_daemonPipeExists()
+{
+   // fails with this error only if there is no instance of the pipe at all
+   return WaitNamedPipeW(STRING_DAEMON_PIPE, NMPWAIT_NOWAIT) != 0
+      || GetLastError() != ERROR_FILE_NOT_FOUND;
+}
+
+p_bool os_connectDaemonPipe(p_entry pipe)
+{
+   return ConnectNamedPipe(pipe, NULL) 
+      ? true
+      : GetLastError() == ERROR_PIPE_CONNECTED;
+}
+
+p_bool os_readPipeMessage(p_entry pipe, p_str& result)
+{
+   std::vector<char> bytes;
+   char buffer[OS_PIPE_BUFFER_SIZE];
+
+   while (true) {
+      DWORD read = 0;
+      const BOOL success = ReadFile(pipe, buffer, OS_PIPE_BUFFER_SIZE, &read, NULL);
+      bytes.insert(bytes.end(), buffer, buffer + read);
+
+      if (success) {
+         break;
+      }
+
+      // message is longer than the buffer
+      // so read its next part
+      if (GetLastError() != ERROR_MORE_DATA) {
+         return false;
+      }
+   }
+
+   result.assign(reinterpret_cast<const p_char*>(bytes.data()), bytes.size() / sizeof(p_char));
+   return true;
+}
+
+p_bool os_writePipeMessage(p_entry pipe, const p_str& value)
+{
+   const DWORD size = static_cast<DWORD>(value.size() * sizeof(p_char));
+   DWORD written = 0;
+   return WriteFile(pipe, value.c_str(), size, &written, NULL) && written == size;
+}
+
+void os_closeDaemonPipe(p_entry pipe)
+{
+   FlushFileBuffers(pipe);
+   DisconnectNamedPipe(pipe);
+   CloseHandle(pipe);
+}
+
+void os_wakeDaemonPipe()
+{
+   p_entry h = CreateFileW(STRING_DAEMON_PIPE, GENERIC_READ | GENERIC_WRITE, 0, NULL, OPEN_EXISTING, 0, NULL);
+
+   if (h != INVALID_HANDLE_VALUE) {
+      CloseHandle(h);
+   }
+}
+
+p_bool os_fileStamp(const p_str& path, p_nint& size, uint64_t& modification)
+{
+   p_adata data;
+
+   if (!GetFileAttributesExW(P_WINDOWS_PATH(path), GetFileExInfoStandard, &data)
+      || (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+   {
+      return false;
+   }
+
+   size = static_cast<p_nint>(os_bigInteger(data.nFileSizeLow, data.nFileSizeHigh));
+   modification = os_bigInteger(data.ftLastWriteTime.dwLowDateTime, data.ftLastWriteTime.dwHighDateTime);
+   return true;
+}
+
+p_bool os_writeBinaryFile(const p_str& path, const std::string& content)
+{
+   const p_str temporary = str(path, CHAR_DOT, toStr(GetCurrentProcessId()));
+
+   p_entry h = CreateFileW(P_WINDOWS_PATH(temporary), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
 
-   if (f == NULL) {
+   if (h == INVALID_HANDLE_VALUE) {
       return false;
    }
 
-   const p_size filesize = os_readFileSize(path);
+   DWORD written = 0;
+   const p_bool success = WriteFile(h, content.data(), static_cast<DWORD>(content.size()), &written, NULL)
+      && written == content.size();
+   CloseHandle(h);
 
-   if (filesize > 0) {
-      result.resize(filesize);
-      p_size wchars_read = fread(&(result.front()), sizeof(p_char), filesize, f);
-      result.resize(wchars_read);
-      result.shrink_to_fit();
+   if (!success) {
+      DeleteFileW(P_WINDOWS_PATH(temporary));
+      return false;
+   }
+
+   if (MoveFileExW(P_WINDOWS_PATH(temporary), P_WINDOWS_PATH(path), MOVEFILE_REPLACE_EXISTING) == 0) {
+      DeleteFileW(P_WINDOWS_PATH(temporary));
+      return false;
    }
 
-   fclose(f);
    return true;
 }
 
@@ -2480,28 +3024,150 @@ void os_showWebsite(const p_str& url)
    ShellExecuteW(NULL, STRING_OPEN, url.c_str(), NULL, NULL, SW_SHOWNORMAL);
 }
 
-p_bool os_findText(const p_str& path, const p_str& value)
+p_bool os_findText(const p_str& path, const TextSearch& search)
 {
-   std::wifstream stream(P_WINDOWS_PATH(path));
-   if (!stream) {
+   MappedFile file;
+   if (!os_mapFile(file, path)) {
       return false;
    }
-   else if (value.empty()) {
-      stream.close();
+
+   const p_bool result = search.isFoundIn(file.data, file.size);
+   os_unmapFile(file);
+   return result;
+}
+
+p_bool os_findAnyText(const p_str& path, MultiTextSearch& search)
+{
+   MappedFile file;
+   if (!os_mapFile(file, path)) {
+      return false;
+   }
+
+   const p_bool result = search.isAnyFoundIn(file.data, file.size);
+   os_unmapFile(file);
+   return result;
+}
+
+p_nint os_countText(const p_str& path, MultiTextSearch& search)
+{
+   MappedFile file;
+   if (!os_mapFile(file, path)) {
+      return 0;
+   }
+
+   const p_nint result = search.countIn(file.data, file.size);
+   os_unmapFile(file);
+   return result;
+}
+
+p_bool os_contentHash(const p_str& path, const p_bool hash, const p_bool crc32, ContentHash& result, Perun2Process& p2)
+{
+   const SystemCallScope call(SystemCall::sc_ContentHash);
+
+   p_adata data;
+   if (!GetFileAttributesExW(P_WINDOWS_PATH(path), GetFileExInfoStandard, &data)
+      || (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+   {
+      return false;
+   }
+
+   const p_nint size = static_cast<p_nint>(os_bigInteger(data.nFileSizeLow, data.nFileSizeHigh));
+   const uint64_t modification = os_bigInteger(data.ftLastWriteTime.dwLowDateTime, data.ftLastWriteTime.dwHighDateTime);
+
+   if (p2.hashCache.get(path, size, modification, result)
+      && (result.hasHash || !hash) && (result.hasCrc32 || !crc32))
+   {
       return true;
    }
 
-   p_str line;
-   p_bool result = false;
+   MappedFile file;
+   if (!os_mapFile(file, path)) {
+      return false;
+   }
 
-   while (std::getline(stream, line)) {
-      if (line.find(value) != p_str::npos) {
-         result = true;
-         break;
-      }
+   computeContentHash(file.data, file.size, hash, crc32, result);
+   os_unmapFile(file);
+   p2.hashCache.put(path, size, modification, result);
+   return true;
+}
+
+void os_loadContentHash(FileContext& context)
+{
+   const p_attrptr& attribute = context.attribute;
+   ContentHash hash;
+
+   const p_bool loaded = context.v_exists->value && context.v_isfile->value
+      && os_contentHash(context.v_path->value, attribute->has(ATTR_HASH),
+         attribute->has(ATTR_CRC32), hash, attribute->perun2);
+
+   if (attribute->has(ATTR_HASH)) {
+      context.v_hash->value = loaded ? hashToString(hash.hash) : p_str();
+   }
+
+   if (attribute->has(ATTR_CRC32)) {
+      context.v_crc32->value = loaded ? p_num(static_cast<p_nint>(hash.crc32)) : P_NaN;
    }
+}
+
+p_bool os_partialHash(const p_str& path, const p_size size, uint64_t& result)
+{
+   HANDLE file = CreateFileW(P_WINDOWS_PATH(path), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+      NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+   if (file == INVALID_HANDLE_VALUE) {
+      return false;
+   }
+
+   const p_bool entire = size <= 2 * HASH_PART_SIZE;
+   std::vector<char> buffer(entire ? size : 2 * HASH_PART_SIZE);
+   DWORD read = 0;
+   p_bool success = true;
+
+   if (entire) {
+      // the buffer of an empty file has no memory to read into
+      success = size == 0
+         || (ReadFile(file, buffer.data(), static_cast<DWORD>(size), &read, NULL)
+            && read == static_cast<DWORD>(size));
+   }
+   else {
+      LARGE_INTEGER offset;
+      offset.QuadPart = static_cast<LONGLONG>(size - HASH_PART_SIZE);
+
+      success = ReadFile(file, buffer.data(), static_cast<DWORD>(HASH_PART_SIZE), &read, NULL)
+         && read == static_cast<DWORD>(HASH_PART_SIZE)
+         && SetFilePointerEx(file, offset, NULL, FILE_BEGIN)
+         && ReadFile(file, buffer.data() + HASH_PART_SIZE, static_cast<DWORD>(HASH_PART_SIZE), &read, NULL)
+         && read == static_cast<DWORD>(HASH_PART_SIZE);
+   }
+
+   CloseHandle(file);
+
+   if (success) {
+      SystemStats::countRead(buffer.size());
+      result = xxHash64(buffer.data(), buffer.size());
+   }
+
+   return success;
+}
+
+p_bool os_sameContent(const p_str& path1, const p_str& path2)
+{
+   MappedFile file1;
+   if (!os_mapFile(file1, path1)) {
+      return false;
+   }
+
+   MappedFile file2;
+   if (!os_mapFile(file2, path2)) {
+      os_unmapFile(file1);
+      return false;
+   }
+
+   const p_bool result = file1.size == file2.size
+      && (file1.size == 0 || std::memcmp(file1.data, file2.data, file1.size) == 0);
 
-   stream.close();
+   os_unmapFile(file1);
+   os_unmapFile(file2);
    return result;
 }
 
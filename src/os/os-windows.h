@@ -15,8 +15,13 @@
 #pragma once
 
 #include "../side-process.h"
+#include "../cancellation.h"
 #include "../datatype/incr-constr.h"
 #include "../attribute.h"
+#include "../datatype/text/text-search.h"
+#include "../datatype/text/text-decode.h"
+#include "../content-hash.h"
+#include <functional>
 
 
 namespace perun2
@@ -28,6 +33,20 @@ namespace perun2
 p_constexpr p_char OS_SEPARATOR = CHAR_BACKSLASH;
 p_constexpr p_char OS_WRONG_SEPARATOR = CHAR_SLASH;
 
+// size of a single read or write on the daemon pipe
+p_constexpr DWORD OS_PIPE_BUFFER_SIZE = 4096;
+
+// files of this size or bigger are copied without the system cache
+p_constexpr p_nint OS_UNBUFFERED_COPY_SIZE = 256LL * 1024 * 1024;
+
+// files, that cannot be mapped into the memory, are read in parts of this size
+p_constexpr p_size OS_FILE_READ_PART = 1024 * 1024;
+
+// files of a directory tree are copied or deleted by this many threads at most
+p_constexpr p_size OS_TREE_WORKERS = 8;
+// smaller trees are not worth starting threads
+p_constexpr p_size OS_TREE_PARALLEL_MINIMUM = 64;
+
 
 // for Windows OS only
 // traditionally, it did not allow file paths to be longer than 260 characters
@@ -40,6 +59,10 @@ p_constexpr p_char OS_WRONG_SEPARATOR = CHAR_SLASH;
 void os_init();
 void os_deinit();
 
+// every additional thread that runs Perun2 code has to call these
+void os_initThread();
+void os_deinitThread();
+
 p_tim os_now();
 p_tim os_today();
 
@@ -89,6 +112,9 @@ p_bool os_drop(const p_str& path, Perun2Process& p2);
 p_bool os_drop(const p_str& path, const p_bool isFile, Perun2Process& p2);
 p_bool os_dropFile(const p_str& path);
 p_bool os_dropDirectory(const p_str& path, Perun2Process& p2);
+// remove what is left by an operation that has been stopped
+// it cannot be stopped itself, so it works even after Perun2 is cancelled
+p_bool os_dropIncompleteDirectory(const p_str& path);
 p_bool os_hide(const p_str& path);
 p_bool os_lock(const p_str& path);
 p_bool os_open(const p_str& path);
@@ -104,14 +130,24 @@ p_bool os_createDirectory(const p_str& path);
 
 p_bool os_moveTo(const p_str& oldPath, const p_str& newPath);
 p_bool os_copyTo(const p_str& oldPath, const p_str& newPath, const p_bool isFile, Perun2Process& p2);
-p_bool os_copyToFile(const p_str& oldPath, const p_str& newPath);
+p_bool os_copyToFile(const p_str& oldPath, const p_str& newPath, Perun2Process& p2);
 p_bool os_copyToDirectory(const p_str& oldPath, const p_str& newPath, Perun2Process& p2);
 
 p_bool os_copy(const p_set& paths);
 p_bool os_select(const p_str& parent, const p_set& paths);
 
+// start a child process and wait until it finishes
 p_bool os_run(const p_str& command, const p_str& location, Perun2Process& p2);
-p_bool os_terminate(SideProcess& process);
+
+// the same in steps, so many children can run at once
+// every started process has to be ended with os_endProcess()
+p_bool os_startProcess(const p_str& command, const p_str& location, p_process& process, Perun2Process& p2);
+// return the index of a finished process
+p_size os_awaitAnyProcess(const std::vector<p_process>& processes);
+// return true, if the process succeeded
+p_bool os_endProcess(const p_process process, Perun2Process& p2);
+
+p_bool os_terminate(const p_process process);
 
 p_bool os_popup(const p_str& text);
 
@@ -175,10 +211,119 @@ p_list os_pendrives();
 p_str os_currentPath();
 p_str os_system32Path();
 p_str os_downloadsPath();
+p_str os_scriptCachePath();
 
+// entire text file as wide characters, see TextDecoder
 p_bool os_readFile(p_str& result, const p_str& path);
+// raw bytes from the beginning of a file, but not more than the limit
+p_bool os_readFileStart(const p_str& path, std::string& result, const p_size limit);
+
+// read-only view of an entire file mapped into the memory
+// if the file cannot be mapped, it is read into the buffer and the view points there
+struct MappedFile
+{
+   const char* data = nullptr;
+   p_size size = 0;
+   HANDLE file = INVALID_HANDLE_VALUE;
+   HANDLE mapping = NULL;
+   std::string buffer;
+};
+
+p_bool os_mapFile(MappedFile& result, const p_str& path);
+void os_unmapFile(MappedFile& file);
+
+// file found inside of a directory tree
+// its path is relative to the root of the tree
+struct TreeFile
+{
+   p_str path;
+   p_nint size;
+   p_bool readOnly;
+};
+
+// list the entire directory tree
+// every directory comes after its parent, so in reverse order they can be removed one by one
+// null token means, that the listing cannot be stopped
+p_bool os_listTree(const p_str& root, std::vector<p_str>& directories, std::vector<TreeFile>& files,
+   const CancellationToken* cancellation);
+// perform an action on every file of the list by several threads
+// stop at the first failure or when the token is cancelled
+p_bool os_forEachTreeFile(const std::vector<TreeFile>& files, const std::function<p_bool(const TreeFile&)>& action,
+   const CancellationToken* cancellation);
+
+// named pipe of the daemon mode
+// every message is one job from the client or one portion of its output
+// only the first instance fails, if the name is already taken by anybody else
+p_entry os_createDaemonPipe(const p_bool first);
+p_bool os_daemonPipeExists();
+p_bool os_connectDaemonPipe(p_entry pipe);
+p_bool os_readPipeMessage(p_entry pipe, p_str& result);
+p_bool os_writePipeMessage(p_entry pipe, const p_str& value);
+void os_closeDaemonPipe(p_entry pipe);
+// connect to the daemon pipe and disconnect at once
+// unblocks the thread that waits for a client
+void os_wakeDaemonPipe();
+
+// changes of files and directories inside of a directory and all its subdirectories
+// the buffer of ReadDirectoryChangesW has to be aligned to DWORD
+p_constexpr p_size WATCH_BUFFER_SIZE = 64 * 1024;
+
+// wait without a time limit
+p_constexpr p_int WATCH_FOREVER = -1;
+
+enum WatchEvent
+{
+   we_Change = 0,
+   we_Timeout,
+   // os_wakeWatch() has been called
+   we_Woken,
+   we_Failure
+};
+
+struct DirectoryWatch
+{
+   p_entry directory = INVALID_HANDLE_VALUE;
+   // signaled by the operating system, when something changes
+   p_entry changed = NULL;
+   // signaled by os_wakeWatch()
+   p_entry woken = NULL;
+   OVERLAPPED overlapped;
+   std::unique_ptr<DWORD[]> buffer;
+   // a request for changes has not completed yet
+   p_bool pending = false;
+};
+
+p_bool os_startWatch(const p_str& path, DirectoryWatch& watch);
+// wait for the next change, at most this many milliseconds
+// any number of changes that happened in the meantime is one event
+WatchEvent os_awaitChange(DirectoryWatch& watch, const p_int timeout);
+// can be called from another thread
+void os_wakeWatch(DirectoryWatch& watch);
+void os_stopWatch(DirectoryWatch& watch);
+
+// size and raw modification time of a file, that tell whether a cached value computed from it is still valid
+// return false, if there is no such file or it is a directory
+p_bool os_fileStamp(const p_str& path, p_nint& size, uint64_t& modification);
+
+// the file is first written under a temporary name and then renamed
+// so other processes never see it half-written
+p_bool os_writeBinaryFile(const p_str& path, const std::string& content);
+
 void os_showWebsite(const p_str& url);
-p_bool os_findText(const p_str& path, const p_str& value);
+// the file is mapped into the memory and its raw bytes are searched
+// binary files are skipped
+p_bool os_findText(const p_str& path, const TextSearch& search);
+p_bool os_findAnyText(const p_str& path, MultiTextSearch& search);
+p_nint os_countText(const p_str& path, MultiTextSearch& search);
+
+// requested content hashes of the file
+// a file with the same size and modification time as before is not read again
+p_bool os_contentHash(const p_str& path, const p_bool hash, const p_bool crc32, ContentHash& result, Perun2Process& p2);
+void os_loadContentHash(FileContext& context);
+p_bool os_sameContent(const p_str& path1, const p_str& path2);
+// hash of the first and the last part of a file of known size
+// files not bigger than two parts are hashed entirely
+p_bool os_partialHash(const p_str& path, const p_size size, uint64_t& result);
 
 p_bool os_areEqualInPath(const p_char ch1, const p_char ch2);
 
@@ -21,6 +21,7 @@
 #include "util.h"
 #include "brackets.h"
 #include "lexer.h"
+#include "script-cache.h"
 #include "os/os.h"
 #include "logger.h"
 #include "datatype/math.h"
@@ -29,10 +30,18 @@
 namespace perun2
 {
 
-Perun2Process::Perun2Process(const Arguments& args) : arguments(args), contexts(*this),
-   flags(args.getFlags()), logger(*this), constCache(*this)
+Perun2Process::Perun2Process(const Arguments& args)
+   : Perun2Process(args, nullptr) { };
+
+Perun2Process::Perun2Process(const Arguments& args, FileCaches* shared) : arguments(args), contexts(*this),
+   flags(args.getFlags()), logger(*this), constCache(*this),
+   ownCaches(shared == nullptr ? std::make_unique<FileCaches>(args.hasFlag(FLAG_SCRIPT_CACHE)) : nullptr),
+   hashCache(shared == nullptr ? this->ownCaches->hash : shared->hash),
+   mediaCache(shared == nullptr ? this->ownCaches->media : shared->media),
+   profiler(args.getProfileFormat()), systemStats(args.hasFlag(FLAG_STATS))
 {
    Perun2Process::tryInit();
+   this->cancellation.subscribe(&this->sideProcess);
    Terminator::addPtr(this);
 };
 
@@ -44,37 +53,56 @@ Perun2Process::~Perun2Process() noexcept
 
 p_bool Perun2Process::run()
 {
-   if (! this->arguments.areGood()) {
-      this->exitCode = EXITCODE_CLI_ERROR;
+   // missing location is reported before any syntax error
+   return this->checkArguments()
+       && this->checkLocation()
+       && this->prepare()
+       && this->resetRuntimeState()
+       && this->runCommands();
+};
+
+p_bool Perun2Process::prepare()
+{
+   if (! this->checkArguments()) {
       return false;
    }
 
-   if (! os_directoryExists(this->arguments.getLocation())) {
-      this->exitCode = EXITCODE_NO_LOCATION;
-      return false;
+   switch (this->preparation) {
+      case PreparationState::ps_Ready: {
+         return true;
+      }
+      case PreparationState::ps_Failed: {
+         return false;
+      }
+      default: {
+         break;
+      }
    }
 
    this->exitCode = EXITCODE_OK;
 
-   return this->preParse() 
+   const p_bool ready = this->preParse() 
        && this->parse() 
-       && this->postParse()
+       && this->postParse();
+
+   this->preparation = ready
+      ? PreparationState::ps_Ready
+      : PreparationState::ps_Failed;
+
+   return ready;
+};
+
+p_bool Perun2Process::execute()
+{
+   return this->prepare()
+       && this->checkLocation()
+       && this->resetRuntimeState()
        && this->runCommands();
 };
 
 p_bool Perun2Process::staticallyAnalyze()
 {
-   if (! this->arguments.areGood()) {
-      this->exitCode = EXITCODE_CLI_ERROR;
-      return false;
-   }
-
-   this->exitCode = EXITCODE_OK;
-
-   if (this->preParse() 
-       && this->parse() 
-       && this->postParse())
-   {
+   if (this->prepare()) {
       this->logger.log(STRING_GOOD);
       return true;
    }
@@ -84,25 +112,40 @@ p_bool Perun2Process::staticallyAnalyze()
 
 void Perun2Process::terminate()
 {
-   this->state = State::s_Exit;
-   if (this->sideProcess.running) {
-      this->sideProcess.running = false;
-      os_terminate(this->sideProcess);
-   }
+   this->cancellation.cancel();
 }
 
-p_bool Perun2Process::isRunning() const
+p_bool Perun2Process::checkArguments()
 {
-   return this->state == State::s_Running;
+   if (! this->arguments.areGood()) {
+      this->exitCode = EXITCODE_CLI_ERROR;
+      return false;
+   }
+
+   return true;
 };
 
-p_bool Perun2Process::isNotRunning() const
+p_bool Perun2Process::checkLocation()
 {
-   return this->state != State::s_Running;
+   if (! os_directoryExists(this->arguments.getLocation())) {
+      this->exitCode = EXITCODE_NO_LOCATION;
+      return false;
+   }
+
+   return true;
 };
 
 p_bool Perun2Process::preParse()
 {
+   const p_bool useCache = (this->flags & FLAG_SCRIPT_CACHE) != 0;
+
+   if (useCache) {
+      ScriptCache cache(this->arguments.getCodeRef(), *this);
+      if (cache.load(this->tokens)) {
+         return true;
+      }
+   }
+
    try {
       this->tokens = tokenize(this->arguments.getCodeRef(), *this);
    }
@@ -118,37 +161,44 @@ p_bool Perun2Process::preParse()
       return false;
    }
 
+   if (useCache) {
+      ScriptCache cache(this->arguments.getCodeRef(), *this);
+      cache.save(this->tokens);
+   }
+
    return true;
 };
 
 
 p_bool Perun2Process::parse()
 {
+   const ArenaScope scope(this->arena);
+   DefinitionRegistry::active = &this->definitions;
+   p_bool success = true;
+
    try {
       const Tokens tks(this->tokens);
-      if (!comm::parseCommands(this->commands, tks, *this)) {
-         return false;
-      }
+      success = comm::parseCommands(this->commands, tks, *this);
    }
    catch (const SyntaxError& ex) {
       this->logger.print(ex.getMessage());
       this->exitCode = EXITCODE_SYNTAX_ERROR;
-      return false;
+      success = false;
    }
    catch (...) {
       SyntaxError ex = SyntaxError::wrongSyntax(1);
       this->logger.print(ex.getMessage());
       this->exitCode = EXITCODE_SYNTAX_ERROR;
-      return false;
+      success = false;
    }
 
-   return true;
+   DefinitionRegistry::active = nullptr;
+   return success;
 };
 
 p_bool Perun2Process::postParse()
 {
    this->conditionContext.deleteClosedUnits();
-   this->math.init();
 
    // this is a potential direction of optimizations
    // next iteration of syntax analysis after successful parsing of commands
@@ -156,23 +206,69 @@ p_bool Perun2Process::postParse()
    return true;
 };
 
+p_bool Perun2Process::resetRuntimeState()
+{
+   // parsed commands stay untouched
+   // only values they work on are brought back to the initial state
+   this->state = State::s_Running;
+   this->exitCode = EXITCODE_OK;
+   this->cancellation.reset();
+   // the previous run could have stopped in the middle of a loop
+   // loops reset their own aggregates and indices at start, but definitions continue from where they stopped
+   this->definitions.resetAll();
+   this->sideProcess.reset();
+   this->contexts.resetRuntimeState(*this);
+   this->math.init();
+   this->systemStats.reset();
+   this->mediaStats = MediaStats();
+
+   return true;
+};
+
 p_bool Perun2Process::runCommands()
 {
+   p_bool success = true;
+   const p_bool profiled = this->profiler.isEnabled();
+
+   if (profiled) {
+      this->profiler.start();
+   }
+
+   SystemStats::active = &this->systemStats;
+
    try {
       this->commands->run();
    }
    catch (...) {
       this->exitCode = EXITCODE_RUNTIME_ERROR;
-      return false;
+      success = false;
    }
 
-   return true;
+   SystemStats::active = nullptr;
+
+   if (profiled) {
+      this->profiler.finish(*this);
+   }
+
+   if (this->systemStats.measured) {
+      this->systemStats.print(*this);
+   }
+
+   // with the persistent cache, media probed during this run are not probed again by the next one
+   // a shared cache is persistent, but only scripts that asked for it write it back
+   if ((this->flags & FLAG_SCRIPT_CACHE) != 0) {
+      this->mediaCache.save();
+   }
+   return success;
 };
 
 p_int Perun2Process::globalCount = 0;
+std::mutex Perun2Process::globalMutex;
 
 void Perun2Process::tryInit()
 {
+   const std::lock_guard<std::mutex> lock(globalMutex);
+
    if (globalCount == 0) {
       os_init();
    }
@@ -182,6 +278,8 @@ void Perun2Process::tryInit()
 
 void Perun2Process::tryDeinit()
 {
+   const std::lock_guard<std::mutex> lock(globalMutex);
+
    globalCount--;
    if (globalCount == 0) {
       os_deinit();
@@ -198,14 +296,35 @@ Perun2::Perun2(const p_str& location, const p_str& code)
 Perun2::Perun2(const p_str& location, const p_str& code, const p_flags flags)
    : arguments(location, code, flags), process(this->arguments) { };
 
+Perun2::Perun2(const p_str& location, const p_str& code, const p_flags flags, FileCaches& caches)
+   : arguments(location, code, flags), process(this->arguments, &caches) { };
+
 p_bool Perun2::run()
 {
-   return this->process.run();
+   const p_bool result = this->process.run();
+   this->process.logger.flush();
+   return result;
+}
+
+p_bool Perun2::prepare()
+{
+   const p_bool result = this->process.prepare();
+   this->process.logger.flush();
+   return result;
+}
+
+p_bool Perun2::execute()
+{
+   const p_bool result = this->process.execute();
+   this->process.logger.flush();
+   return result;
 }
 
 p_bool Perun2::staticallyAnalyze()
 {
-   return this->process.staticallyAnalyze();
+   const p_bool result = this->process.staticallyAnalyze();
+   this->process.logger.flush();
+   return result;
 }
 
 int Perun2::getExitCode() const
@@ -218,4 +337,24 @@ p_bool Perun2::hasArgFlag(const p_flags flag) const
    return this->arguments.hasFlag(flag);
 }
 
+ArgsParseState Perun2::getArgsParseState() const
+{
+   return this->arguments.getParseState();
+}
+
+void Perun2::setOutput(std::wostream& output)
+{
+   this->process.logger.setOutput(output);
+}
+
+p_str Perun2::getLocation() const
+{
+   return this->arguments.getLocation();
+}
+
+p_bool Perun2::hasModifiedFiles() const
+{
+   return this->process.systemStats.anyModification();
+}
+
 }
@@ -15,10 +15,12 @@
 #pragma once
 
 #include "console.h"
+#include "arena.h"
 #include "arguments.h"
 #include "datatype/math.h"
 #include "terminator.h"
 #include "keyword.h"
+#include "cancellation.h"
 #include "side-process.h"
 #include "command/com.h"
 #include "command/com-parse-unit.h"
@@ -26,8 +28,17 @@
 #include "context/ctx-main.h"
 #include "logger.h"
 #include "const-cache.h"
+#include "content-hash.h"
+#include "media.h"
+#include "profiler.h"
+#include <mutex>
 
 
+namespace perun2::comm
+{
+   struct RunPool;
+}
+
 namespace perun2
 {
 
@@ -49,6 +60,30 @@ enum State
 };
 
 
+// parsing is performed only once for every process
+enum PreparationState
+{
+   ps_NotPrepared = 0,
+   ps_Ready,
+   ps_Failed
+};
+
+
+// caches of values computed from the content of files
+// every instance of Perun2 has its own, unless it is given caches shared with others
+// the daemon shares one for all scripts it runs
+struct FileCaches
+{
+public:
+   FileCaches() = delete;
+   FileCaches(const p_bool persistent)
+      : media(persistent) { };
+
+   HashCache hash;
+   MediaCache media;
+};
+
+
 // this struct is used only internally within the namespace
 // for external facade of the entire language, use struct 'Perun2' from below
 struct Perun2Process
@@ -56,43 +91,89 @@ struct Perun2Process
 public:
    Perun2Process() = delete;
    Perun2Process(const Arguments& args);
+   // the caches have to outlive this instance
+   Perun2Process(const Arguments& args, FileCaches* shared);
    ~Perun2Process() noexcept;
 
    // perform all parsing and then run all parsed commands if parsing succeeded
    p_bool run();
+
+   // perform all parsing if it has not been done yet
+   p_bool prepare();
+
+   // run already parsed commands from the initial state
+   // parsing is performed first if needed
+   p_bool execute();
    
    // perform all parsing, but do not run any command
    p_bool staticallyAnalyze();
 
    // stop running process
+   // safe to call from any thread
    void terminate();
 
-   p_bool isRunning() const;
-   p_bool isNotRunning() const;
+   // state is changed only by the thread that runs commands
+   // requests from other threads come through the cancellation token
+   p_bool isRunning() const
+   {
+      return this->state == State::s_Running && !this->cancellation.isCancelled();
+   };
+
+   p_bool isNotRunning() const
+   {
+      return this->state != State::s_Running || this->cancellation.isCancelled();
+   };
 
    const Arguments& arguments;
+   // memory of parsed commands and expressions
+   // declared before everything that owns them, so it is released last
+   Arena arena;
+   // definitions are owned by the parsed commands, so the registry outlives them
+   DefinitionRegistry definitions;
    Math math;
    Contexts contexts;
-   const KeywordsData keywordsData;
+   // worker threads poll only this token, never the state
+   CancellationToken cancellation;
    SideProcess sideProcess;
    const p_flags flags;
    comm::ConditionContext conditionContext;
+   // pool of the iteration loop, that is being parsed right now
+   // commands Run inside of it hand their processes over to the pool
+   // used only with the option --jobs
+   comm::RunPool* runPool = nullptr;
    State state = State::s_Running;
    int exitCode = EXITCODE_OK;
    Logger logger;
    ConstCache constCache;
+   // null, if the caches are shared
+   std::unique_ptr<FileCaches> ownCaches;
+   // content hashes of files, kept between runs of a prepared script
+   HashCache& hashCache;
+   // metadata of images and videos, shared by all media attributes
+   MediaCache& mediaCache;
+   // how media attributes of the current run were found
+   MediaStats mediaStats;
+   // timers of commands and expressions, if the option --profile is used
+   Profiler profiler;
+   // file system operations caused by the current run
+   SystemStats systemStats;
 
 private:
+   p_bool checkArguments();
+   p_bool checkLocation();
    p_bool preParse();
    p_bool parse();
    p_bool postParse();
+   p_bool resetRuntimeState();
    p_bool runCommands();
 
 // count how many Perun2 processes are there globally
    static p_int globalCount;
+   static std::mutex globalMutex;
    static void tryInit();
    static void tryDeinit();
 
+   PreparationState preparation = PreparationState::ps_NotPrepared;
    p_comptr commands;
    std::vector<Token> tokens;
 };
@@ -101,12 +182,14 @@ private:
 // external facade for Perun2
 // create an object once
 // and run() it multiple times
+// code is parsed only at the first run
 struct Perun2
 {
 public:
    Perun2(const p_int argc, p_char* const argv[]);
    Perun2(const p_str& location, const p_str& code);
    Perun2(const p_str& location, const p_str& code, const p_flags flags);
+   Perun2(const p_str& location, const p_str& code, const p_flags flags, FileCaches& caches);
 
    Perun2() = delete;
    Perun2(Perun2 const&) = delete;
@@ -115,6 +198,12 @@ public:
    // perform all parsing and then run all parsed commands if parsing succeeded
    p_bool run();
 
+   // perform all parsing if it has not been done yet
+   p_bool prepare();
+
+   // run already parsed commands from the initial state
+   p_bool execute();
+
    // perform all parsing, but do not run any command
    p_bool staticallyAnalyze();
 
@@ -123,6 +212,15 @@ public:
    int getExitCode() const;
 
    p_bool hasArgFlag(const p_flags flag) const;
+   ArgsParseState getArgsParseState() const;
+
+   // redirect all messages of this instance from the console to another stream
+   void setOutput(std::wostream& output);
+
+   p_str getLocation() const;
+
+   // the last run changed something in the file system or started another program
+   p_bool hasModifiedFiles() const;
 
 private:
    Arguments arguments;
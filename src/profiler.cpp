@@ -0,0 +1,323 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "profiler.h"
+#include "perun2.h"
+#include "os/os.h"
+#include <algorithm>
+#include <iomanip>
+
+
+namespace perun2
+{
+
+p_constexpr p_size PROFILE_NO_NODE = static_cast<p_size>(-1);
+p_constexpr p_size PROFILE_ROOT_SITE = static_cast<p_size>(SystemCall::sc_Count);
+
+thread_local Profiler* Profiler::active = nullptr;
+
+
+static p_str kindName(const ProfileKind kind)
+{
+   switch (kind) {
+      case ProfileKind::pk_Command:
+         return L"command";
+      case ProfileKind::pk_Generator:
+         return L"expression";
+      case ProfileKind::pk_System:
+         return L"system";
+      default:
+         return L"script";
+   }
+}
+
+static p_str toMilliseconds(const uint64_t nanoseconds)
+{
+   p_ostream s;
+   s << std::fixed << std::setprecision(3) << (static_cast<double>(nanoseconds) / 1000000.0);
+   return s.str();
+}
+
+static p_str toMicroseconds(const uint64_t nanoseconds)
+{
+   p_ostream s;
+   s << std::fixed << std::setprecision(3) << (static_cast<double>(nanoseconds) / 1000.0);
+   return s.str();
+}
+
+
+Profiler::Profiler(const ProfileFormat format)
+   : format(format)
+{
+   if (this->format == ProfileFormat::pf_None) {
+      return;
+   }
+
+   for (const p_char* name : SYSTEM_CALL_NAMES) {
+      this->addSite(ProfileKind::pk_System, PROFILE_NO_LINE, name);
+   }
+
+   this->addSite(ProfileKind::pk_Root, PROFILE_NO_LINE, L"script");
+   this->nodes.push_back({ PROFILE_ROOT_SITE, PROFILE_NO_NODE });
+};
+
+p_bool Profiler::isEnabled() const
+{
+   return this->format != ProfileFormat::pf_None;
+}
+
+p_size Profiler::addSite(const ProfileKind kind, const p_int line, const p_str& name)
+{
+   this->sites.push_back({ kind, line, name });
+   this->lastNodes.push_back({ PROFILE_NO_NODE, PROFILE_NO_NODE });
+   return this->sites.size() - 1;
+}
+
+p_size Profiler::enter(const p_size site)
+{
+   LastNode& last = this->lastNodes[site];
+
+   if (last.parent == this->current) {
+      this->current = last.node;
+      return last.node;
+   }
+
+   p_size node = PROFILE_NO_NODE;
+
+   for (const p_size child : this->nodes[this->current].children) {
+      if (this->nodes[child].site == site) {
+         node = child;
+         break;
+      }
+   }
+
+   if (node == PROFILE_NO_NODE) {
+      node = this->nodes.size();
+      this->nodes.push_back({ site, this->current });
+      this->nodes[this->current].children.push_back(node);
+   }
+
+   last.parent = this->current;
+   last.node = node;
+   this->current = node;
+   return node;
+}
+
+void Profiler::leave(const p_size node, const p_proftime& start, const p_proftime& end)
+{
+   const uint64_t duration = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+
+   ProfileNode& n = this->nodes[node];
+   n.calls++;
+   n.time += duration;
+   this->current = n.parent;
+
+   if (this->format == ProfileFormat::pf_Trace) {
+      if (this->events.size() < PROFILE_TRACE_LIMIT) {
+         this->events.push_back({ node, this->elapsed(start), duration });
+      }
+      else {
+         this->droppedEvents++;
+      }
+   }
+}
+
+void Profiler::start()
+{
+   // nodes of the previous run are forgotten, sites stay as they were parsed
+   this->nodes.resize(1);
+   this->nodes[0] = { PROFILE_ROOT_SITE, PROFILE_NO_NODE };
+
+   for (LastNode& last : this->lastNodes) {
+      last = { PROFILE_NO_NODE, PROFILE_NO_NODE };
+   }
+
+   this->events.clear();
+   this->droppedEvents = 0;
+   this->current = 0;
+   this->origin = p_profclock::now();
+   Profiler::active = this;
+}
+
+void Profiler::finish(Perun2Process& p2)
+{
+   Profiler::active = nullptr;
+   this->nodes[0].calls = 1;
+   this->nodes[0].time = this->elapsed(p_profclock::now());
+   this->sortChildren();
+
+   switch (this->format) {
+      case ProfileFormat::pf_Report: {
+         this->printReport(p2);
+         break;
+      }
+      case ProfileFormat::pf_Json: {
+         this->writeFile(PROFILE_JSON_FILE_NAME, this->toJson(), p2);
+         break;
+      }
+      case ProfileFormat::pf_Trace: {
+         this->writeFile(PROFILE_TRACE_FILE_NAME, this->toTrace(), p2);
+         break;
+      }
+      default: {
+         break;
+      }
+   }
+}
+
+uint64_t Profiler::elapsed(const p_proftime& time) const
+{
+   return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(time - this->origin).count());
+}
+
+uint64_t Profiler::childrenTime(const ProfileNode& node) const
+{
+   uint64_t result = 0;
+
+   for (const p_size child : node.children) {
+      result += this->nodes[child].time;
+   }
+
+   return result;
+}
+
+void Profiler::sortChildren()
+{
+   // the most expensive calls go first
+   for (ProfileNode& node : this->nodes) {
+      std::stable_sort(node.children.begin(), node.children.end(), [this](const p_size a, const p_size b) {
+         return this->nodes[a].time > this->nodes[b].time;
+      });
+   }
+}
+
+void Profiler::printReport(Perun2Process& p2) const
+{
+   p2.logger.emptyLine();
+   p2.logger.print(str(L"Profile: ", toMilliseconds(this->nodes[0].time), L" ms in total"));
+   p2.logger.print(L"time (ms), own time (ms), calls, line, site");
+
+   for (const p_size child : this->nodes[0].children) {
+      this->printNode(child, 0, p2);
+   }
+}
+
+void Profiler::printNode(const p_size index, const p_size depth, Perun2Process& p2) const
+{
+   const ProfileNode& node = this->nodes[index];
+   const ProfileSite& site = this->sites[node.site];
+   const uint64_t own = node.time - std::min(node.time, this->childrenTime(node));
+
+   p2.logger.print(str(p_str(depth * 2, CHAR_SPACE),
+      toMilliseconds(node.time), L", ",
+      toMilliseconds(own), L", ",
+      toStr(node.calls), L", ",
+      site.line == PROFILE_NO_LINE ? L"-" : toStr(site.line), L", ",
+      site.name));
+
+   for (const p_size child : node.children) {
+      this->printNode(child, depth + 1, p2);
+   }
+}
+
+p_str Profiler::toJson() const
+{
+   p_str result = str(L"{\"time_ns\":", toStr(this->nodes[0].time), L",\"children\":[");
+
+   for (p_size i = 0; i < this->nodes[0].children.size(); i++) {
+      if (i != 0) {
+         result += CHAR_COMMA;
+      }
+
+      this->appendJsonNode(result, this->nodes[0].children[i]);
+   }
+
+   result += L"]}";
+   return result;
+}
+
+void Profiler::appendJsonNode(p_str& result, const p_size index) const
+{
+   const ProfileNode& node = this->nodes[index];
+   const ProfileSite& site = this->sites[node.site];
+   const uint64_t own = node.time - std::min(node.time, this->childrenTime(node));
+
+   result += str(L"{\"name\":", str_toJson(site.name),
+      L",\"kind\":", str_toJson(kindName(site.kind)));
+
+   if (site.line != PROFILE_NO_LINE) {
+      result += str(L",\"line\":", toStr(site.line));
+   }
+
+   result += str(L",\"calls\":", toStr(node.calls),
+      L",\"time_ns\":", toStr(node.time),
+      L",\"self_ns\":", toStr(own),
+      L",\"children\":[");
+
+   for (p_size i = 0; i < node.children.size(); i++) {
+      if (i != 0) {
+         result += CHAR_COMMA;
+      }
+
+      this->appendJsonNode(result, node.children[i]);
+   }
+
+   result += L"]}";
+}
+
+p_str Profiler::toTrace() const
+{
+   p_str result = L"{\"traceEvents\":[";
+
+   for (p_size i = 0; i < this->events.size(); i++) {
+      const ProfileEvent& event = this->events[i];
+      const ProfileSite& site = this->sites[this->nodes[event.node].site];
+
+      if (i != 0) {
+         result += CHAR_COMMA;
+      }
+
+      result += str(L"{\"name\":", str_toJson(site.name),
+         L",\"cat\":", str_toJson(kindName(site.kind)),
+         L",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":", toMicroseconds(event.start),
+         L",\"dur\":", toMicroseconds(event.duration));
+
+      if (site.line != PROFILE_NO_LINE) {
+         result += str(L",\"args\":{\"line\":", toStr(site.line), L"}");
+      }
+
+      result += CHAR_CLOSING_CURLY_BRACKET;
+   }
+
+   result += str(L"],\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedEvents\":",
+      toStr(this->droppedEvents), L"}}");
+   return result;
+}
+
+void Profiler::writeFile(const p_str& name, const p_str& content, Perun2Process& p2) const
+{
+   // next to the place, where the command was called from
+   const p_str path = os_join(os_currentPath(), name);
+
+   if (os_writeBinaryFile(path, os_toUtf8(content))) {
+      p2.logger.print(str(L"Profile has been written to ", path));
+   }
+   else {
+      p2.logger.print(str(L"Profile could not be written to ", path));
+   }
+}
+
+}
@@ -0,0 +1,224 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "system-stats.h"
+#include <chrono>
+#include <vector>
+
+
+namespace perun2
+{
+
+struct Perun2Process;
+
+typedef std::chrono::steady_clock   p_profclock;
+typedef p_profclock::time_point     p_proftime;
+
+
+// the profiler is turned on by the command-line option --profile
+// its value decides, what happens with the results at the end of the run
+enum ProfileFormat : uint8_t
+{
+   pf_None = 0,
+   // a tree printed after the output of the script
+   pf_Report,
+   // the same tree written to a JSON file
+   pf_Json,
+   // every call written to a file in the Chrome trace event format
+   pf_Trace
+};
+
+
+enum ProfileKind : uint8_t
+{
+   pk_Root = 0,
+   pk_Command,
+   pk_Generator,
+   pk_System
+};
+
+
+// sites of the operating system have no line in the script
+p_constexpr p_int PROFILE_NO_LINE = 0;
+
+// the trace file stops growing after this many calls
+p_constexpr p_size PROFILE_TRACE_LIMIT = 1000000;
+
+p_constexpr p_char PROFILE_JSON_FILE_NAME[] =   L"perun2-profile.json";
+p_constexpr p_char PROFILE_TRACE_FILE_NAME[] =  L"perun2-trace.json";
+
+
+// a place in the code, that is measured
+// commands and expressions are sites of the script, known since parsing
+struct ProfileSite
+{
+   ProfileKind kind;
+   p_int line;
+   p_str name;
+};
+
+
+// a site reached by a certain path of calls
+// the same site called from two different places makes two nodes
+struct ProfileNode
+{
+   p_size site;
+   p_size parent;
+   p_size calls = 0;
+   // in nanoseconds, calls of children included
+   uint64_t time = 0;
+   std::vector<p_size> children;
+};
+
+
+struct ProfileEvent
+{
+   p_size node;
+   uint64_t start;
+   uint64_t duration;
+};
+
+
+// timers and counters of commands, expressions and the operating system
+// results are kept as a tree of calls, as deep as the script itself
+// only one thread is measured, other threads of the process do not see the profiler
+struct Profiler
+{
+public:
+   Profiler() = delete;
+   Profiler(const ProfileFormat format);
+
+   p_bool isEnabled() const;
+
+   // sites of the script are added during parsing
+   p_size addSite(const ProfileKind kind, const p_int line, const p_str& name);
+
+   // the node of the site called from the current node becomes the current node
+   p_size enter(const p_size site);
+   void leave(const p_size node, const p_proftime& start, const p_proftime& end);
+
+   // measured calls of this thread go to this profiler from now on
+   void start();
+   // stop measuring and report the results in the requested format
+   void finish(Perun2Process& p2);
+
+   // profiler running on this thread, if any
+   static thread_local Profiler* active;
+
+private:
+   uint64_t elapsed(const p_proftime& time) const;
+   uint64_t childrenTime(const ProfileNode& node) const;
+   void sortChildren();
+
+   void printReport(Perun2Process& p2) const;
+   void printNode(const p_size index, const p_size depth, Perun2Process& p2) const;
+   p_str toJson() const;
+   void appendJsonNode(p_str& result, const p_size index) const;
+   p_str toTrace() const;
+   void writeFile(const p_str& name, const p_str& content, Perun2Process& p2) const;
+
+   struct LastNode
+   {
+      p_size parent;
+      p_size node;
+   };
+
+   const ProfileFormat format;
+   std::vector<ProfileSite> sites;
+   std::vector<ProfileNode> nodes;
+   // the node of every site seen most recently
+   // loops call the same sites from the same parent over and over again
+   std::vector<LastNode> lastNodes;
+   std::vector<ProfileEvent> events;
+   p_size current = 0;
+   p_size droppedEvents = 0;
+   p_proftime origin;
+};
+
+
+// measures the scope of one call of the site
+struct ProfileScope
+{
+public:
+   ProfileScope() = delete;
+   ProfileScope(Profiler& prof, const p_size site)
+      : profiler(prof), node(prof.enter(site)), start(p_profclock::now()) { };
+
+   ~ProfileScope() noexcept
+   {
+      this->profiler.leave(this->node, this->start, p_profclock::now());
+   };
+
+private:
+   Profiler& profiler;
+   const p_size node;
+   const p_proftime start;
+};
+
+
+// counts one call of a wrapper of the operating system
+// and measures it for the profiler and for the statistics
+// does nothing, if no process runs on this thread
+struct SystemCallScope
+{
+public:
+   SystemCallScope() = delete;
+   SystemCallScope(const SystemCall cl)
+      : call(cl), stats(SystemStats::active), profiler(Profiler::active)
+   {
+      if (this->stats != nullptr) {
+         this->stats->addCall(this->call);
+         this->measured = this->stats->measured;
+      }
+
+      if (this->profiler != nullptr) {
+         this->node = this->profiler->enter(static_cast<p_size>(this->call));
+         this->measured = true;
+      }
+
+      if (this->measured) {
+         this->start = p_profclock::now();
+      }
+   };
+
+   ~SystemCallScope() noexcept
+   {
+      if (! this->measured) {
+         return;
+      }
+
+      const p_proftime end = p_profclock::now();
+
+      if (this->stats != nullptr && this->stats->measured) {
+         this->stats->addDuration(this->call, static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - this->start).count()));
+      }
+
+      if (this->profiler != nullptr) {
+         this->profiler->leave(this->node, this->start, end);
+      }
+   };
+
+private:
+   const SystemCall call;
+   SystemStats* const stats;
+   Profiler* const profiler;
+   p_bool measured = false;
+   p_size node = 0;
+   p_proftime start;
+};
+
+}
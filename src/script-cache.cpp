@@ -0,0 +1,266 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "script-cache.h"
+#include "perun2.h"
+#include "metadata.h"
+#include "os/os.h"
+#include <cstring>
+
+
+namespace perun2
+{
+
+static_assert(sizeof(p_ndouble) <= sizeof(CachedToken::number), "number does not fit into the cached token");
+
+
+// FNV-1a
+static void hashBytes(uint64_t& hash, const void* data, const p_size length)
+{
+   const unsigned char* bytes = static_cast<const unsigned char*>(data);
+
+   for (p_size i = 0; i < length; i++) {
+      hash ^= bytes[i];
+      hash *= 1099511628211ULL;
+   }
+}
+
+uint64_t scriptHash(const p_str& code)
+{
+   uint64_t hash = 14695981039346656037ULL;
+
+   // the same code may be tokenized differently by another version of Perun2
+   // or by a build with different sizes of primitive types
+   hashBytes(hash, metadata::VERSION, sizeof(metadata::VERSION));
+   const uint32_t sizes[] = { sizeof(p_char), sizeof(p_ndouble), SCRIPT_CACHE_FORMAT };
+   hashBytes(hash, sizes, sizeof(sizes));
+
+   hashBytes(hash, code.c_str(), code.size() * sizeof(p_char));
+   return hash;
+}
+
+
+ScriptCache::ScriptCache(const p_str& code, Perun2Process& p2)
+   : code(code), hash(scriptHash(code)), perun2(p2) { };
+
+
+static Token toToken(const CachedToken& ct, Perun2Process& p2)
+{
+   const p_char ch = static_cast<p_char>(ct.ch);
+   const p_int line = static_cast<p_int>(ct.line);
+   const p_size os1 = static_cast<p_size>(ct.os[0]);
+   const p_size os2 = static_cast<p_size>(ct.os[1]);
+
+   switch (static_cast<Token::Type>(ct.type)) {
+      case Token::t_Symbol: {
+         return Token(ch, line, p2);
+      }
+      case Token::t_MultiSymbol: {
+         return Token(ch, static_cast<p_int>(ct.extra), line, p2);
+      }
+      case Token::t_Number: {
+         p_num n;
+         n.state = static_cast<NumberState>(ct.numberState);
+
+         if (n.state == NumberState::Double) {
+            std::memcpy(&n.value.d, ct.number, sizeof(p_ndouble));
+         }
+         else {
+            std::memcpy(&n.value.i, ct.number, sizeof(p_nint));
+         }
+
+         return Token(n, line, os1, os2, static_cast<NumberMode>(ct.numberMode), p2);
+      }
+      case Token::t_Word: {
+         return Token(line, os1, os2, p2);
+      }
+      case Token::t_Keyword: {
+         return Token(static_cast<Keyword>(ct.extra), line, os1, os2, p2);
+      }
+      case Token::t_Quotation: {
+         return Token(os1, os2, line, p2);
+      }
+      case Token::t_Pattern: {
+         return Token(os1, os2, static_cast<p_int>(ct.extra), line, p2);
+      }
+      default: {
+         return Token(line, os1, os2, static_cast<p_size>(ct.os[2]), static_cast<p_size>(ct.os[3]), p2);
+      }
+   }
+}
+
+static CachedToken toCachedToken(const Token& tk)
+{
+   CachedToken ct;
+   std::memset(&ct, 0, sizeof(CachedToken));
+   ct.type = static_cast<uint8_t>(tk.type);
+   ct.line = static_cast<int32_t>(tk.line);
+
+   switch (tk.type) {
+      case Token::t_Symbol: {
+         ct.ch = static_cast<uint32_t>(tk.value.ch);
+         break;
+      }
+      case Token::t_MultiSymbol: {
+         ct.ch = static_cast<uint32_t>(tk.value.chars.ch);
+         ct.extra = static_cast<int32_t>(tk.value.chars.am);
+         break;
+      }
+      case Token::t_Number: {
+         const p_num& n = tk.value.num.n;
+         ct.numberMode = static_cast<uint8_t>(tk.value.num.nm);
+         ct.numberState = static_cast<uint8_t>(n.state);
+
+         if (n.state == NumberState::Double) {
+            std::memcpy(ct.number, &n.value.d, sizeof(p_ndouble));
+         }
+         else {
+            std::memcpy(ct.number, &n.value.i, sizeof(p_nint));
+         }
+
+         ct.os[0] = tk.value.num.os.index;
+         ct.os[1] = tk.value.num.os.length;
+         break;
+      }
+      case Token::t_Word: {
+         ct.os[0] = tk.value.word.os.index;
+         ct.os[1] = tk.value.word.os.length;
+         break;
+      }
+      case Token::t_Keyword: {
+         ct.extra = static_cast<int32_t>(tk.value.keyword.k);
+         ct.os[0] = tk.value.keyword.os.index;
+         ct.os[1] = tk.value.keyword.os.length;
+         break;
+      }
+      case Token::t_Quotation: {
+         ct.os[0] = tk.value.str.index;
+         ct.os[1] = tk.value.str.length;
+         break;
+      }
+      case Token::t_Pattern: {
+         ct.extra = static_cast<int32_t>(tk.value.pattern.id);
+         ct.os[0] = tk.value.pattern.os.index;
+         ct.os[1] = tk.value.pattern.os.length;
+         break;
+      }
+      case Token::t_TwoWords: {
+         ct.os[0] = tk.value.twoWords.os1.index;
+         ct.os[1] = tk.value.twoWords.os1.length;
+         ct.os[2] = tk.value.twoWords.os2.index;
+         ct.os[3] = tk.value.twoWords.os2.length;
+         break;
+      }
+   }
+
+   return ct;
+}
+
+
+p_bool ScriptCache::load(std::vector<Token>& result)
+{
+   const p_str path = this->getFilePath();
+   if (path.empty()) {
+      return false;
+   }
+
+   MappedFile file;
+   if (!os_mapFile(file, path)) {
+      return false;
+   }
+
+   ScriptCacheHeader header;
+
+   if (file.size < sizeof(ScriptCacheHeader)) {
+      os_unmapFile(file);
+      return false;
+   }
+
+   std::memcpy(&header, file.data, sizeof(ScriptCacheHeader));
+
+   // different code may lead to the same file name only by a hash collision
+   // length of the code is one more barrier against that
+   if (std::memcmp(header.magic, SCRIPT_CACHE_MAGIC, sizeof(header.magic)) != 0
+      || header.format != SCRIPT_CACHE_FORMAT
+      || header.hash != this->hash
+      || header.codeLength != this->code.size()
+      // the count is checked first, so a damaged file cannot overflow the multiplication
+      || header.tokenCount > (file.size - sizeof(ScriptCacheHeader)) / sizeof(CachedToken)
+      || file.size != sizeof(ScriptCacheHeader) + header.tokenCount * sizeof(CachedToken))
+   {
+      os_unmapFile(file);
+      return false;
+   }
+
+   result.clear();
+   result.reserve(static_cast<p_size>(header.tokenCount));
+   const char* position = file.data + sizeof(ScriptCacheHeader);
+   CachedToken ct;
+
+   for (uint64_t i = 0; i < header.tokenCount; i++) {
+      std::memcpy(&ct, position, sizeof(CachedToken));
+      result.emplace_back(toToken(ct, this->perun2));
+      position += sizeof(CachedToken);
+   }
+
+   os_unmapFile(file);
+   return true;
+}
+
+void ScriptCache::save(const std::vector<Token>& tokens)
+{
+   const p_str path = this->getFilePath();
+   if (path.empty()) {
+      return;
+   }
+
+   const p_str directory = os_parent(path);
+   if (!os_directoryExists(directory) && !os_createDirectory(directory)) {
+      return;
+   }
+
+   ScriptCacheHeader header;
+   std::memcpy(header.magic, SCRIPT_CACHE_MAGIC, sizeof(header.magic));
+   header.format = SCRIPT_CACHE_FORMAT;
+   header.hash = this->hash;
+   header.codeLength = this->code.size();
+   header.tokenCount = tokens.size();
+
+   std::string content;
+   content.reserve(sizeof(ScriptCacheHeader) + tokens.size() * sizeof(CachedToken));
+   content.append(reinterpret_cast<const char*>(&header), sizeof(ScriptCacheHeader));
+
+   for (const Token& tk : tokens) {
+      const CachedToken ct = toCachedToken(tk);
+      content.append(reinterpret_cast<const char*>(&ct), sizeof(CachedToken));
+   }
+
+   // failure is not an error
+   // the script will be tokenized again next time
+   os_writeBinaryFile(path, content);
+}
+
+p_str ScriptCache::getFilePath() const
+{
+   const p_str directory = os_scriptCachePath();
+   if (directory.empty()) {
+      return p_str();
+   }
+
+   p_ostream name;
+   name << std::hex << this->hash;
+   return str(directory, OS_SEPARATOR, name.str(), CHAR_DOT, SCRIPT_CACHE_EXTENSION);
+}
+
+}
@@ -0,0 +1,82 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "token.h"
+#include <vector>
+
+
+namespace perun2
+{
+
+struct Perun2Process;
+
+// increment this number whenever the layout of cached data changes
+p_constexpr uint32_t SCRIPT_CACHE_FORMAT = 1;
+p_constexpr char SCRIPT_CACHE_MAGIC[] = "P2TC";
+p_constexpr p_char SCRIPT_CACHE_EXTENSION[] = L"p2c";
+
+
+// beginning of every cache file
+struct ScriptCacheHeader
+{
+   char magic[4];
+   uint32_t format;
+   uint64_t hash;
+   uint64_t codeLength;
+   uint64_t tokenCount;
+};
+
+
+// one token written in a form independent from the layout of struct Token
+// positions in the source code remain valid, because the code has the same hash
+struct CachedToken
+{
+   uint8_t type;
+   uint8_t numberMode;
+   uint8_t numberState;
+   uint8_t reserved;
+   int32_t line;
+   int32_t extra;
+   uint32_t ch;
+   uint64_t os[4];
+   unsigned char number[16];
+};
+
+
+// result of lexical analysis of a script is stored in a small binary file
+// its name comes from the hash of the code and the version of the interpreter
+// so the next run of the same code can skip the lexer entirely
+struct ScriptCache
+{
+public:
+   ScriptCache() = delete;
+   ScriptCache(const p_str& code, Perun2Process& p2);
+
+   p_bool load(std::vector<Token>& result);
+   void save(const std::vector<Token>& tokens);
+
+private:
+   p_str getFilePath() const;
+
+   const p_str& code;
+   const uint64_t hash;
+   Perun2Process& perun2;
+};
+
+
+uint64_t scriptHash(const p_str& code);
+
+}
@@ -0,0 +1,62 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "side-process.h"
+#include "os/os.h"
+#include <algorithm>
+
+
+namespace perun2
+{
+
+p_bool SideProcess::add(const p_process process)
+{
+   const std::lock_guard<std::mutex> lock(this->mutex);
+
+   if (this->terminated) {
+      return false;
+   }
+
+   this->children.push_back(process);
+   return true;
+}
+
+void SideProcess::remove(const p_process process)
+{
+   const std::lock_guard<std::mutex> lock(this->mutex);
+   const auto it = std::find(this->children.begin(), this->children.end(), process);
+
+   if (it != this->children.end()) {
+      this->children.erase(it);
+   }
+}
+
+void SideProcess::cancel()
+{
+   const std::lock_guard<std::mutex> lock(this->mutex);
+   this->terminated = true;
+
+   // handles stay open and registered until their owners wait for them
+   for (const p_process process : this->children) {
+      os_terminate(process);
+   }
+}
+
+void SideProcess::reset()
+{
+   const std::lock_guard<std::mutex> lock(this->mutex);
+   this->terminated = false;
+}
+
+}
@@ -15,18 +15,41 @@
 #pragma once
 
 #include "datatype/primitives.h"
+#include "cancellation.h"
 #include <Windows.h>
+#include <mutex>
+#include <vector>
 
 
 namespace perun2
 {
 
-struct SideProcess
+typedef HANDLE    p_process;
+
+
+// registry of child processes started by the command Run
+// usually there is at most one, but a pool of concurrent runs has many of them
+// Perun2 can be terminated from another thread, so every access is synchronized
+// it is subscribed to the cancellation token of its Perun2 and kills the children when cancelled
+struct SideProcess : Cancellable
 {
 public:
-   p_bool running = false;
-   PROCESS_INFORMATION info;
-   
+   // return false, if Perun2 has already been terminated
+   // then the child is not registered and should be killed by the caller
+   p_bool add(const p_process process);
+
+   void remove(const p_process process);
+
+   // kill every registered child and refuse new ones
+   void cancel() override;
+
+   // prepare for the next run of the same script
+   void reset();
+
+private:
+   std::mutex mutex;
+   std::vector<p_process> children;
+   p_bool terminated = false;
 };
 
 }
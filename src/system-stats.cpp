@@ -0,0 +1,204 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "system-stats.h"
+#include "perun2.h"
+#include <cmath>
+#include <iomanip>
+
+
+namespace perun2
+{
+
+const p_char* const SYSTEM_CALL_NAMES[SystemCall::sc_Count] =
+{
+   L"os_hasFirstFile", L"os_hasNextFile", L"os_loadAttributes", L"os_loadDataAttributes",
+   L"os_exists", L"os_fileExists", L"os_directoryExists", L"os_readFile", L"os_readFileStart",
+   L"os_mapFile", L"os_createFile", L"os_createDirectory", L"os_copyTo", L"os_moveTo",
+   L"os_drop", L"os_delete", L"os_hide", L"os_unhide", L"os_lock", L"os_unlock", L"os_setTime",
+   L"os_open", L"os_openAsCommand", L"os_run", L"os_contentHash", L"os_mediaAttributes"
+};
+
+const p_bool SYSTEM_CALL_MODIFIES[SystemCall::sc_Count] =
+{
+   false, false, false, false,
+   false, false, false, false, false,
+   false, true, true, true, true,
+   true, true, true, true, true, true, true,
+   true, true, true, false, false
+};
+
+thread_local SystemStats* SystemStats::active = nullptr;
+
+
+SystemStats::SystemStats(const p_bool measured)
+   : measured(measured)
+{
+   this->reset();
+};
+
+void SystemStats::reset()
+{
+   for (SystemCallStats& call : this->calls) {
+      call.calls.store(0, std::memory_order_relaxed);
+      call.time.store(0, std::memory_order_relaxed);
+
+      for (std::atomic<uint64_t>& bucket : call.latencies) {
+         bucket.store(0, std::memory_order_relaxed);
+      }
+   }
+
+   this->bytesRead.store(0, std::memory_order_relaxed);
+   this->bytesWritten.store(0, std::memory_order_relaxed);
+}
+
+void SystemStats::addDuration(const SystemCall call, const uint64_t nanoseconds)
+{
+   SystemCallStats& stats = this->calls[call];
+   stats.time.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+   uint64_t microseconds = nanoseconds / 1000;
+   p_size bucket = 0;
+
+   while (microseconds != 0 && bucket < STATS_LATENCY_BUCKETS - 1) {
+      microseconds >>= 1;
+      bucket++;
+   }
+
+   stats.latencies[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t SystemStats::getCalls(const SystemCall call) const
+{
+   return this->calls[call].calls.load(std::memory_order_relaxed);
+}
+
+uint64_t SystemStats::get(const SystemStat stat) const
+{
+   switch (stat) {
+      case SystemStat::ss_DirectoryOpens: {
+         return this->getCalls(SystemCall::sc_HasFirstFile);
+      }
+      case SystemStat::ss_EntryReads: {
+         return this->getCalls(SystemCall::sc_HasNextFile);
+      }
+      case SystemStat::ss_AttributeQueries: {
+         return this->getCalls(SystemCall::sc_LoadAttributes)
+            + this->getCalls(SystemCall::sc_Exists)
+            + this->getCalls(SystemCall::sc_FileExists)
+            + this->getCalls(SystemCall::sc_DirectoryExists);
+      }
+      case SystemStat::ss_FileOpens: {
+         return this->getCalls(SystemCall::sc_MapFile)
+            + this->getCalls(SystemCall::sc_ReadFileStart);
+      }
+      case SystemStat::ss_BytesRead: {
+         return this->bytesRead.load(std::memory_order_relaxed);
+      }
+      case SystemStat::ss_BytesWritten: {
+         return this->bytesWritten.load(std::memory_order_relaxed);
+      }
+      default: {
+         return 0;
+      }
+   }
+}
+
+p_bool SystemStats::anyModification() const
+{
+   for (p_size i = 0; i < SystemCall::sc_Count; i++) {
+      if (SYSTEM_CALL_MODIFIES[i] && this->calls[i].calls.load(std::memory_order_relaxed) > 0) {
+         return true;
+      }
+   }
+
+   return false;
+}
+
+uint64_t SystemStats::getPercentile(const SystemCall call, const double fraction) const
+{
+   const SystemCallStats& stats = this->calls[call];
+   uint64_t total = 0;
+
+   for (const std::atomic<uint64_t>& bucket : stats.latencies) {
+      total += bucket.load(std::memory_order_relaxed);
+   }
+
+   if (total == 0) {
+      return 0;
+   }
+
+   const uint64_t wanted = static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(total)));
+   uint64_t seen = 0;
+
+   for (p_size i = 0; i < STATS_LATENCY_BUCKETS; i++) {
+      seen += stats.latencies[i].load(std::memory_order_relaxed);
+
+      if (seen >= wanted) {
+         return (static_cast<uint64_t>(1) << i) * 1000;
+      }
+   }
+
+   return (static_cast<uint64_t>(1) << (STATS_LATENCY_BUCKETS - 1)) * 1000;
+}
+
+void SystemStats::print(Perun2Process& p2) const
+{
+   p2.logger.emptyLine();
+   p2.logger.print(L"Statistics:");
+   p2.logger.print(str(L"directory opens: ", toStr(this->get(SystemStat::ss_DirectoryOpens)),
+      L", entry reads: ", toStr(this->get(SystemStat::ss_EntryReads)),
+      L", attribute queries: ", toStr(this->get(SystemStat::ss_AttributeQueries)),
+      L", file opens: ", toStr(this->get(SystemStat::ss_FileOpens))));
+   p2.logger.print(str(L"bytes read: ", toStr(this->get(SystemStat::ss_BytesRead)),
+      L", bytes written: ", toStr(this->get(SystemStat::ss_BytesWritten))));
+
+   const MediaStats& media = p2.mediaStats;
+   p2.logger.print(str(L"media skipped by extension: ", toStr(media.skippedByExtension),
+      L", skipped by signature: ", toStr(media.skippedBySignature),
+      L", read from header: ", toStr(media.readFromHeader),
+      L", read from cache: ", toStr(media.readFromCache),
+      L", opened by FFmpeg: ", toStr(media.openedByFfmpeg)));
+
+   p2.logger.print(L"call, calls, time (ms), p50 (us), p90 (us), p99 (us)");
+
+   for (p_size i = 0; i < SystemCall::sc_Count; i++) {
+      const SystemCall call = static_cast<SystemCall>(i);
+      const uint64_t count = this->getCalls(call);
+
+      if (count == 0) {
+         continue;
+      }
+
+      p_ostream time;
+      time << std::fixed << std::setprecision(3)
+         << (static_cast<double>(this->calls[i].time.load(std::memory_order_relaxed)) / 1000000.0);
+
+      p2.logger.print(str(SYSTEM_CALL_NAMES[i], L", ",
+         toStr(count), L", ",
+         time.str(), L", ",
+         toStr(this->getPercentile(call, 0.5) / 1000), L", ",
+         toStr(this->getPercentile(call, 0.9) / 1000), L", ",
+         toStr(this->getPercentile(call, 0.99) / 1000)));
+   }
+}
+
+void SystemStats::countRead(const uint64_t bytes)
+{
+   if (SystemStats::active != nullptr) {
+      SystemStats::active->addBytesRead(bytes);
+   }
+}
+
+}
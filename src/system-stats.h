@@ -0,0 +1,154 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "datatype/primitives.h"
+#include <array>
+#include <atomic>
+
+
+namespace perun2
+{
+
+struct Perun2Process;
+
+
+// wrappers of the operating system, that are counted and measured
+enum SystemCall : uint8_t
+{
+   sc_HasFirstFile = 0,
+   sc_HasNextFile,
+   sc_LoadAttributes,
+   sc_LoadDataAttributes,
+   sc_Exists,
+   sc_FileExists,
+   sc_DirectoryExists,
+   sc_ReadFile,
+   sc_ReadFileStart,
+   sc_MapFile,
+   sc_CreateFile,
+   sc_CreateDirectory,
+   sc_CopyTo,
+   sc_MoveTo,
+   sc_Drop,
+   sc_Delete,
+   sc_Hide,
+   sc_Unhide,
+   sc_Lock,
+   sc_Unlock,
+   sc_SetTime,
+   sc_Open,
+   sc_OpenAsCommand,
+   sc_Run,
+   sc_ContentHash,
+   sc_MediaAttributes,
+   sc_Count
+};
+
+// names of system calls, in the order of the enum
+extern const p_char* const SYSTEM_CALL_NAMES[SystemCall::sc_Count];
+
+// calls that change the file system or start other programs, in the order of the enum
+extern const p_bool SYSTEM_CALL_MODIFIES[SystemCall::sc_Count];
+
+
+// totals available to the script as read-only variables
+enum SystemStat : uint8_t
+{
+   // os_hasFirstFile
+   ss_DirectoryOpens = 0,
+   // os_hasNextFile
+   ss_EntryReads,
+   // os_loadAttributes and all checks of existence
+   ss_AttributeQueries,
+   // files opened to read their content
+   ss_FileOpens,
+   ss_BytesRead,
+   ss_BytesWritten
+};
+
+
+// bucket 0 holds calls shorter than 1 microsecond
+// every next bucket holds calls twice as long as the previous one
+// the last bucket holds everything longer
+p_constexpr p_size STATS_LATENCY_BUCKETS = 24;
+
+
+struct SystemCallStats
+{
+   std::atomic<uint64_t> calls;
+   // in nanoseconds
+   std::atomic<uint64_t> time;
+   std::atomic<uint64_t> latencies[STATS_LATENCY_BUCKETS];
+};
+
+
+// how many times a script has used the file system and how long it took
+// counters are shared by all threads working for one Perun2 process
+// so they are relaxed atomics, that only count and never synchronize anything
+// calls are always counted, durations are measured only with the option --stats
+struct SystemStats
+{
+public:
+   SystemStats() = delete;
+   SystemStats(const p_bool measured);
+
+   void reset();
+
+   void addCall(const SystemCall call)
+   {
+      this->calls[call].calls.fetch_add(1, std::memory_order_relaxed);
+   };
+
+   void addDuration(const SystemCall call, const uint64_t nanoseconds);
+
+   void addBytesRead(const uint64_t bytes)
+   {
+      this->bytesRead.fetch_add(bytes, std::memory_order_relaxed);
+   };
+
+   void addBytesWritten(const uint64_t bytes)
+   {
+      this->bytesWritten.fetch_add(bytes, std::memory_order_relaxed);
+   };
+
+   uint64_t getCalls(const SystemCall call) const;
+   uint64_t get(const SystemStat stat) const;
+
+   // any call that modifies something has been made
+   p_bool anyModification() const;
+
+   // upper bound of the duration in nanoseconds, that this fraction of calls did not exceed
+   uint64_t getPercentile(const SystemCall call, const double fraction) const;
+
+   // summary printed at the end of the run
+   void print(Perun2Process& p2) const;
+
+   // durations are measured
+   const p_bool measured;
+
+   // statistics of the process running on this thread, if any
+   static thread_local SystemStats* active;
+
+   // bytes read on behalf of the process running on this thread
+   static void countRead(const uint64_t bytes);
+
+private:
+   std::array<SystemCallStats, SystemCall::sc_Count> calls;
+   std::atomic<uint64_t> bytesRead;
+   std::atomic<uint64_t> bytesWritten;
+};
+
+}
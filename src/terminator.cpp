@@ -21,6 +21,8 @@ namespace perun2
 
 p_bool Terminator::initialized = false;
 std::unordered_set<Perun2Process*> Terminator::processes;
+std::mutex Terminator::mutex;
+void (*Terminator::shutdown)() = nullptr;
 
 
 void Terminator::init()
@@ -33,21 +35,38 @@ void Terminator::init()
 
 void Terminator::addPtr(Perun2Process* p2)
 {
+   const std::lock_guard<std::mutex> lock(mutex);
    processes.insert(p2);
 }
 
 void Terminator::removePtr(Perun2Process* p2)
 {
+   const std::lock_guard<std::mutex> lock(mutex);
    processes.erase(p2);
 }
 
+void Terminator::setShutdown(void (*action)())
+{
+   const std::lock_guard<std::mutex> lock(mutex);
+   shutdown = action;
+}
+
 p_int Terminator::HandlerRoutine(p_ulong dwCtrlType)
 {
    switch (dwCtrlType) {
-      case CTRL_C_EVENT: {
+      // Ctrl+Break is the only signal, that reaches a process started in its own group
+      case CTRL_C_EVENT:
+      case CTRL_BREAK_EVENT: {
+         const std::lock_guard<std::mutex> lock(mutex);
+
          for (Perun2Process* p : processes) {
             p->terminate();
          }
+
+         if (shutdown != nullptr) {
+            shutdown();
+         }
+
          return TRUE;
       }
       default: {
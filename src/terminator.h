@@ -16,6 +16,7 @@
 
 #include "datatype/primitives.h"
 #include <unordered_set>
+#include <mutex>
 
 
 namespace perun2
@@ -26,7 +27,9 @@ struct Perun2Process;
 // Terminator keeps track of every initialized instance of Perun2
 // it overrides the default Ctrl+C termination signal
 // when this event happens, all Perun2 instances are stopped softly (as their commands are designed to be atomic)
+// the handler only cancels their tokens, every instance notices it at the next check of its own
 // works only, if Terminator has been initialized
+// instances can be created and destroyed on many threads at once
 struct Terminator
 {
 public:
@@ -36,9 +39,15 @@ public:
    static void addPtr(Perun2Process* p2);
    static void removePtr(Perun2Process* p2);
 
+   // optional action performed after all instances are stopped
+   // the daemon mode uses it to stop accepting new jobs
+   static void setShutdown(void (*action)());
+
 private:
    static p_bool initialized;
    static std::unordered_set<Perun2Process*> processes;
+   static std::mutex mutex;
+   static void (*shutdown)();
    static p_int HandlerRoutine(p_ulong dwCtrlType);
 };
 
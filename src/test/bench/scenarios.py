@@ -0,0 +1,199 @@
+import argparse
+import json
+import math
+import os
+import random
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+ENCODING = "utf-8"
+EXIT_CODE_OK = 0
+SCENARIOS_DIRECTORY = os.path.join(os.path.dirname(os.path.abspath(__file__)), "scenarios")
+SCENARIO_EXTENSION = ".peru"
+DATA_DIRECTORY = "data"
+BACKUP_DIRECTORY = "backup"
+DEFAULT_SEED = 2024
+DEFAULT_RUNS = 10
+DEFAULT_WARMUP = 1
+PERCENTILES = (50, 90, 99)
+WORDS = ("alpha", "beta", "gamma", "delta", "report", "invoice", "summary", "notes", "draft", "final")
+NEEDLE = "perun"
+# chance of a text file to contain the searched word
+NEEDLE_PROBABILITY = 0.2
+BLOCK_SIZE = 64 * 1024
+
+# depth: levels of directories below the root
+# branching: subdirectories of every directory, chosen between the two values
+# files: files in every directory, chosen between the two values
+# sizes: size of every file in bytes, chosen between the two values
+SHAPES = {
+  "deep": { "depth": 12, "branching": (1, 2), "files": (3, 8), "sizes": (0, 16 * 1024) },
+  "wide": { "depth": 2, "branching": (30, 40), "files": (20, 60), "sizes": (0, 4 * 1024) },
+  "tiny": { "depth": 3, "branching": (6, 10), "files": (50, 100), "sizes": (0, 512) },
+  "large": { "depth": 1, "branching": (2, 3), "files": (2, 5), "sizes": (4 * 1024 * 1024, 16 * 1024 * 1024) },
+  "mixed": { "depth": 4, "branching": (2, 4), "files": (5, 20), "sizes": (0, 64 * 1024) },
+}
+EXTENSIONS = ("txt", "txt", "csv", "log", "jpg", "pdf", "docx", "bin")
+TEXT_EXTENSIONS = ("txt", "csv", "log")
+
+
+# trees are reproducible: the same seed and the same shape give the same names, sizes and contents
+class TreeGenerator:
+  def __init__(self, shape, seed):
+    self.shape = shape
+    self.random = random.Random(seed)
+    self.block = bytes(self.random.getrandbits(8) for _ in range(BLOCK_SIZE))
+    self.text = self.make_text_block()
+    self.files = 0
+    self.directories = 0
+    self.bytes = 0
+
+  def generate(self, root):
+    os.makedirs(root)
+    self.fill(root, 0)
+
+  def fill(self, directory, level):
+    for index in range(self.random.randint(*self.shape["files"])):
+      self.write_file(directory, index)
+    if level >= self.shape["depth"]:
+      return
+    for index in range(self.random.randint(*self.shape["branching"])):
+      subdirectory = os.path.join(directory, "dir_" + str(level) + "_" + str(index))
+      os.mkdir(subdirectory)
+      self.directories += 1
+      self.fill(subdirectory, level + 1)
+
+  def write_file(self, directory, index):
+    extension = self.random.choice(EXTENSIONS)
+    size = self.random.randint(*self.shape["sizes"])
+    name = self.random.choice(WORDS) + "_" + str(index) + "." + extension
+    with open(os.path.join(directory, name), "wb") as file:
+      if extension in TEXT_EXTENSIONS:
+        self.write_text(file, size)
+      else:
+        self.write_binary(file, size)
+    self.files += 1
+    self.bytes += size
+
+  def make_text_block(self):
+    words = []
+    length = 0
+    while length < BLOCK_SIZE:
+      word = self.random.choice(WORDS)
+      words.append(word)
+      length += len(word) + 1
+    return " ".join(words).encode(ENCODING)[:BLOCK_SIZE]
+
+  def write_text(self, file, size):
+    # the searched word is put somewhere inside of some files
+    needle = size >= len(NEEDLE) and self.random.random() < NEEDLE_PROBABILITY
+    position = self.random.randrange(size - len(NEEDLE) + 1) if needle else -1
+    self.write_repeated(file, self.text, size, position)
+
+  def write_binary(self, file, size):
+    self.write_repeated(file, self.block, size, -1)
+
+  def write_repeated(self, file, block, size, needle_position):
+    # a random part of one block, repeated, so large files are generated fast
+    offset = self.random.randrange(len(block))
+    written = 0
+    while written < size:
+      part = block[offset:offset + size - written]
+      if written <= needle_position < written + len(part):
+        start = needle_position - written
+        part = (part[:start] + NEEDLE.encode(ENCODING) + part[start + len(NEEDLE):])[:size - written]
+      file.write(part)
+      written += len(part)
+      offset = 0
+
+def percentile(values, fraction):
+  ordered = sorted(values)
+  index = max(0, math.ceil(fraction / 100 * len(ordered)) - 1)
+  return ordered[index]
+
+def run_scenario(perun2, location, script):
+  start = time.perf_counter()
+  p = subprocess.run([perun2, "-s", "-d", location, script], stdout=subprocess.DEVNULL, stderr=subprocess.PIPE)
+  elapsed = time.perf_counter() - start
+  if p.returncode != EXIT_CODE_OK:
+    raise RuntimeError("Scenario " + script + " failed with exit code " + str(p.returncode))
+  backup = os.path.join(location, BACKUP_DIRECTORY)
+  if os.path.isdir(backup):
+    shutil.rmtree(backup)
+  return elapsed * 1000
+
+def measure(perun2, location, script, runs, warmup):
+  for _ in range(warmup):
+    run_scenario(perun2, location, script)
+  times = [run_scenario(perun2, location, script) for _ in range(runs)]
+  result = { "runs": runs, "min_ms": min(times), "mean_ms": sum(times) / len(times) }
+  for p in PERCENTILES:
+    result["p" + str(p) + "_ms"] = percentile(times, p)
+  return result
+
+def find_scenarios(names):
+  scripts = sorted(f for f in os.listdir(SCENARIOS_DIRECTORY) if f.endswith(SCENARIO_EXTENSION))
+  if names:
+    scripts = [s for s in scripts if s[:-len(SCENARIO_EXTENSION)] in names]
+  return [os.path.join(SCENARIOS_DIRECTORY, s) for s in scripts]
+
+def parse_arguments():
+  parser = argparse.ArgumentParser(description="Generate a synthetic file system tree and time Perun2 scenarios on it.")
+  parser.add_argument("--perun2", default="perun2", help="path to the executable of Perun2")
+  parser.add_argument("--shape", default="mixed", choices=sorted(SHAPES), help="shape of the tree")
+  parser.add_argument("--seed", type=int, default=DEFAULT_SEED, help="seed of the tree")
+  parser.add_argument("--depth", type=int, help="override levels of directories")
+  parser.add_argument("--branching", type=int, nargs=2, metavar=("MIN", "MAX"), help="override subdirectories per directory")
+  parser.add_argument("--files", type=int, nargs=2, metavar=("MIN", "MAX"), help="override files per directory")
+  parser.add_argument("--sizes", type=int, nargs=2, metavar=("MIN", "MAX"), help="override file sizes in bytes")
+  parser.add_argument("--runs", type=int, default=DEFAULT_RUNS, help="measured runs of every scenario")
+  parser.add_argument("--warmup", type=int, default=DEFAULT_WARMUP, help="runs before measuring, that fill the caches")
+  parser.add_argument("--scenario", action="append", help="run only this scenario, can be repeated")
+  parser.add_argument("--json", help="write results to this file")
+  parser.add_argument("--keep", action="store_true", help="do not delete the tree at the end")
+  parser.add_argument("--generate-only", action="store_true", help="only generate the tree and print its location")
+  return parser.parse_args()
+
+def make_shape(args):
+  shape = dict(SHAPES[args.shape])
+  for key in ("depth", "branching", "files", "sizes"):
+    value = getattr(args, key)
+    if value is not None:
+      shape[key] = tuple(value) if isinstance(value, list) else value
+  return shape
+
+
+if __name__ == '__main__':
+  args = parse_arguments()
+  shape = make_shape(args)
+  location = tempfile.mkdtemp(prefix="perun2-bench-")
+  generator = TreeGenerator(shape, args.seed)
+  generator.generate(os.path.join(location, DATA_DIRECTORY))
+
+  print("Tree '" + args.shape + "' with seed " + str(args.seed) + " in " + location)
+  print("  " + str(generator.directories) + " directories, " + str(generator.files) + " files, " + str(generator.bytes) + " bytes")
+
+  if args.generate_only:
+    sys.exit(EXIT_CODE_OK)
+
+  results = { "shape": args.shape, "seed": args.seed, "tree": shape, "directories": generator.directories,
+    "files": generator.files, "bytes": generator.bytes, "scenarios": {} }
+
+  try:
+    print("scenario, runs, min (ms), mean (ms), " + ", ".join("p" + str(p) + " (ms)" for p in PERCENTILES))
+    for script in find_scenarios(args.scenario):
+      name = os.path.basename(script)[:-len(SCENARIO_EXTENSION)]
+      result = measure(args.perun2, location, script, args.runs, args.warmup)
+      results["scenarios"][name] = result
+      print(", ".join([name, str(result["runs"]), "%.3f" % result["min_ms"], "%.3f" % result["mean_ms"]]
+        + ["%.3f" % result["p" + str(p) + "_ms"] for p in PERCENTILES]))
+  finally:
+    if not args.keep:
+      shutil.rmtree(location, ignore_errors=True)
+
+  if args.json:
+    with open(args.json, "w", encoding=ENCODING) as file:
+      json.dump(results, file, indent=2)
@@ -1,5 +1,11 @@
 import subprocess
 import os
+import time
+import queue
+import threading
+import signal
+import shutil
+import msvcrt
 
 EMPTY_STRING = ""
 NOTHING = ""
@@ -15,14 +21,33 @@ FALSE = "0"
 NAN = "NaN"
 NEVER = "never"
 NO_PERIOD = "no period"
+SCRIPT_CACHE_EXTENSION = ".p2c"
+# offsets of fields of the header of a script cache file
+SCRIPT_CACHE_FORMAT_OFFSET = 4
+SCRIPT_CACHE_TOKEN_COUNT_OFFSET = 24
+DAEMON_PIPE = "\\\\.\\pipe\\perun2"
+DAEMON_TIMEOUT_SECONDS = 30
+# a fresh directory for every run of a test of pipelined transfers
+PIPELINE_DIRECTORY = os.path.join("res", "modificables", "pipeline")
+# the longest wait for the next line printed by the watch mode
+WATCH_TIMEOUT_SECONDS = 30
+# longer than the pause, after which the watch mode considers a burst of changes to be over
+WATCH_IGNORED_SECONDS = 2
 
 os.environ['PYTHONIOENCODING'] = ENCODING
 
-def make_process(code):
-  return subprocess.Popen(['perun2', '-d', 'res', '-c', code], stdin=subprocess.PIPE, stdout=subprocess.PIPE)
+def make_process(code, options=[]):
+  return subprocess.Popen(['perun2'] + options + ['-d', 'res', '-c', code], stdin=subprocess.PIPE, stdout=subprocess.PIPE)
 
-def run_test_case(code, expectedOutput):
-  p = make_process(code)
+def run_test_case(code, expectedOutput, options=[]):
+  check_process(make_process(code, options), code, expectedOutput)
+
+# the code is read from a script file instead of the command line
+def run_script_file_test_case(filePath, expectedOutput):
+  p = subprocess.Popen(['perun2', filePath], stdin=subprocess.PIPE, stdout=subprocess.PIPE)
+  check_process(p, filePath, expectedOutput)
+
+def check_process(p, code, expectedOutput):
   output = p.communicate()[0].decode(ENCODING)
   output = output.replace('\r\n', NEW_LINE).replace('\r', NEW_LINE)[:-1]
   if p.returncode != EXIT_CODE_OK:
@@ -35,6 +60,182 @@ def run_test_case(code, expectedOutput):
     print("  Received output:" + NEW_LINE + output)
     print("  Expected output:" + NEW_LINE + expectedOutput)
     
+# the watch mode runs until it is killed, so its output is read line by line by another thread
+# every step performs its action and waits for the next line, but never longer than the timeout
+def run_watch_test_case(code, steps):
+  p = make_process(code, ["--watch"])
+  output = queue.Queue()
+
+  def read():
+    for line in p.stdout:
+      output.put(line.decode(ENCODING).rstrip("\r\n"))
+
+  threading.Thread(target=read, daemon=True).start()
+
+  for action, expectedLine in steps:
+    if action is not None:
+      action()
+    try:
+      line = output.get(timeout=WATCH_TIMEOUT_SECONDS)
+    except queue.Empty:
+      line = "(nothing)"
+    if line != expectedLine:
+      print("Test failed at watching code: " + code)
+      print("  Received line:" + NEW_LINE + line)
+      print("  Expected line:" + NEW_LINE + expectedLine)
+      break
+
+  p.kill()
+  p.wait(timeout=WATCH_TIMEOUT_SECONDS)
+
+def write_file(filePath):
+  def action():
+    with open(filePath, "w") as file:
+      file.write("x")
+  return action
+
+def touch_file(filePath):
+  def action():
+    write_file(filePath)()
+    os.remove(filePath)
+  return action
+
+# a change, that should not start the script, gets this much time to start it
+# only then the next change is made, so a wrong run would print its output first
+def ignored_change(ignoredAction, nextAction):
+  def action():
+    ignoredAction()
+    time.sleep(WATCH_IGNORED_SECONDS)
+    nextAction()
+  return action
+
+def remove_files(*paths):
+  for filePath in paths:
+    if os.path.exists(filePath):
+      os.remove(filePath)
+
+# the file stays open for writing by this process, while perun2 reads it
+def run_open_file_test_case(filePath, content, code, expectedOutput):
+  with open(filePath, "w", encoding=ENCODING) as file:
+    file.write(content)
+    file.flush()
+    run_test_case(code, expectedOutput)
+  os.remove(filePath)
+
+# the code runs without and with the flag -a, every time in a fresh pipeline directory
+# pipelined transfers have to print the same logs and leave the same files as the usual ones
+# a locked file cannot be read by perun2, so copying it fails
+def run_pipeline_test_case(prepare, code, expectedOutput, lockedFile=None):
+  results = []
+  for options in ([], ["-a"]):
+    prepare()
+    if lockedFile is None:
+      run_test_case(code, expectedOutput, options)
+    else:
+      lockedPath = os.path.join(PIPELINE_DIRECTORY, lockedFile)
+      size = os.path.getsize(lockedPath)
+      with open(lockedPath, "rb") as file:
+        msvcrt.locking(file.fileno(), msvcrt.LK_NBLCK, size)
+        run_test_case(code, expectedOutput, options)
+        file.seek(0)
+        msvcrt.locking(file.fileno(), msvcrt.LK_UNLCK, size)
+    results.append(tree_content(PIPELINE_DIRECTORY))
+    shutil.rmtree(PIPELINE_DIRECTORY)
+  if results[0] != results[1]:
+    print("Test failed at comparing files left with and without the flag -a by code: " + code)
+
+def tree_content(directory):
+  result = {}
+  for root, directories, files in os.walk(directory):
+    for name in files:
+      filePath = os.path.join(root, name)
+      with open(filePath, "rb") as file:
+        result[os.path.relpath(filePath, directory)] = file.read()
+  return result
+
+def copy_to_pipeline(source):
+  def prepare():
+    shutil.copytree(source, PIPELINE_DIRECTORY)
+  return prepare
+
+def write_to_pipeline(files):
+  def prepare():
+    for name, content in files.items():
+      filePath = os.path.join(PIPELINE_DIRECTORY, name)
+      os.makedirs(os.path.dirname(filePath), exist_ok=True)
+      with open(filePath, "w", encoding=ENCODING) as file:
+        file.write(content)
+  return prepare
+
+# the script runs with the option -p, then its cache file is damaged and the script runs again
+# a damaged cache is ignored, so the output is the same every time
+def run_script_cache_test_case(code, expectedOutput, damage):
+  run_test_case(code, expectedOutput, ["-p"])
+  run_test_case(code, expectedOutput, ["-p"])
+  directory = path(os.environ["LOCALAPPDATA"], "Perun2", "cache")
+  caches = [path(directory, name) for name in os.listdir(directory) if name.endswith(SCRIPT_CACHE_EXTENSION)]
+  damage(max(caches, key=os.path.getmtime))
+  run_test_case(code, expectedOutput, ["-p"])
+
+def overwrite_file(offset, content):
+  def damage(filePath):
+    with open(filePath, "r+b") as file:
+      file.seek(offset)
+      file.write(content)
+  return damage
+
+def truncate_file(size):
+  def damage(filePath):
+    os.truncate(filePath, size)
+  return damage
+
+# the pipe appears, when the daemon is ready
+def open_daemon_pipe():
+  deadline = time.monotonic() + DAEMON_TIMEOUT_SECONDS
+  while True:
+    try:
+      return open(DAEMON_PIPE, "r+b", buffering=0)
+    except OSError:
+      if time.monotonic() > deadline:
+        return None
+      time.sleep(0.1)
+
+# one job is flags, location and code separated by null characters
+# the answer is the output and then a null character followed by the exit code
+def send_daemon_job(pipe, code):
+  pipe.write(("0\0" + os.path.abspath("res") + "\0" + code).encode("utf-16-le"))
+  answer = ""
+  while answer.find("\0") == -1 or answer.endswith("\0"):
+    answer += pipe.read(65536).decode("utf-16-le")
+  output, exitCode = answer.split("\0")
+  return output.replace('\r\n', NEW_LINE)[:-1], int(exitCode)
+
+# the daemon is started, every job is sent through its pipe and then the daemon is stopped by Ctrl+Break
+def run_daemon_test_case(jobs):
+  p = subprocess.Popen(['perun2', '--daemon'], stdout=subprocess.PIPE,
+    creationflags=subprocess.CREATE_NEW_PROCESS_GROUP)
+  pipe = open_daemon_pipe()
+  if pipe is None:
+    print("Test failed at connecting to the daemon")
+  else:
+    with pipe:
+      for code, expectedOutput, expectedExitCode in jobs:
+        output, exitCode = send_daemon_job(pipe, code)
+        if output != expectedOutput or exitCode != expectedExitCode:
+          print("Test failed at running code by the daemon: " + code)
+          print("  Received exit code:" + NEW_LINE + str(exitCode))
+          print("  Received output:" + NEW_LINE + output)
+          print("  Expected output:" + NEW_LINE + expectedOutput)
+  p.send_signal(signal.CTRL_BREAK_EVENT)
+  try:
+    exitCode = p.wait(timeout=DAEMON_TIMEOUT_SECONDS)
+  except subprocess.TimeoutExpired:
+    p.kill()
+    exitCode = None
+  if exitCode != EXIT_CODE_OK:
+    print("Test failed at stopping the daemon")
+    print("  Received exit code:" + NEW_LINE + str(exitCode))
+
 def expect_exit_code(code, exitCode, errorName):
   p = make_process(code)
   p.communicate()
@@ -6670,6 +6871,112 @@ if __name__ == '__main__':
   expect_syntax_error("print 'a' not in resembles 'b' ")
   expect_syntax_error("print 'a' not like resembles 'b' ")
 
+  run_test_case("print fileopens", "0")
+  run_test_case("print byteswritten", "0")
+  run_test_case("print bytesread + entryreads", "0")
+  expect_syntax_error("byteswritten = 5")
+  expect_syntax_error("directoryopens += 1")
+
+  run_test_case("print 'a', 'b'", lines("a", "b"), ["--output=text"])
+  run_test_case("print 'say \"hi\"'", '"say \\"hi\\""', ["--output=json"])
+  run_test_case("print 'a', 'b\\c'", '["a","b\\\\c"]', ["--output=json"])
+  run_test_case("print 'a', 'b' where this = 'c'", "[]", ["--output=json"])
+  run_test_case("inside 'search' { 'plain.txt' { countText(('aba', 'xyz')), countText(('aba', 'bab')), countText(('aba', 'aba')) } }", lines("3", "5", "3"))
+  run_test_case("inside 'search' { 'plain.txt' { countText(('ban', 'banana', 'an')), findAnyText(('bananas', 'nan')), findAnyText(('bananas', 'abc')) } }", lines("4", TRUE, FALSE))
+  run_test_case("inside 'search' { 'plain.txt' { findAnyText(('', 'xyz')), countText(('', 'ana')) } }", lines(TRUE, "2"))
+  run_test_case("e = split('', ','); inside 'search' { 'plain.txt' { findAnyText(e), countText(e) } }", lines(FALSE, "0"))
+  run_test_case("inside 'search' { 'utf16le.txt' { countText(('aba', 'ana')), findAnyText(('xyz', 'nana')), findAnyText(('abc', 'xyz')) } }", lines("5", TRUE, FALSE))
+  run_test_case("inside 'search' { 'utf16be.txt' { countText(('aba', 'ana')), findAnyText(('xyz', 'nana')), findAnyText(('abc', 'xyz')) } }", lines("5", TRUE, FALSE))
+  run_test_case("inside 'search' { 'binary.bin' { findAnyText(('aba', 'ana')), countText(('aba', 'ana')) } }", lines(FALSE, "0"))
+  run_test_case("inside 'search' { files where findAnyText(('nana', 'xyz')) order by name }", lines("plain.txt", "utf16be.txt", "utf16le.txt"))
+  run_test_case("inside 'search' { 'missing.txt' { findAnyText(('aba', 'ana')), countText(('aba', 'ana')) } }", lines(FALSE, NAN))
+  run_test_case("inside 'search' { 'bom.txt' { findText('gęślą'), findText('zażółć gęślą jaźń'), findText('jaźni') } }", lines(TRUE, TRUE, FALSE))
+  run_test_case("inside 'search' { 'polish16le.txt' { findText('gęślą'), findText('zażółć gęślą jaźń'), findText('jaźni') } }", lines(TRUE, TRUE, FALSE))
+  run_test_case("inside 'search' { 'polish16be.txt' { findText('gęślą'), findText('zażółć gęślą jaźń'), findText('jaźni') } }", lines(TRUE, TRUE, FALSE))
+  run_test_case("inside 'search' { 'utf16le.txt' { findText('a b'), findText('ab ') } }", lines(TRUE, FALSE))
+  run_test_case("inside 'search' { 'utf16be.txt' { findText('a b'), findText('ab ') } }", lines(TRUE, FALSE))
+  run_test_case("inside 'search' { 'blocks.txt' { findText('needle'), findText('thread'), findText('xneedley'), findText('ythreadz'), findText('needles') } }",
+    lines(TRUE, TRUE, TRUE, TRUE, FALSE))
+  run_test_case("inside 'search' { 'blocks.txt' { findText('x'), findText('zzzzzzzzzzzz'), findText('zzzzzzzzzzzzz'), findText('') } }", lines(TRUE, TRUE, FALSE, TRUE))
+  run_test_case("inside 'search' { 'binary.bin' { findText('aba'), findText('banana') } }", lines(FALSE, FALSE))
+  run_test_case("inside 'search' { files where findText('gęślą') order by name }", lines("bom.txt", "polish16be.txt", "polish16le.txt"))
+  run_test_case("inside 'search' { 'missing.txt' { findText('aba') } }", FALSE)
+  run_open_file_test_case(path("res", "search", "open.txt"), "growing log" + NEW_LINE,
+    "inside 'search' { 'open.txt' { findText('growing'), findText('shrinking') } }", lines(TRUE, FALSE))
+  run_script_file_test_case(path("res", "decode", "crlf.peru"), lines("22", "done"))
+  run_script_file_test_case(path("res", "decode", "bom.peru"), lines("3", "ą"))
+  run_script_file_test_case(path("res", "decode", "invalid.peru"), lines("5", TRUE))
+  run_script_file_test_case(path("res", "decode", "surrogates.peru"), lines("2", "😀", TRUE))
+  run_script_file_test_case(path("res", "decode", "utf16.peru"), lines("3", "zażółć", "2"))
+  run_test_case("inside 'hashes' { 'empty.txt' { hash, crc32 } }", lines("ef46db3751d8e999", "0"))
+  run_test_case("inside 'hashes' { 'abc.txt' { hash, crc32 } }", lines("44bc2cf5ad770999", "910901175"))
+  run_test_case("inside 'hashes' { 'abd.txt' { hash, crc32 } }", lines("6a8740cb78d5c8d2", "3800128348"))
+  run_test_case("inside 'hashes' { 'digits.txt' { hash, crc32 } }", lines("8cb841db40e6ae83", "3808858755"))
+  run_test_case("inside 'hashes' { 'long.txt' { hash, crc32 } }", lines("efe5626df58de6ae", "929753531"))
+  run_test_case("inside 'hashes' { 'missing.txt' { hash, crc32 } }", lines(EMPTY_STRING, NAN))
+  run_test_case("inside 'hashes' { files where crc32 = 910901175 order by name }", lines("abc copy.txt", "abc.txt"))
+  run_test_case("inside 'hashes' { files where hash = '6a8740cb78d5c8d2' }", "abd.txt")
+  run_test_case("inside 'hashes' { 'abc.txt' { sameContent('abc copy.txt'), sameContent('abd.txt'), sameContent('long.txt'), sameContent('missing.txt'), sameContent('') } }",
+    lines(TRUE, FALSE, FALSE, FALSE, FALSE))
+  run_test_case("inside 'hashes' { 'empty.txt' { sameContent('empty.txt'), sameContent('abc.txt') } }", lines(TRUE, FALSE))
+  run_test_case("inside 'hashes' { files where sameContent('abc.txt') order by name }", lines("abc copy.txt", "abc.txt"))
+  run_test_case("inside 'duplicates' { duplicates order by fullname { fullname } }", lines("big1.bin", "big2.bin", "same1.txt", "same2.txt", "same3.txt"))
+  run_test_case("inside 'duplicates' { duplicates order by fullname { depth } }", lines("0", "0", "0", "0", "1"))
+  run_test_case("inside 'duplicates' { count(duplicates), count(duplicates where extension = 'bin'), count(duplicates where size < 100) }", lines("5", "2", "3"))
+  run_test_case("inside 'duplicates' { duplicates where size > 100 order by fullname { fullname } }", lines("big1.bin", "big2.bin"))
+  run_test_case("inside 'duplicates/sub' { count(duplicates) }", "0")
+  run_script_cache_test_case("print 'cached', 'script' order by this desc", lines("script", "cached"),
+    overwrite_file(SCRIPT_CACHE_TOKEN_COUNT_OFFSET, b"\xff" * 8))
+  run_script_cache_test_case("print 'cached', 'script' order by this", lines("cached", "script"),
+    overwrite_file(SCRIPT_CACHE_TOKEN_COUNT_OFFSET, b"\x00\x00\x00\x00\x00\x00\x00\x10"))
+  run_script_cache_test_case("print 'stale' + 1", "stale1", overwrite_file(SCRIPT_CACHE_FORMAT_OFFSET, b"\x00\x00\x00\x00"))
+  run_script_cache_test_case("print 'short' + 2", "short2", truncate_file(40))
+  run_script_cache_test_case("print 'empty' + 3", "empty3", truncate_file(0))
+  run_test_case("'a', 'b' { print this }", lines("a", "b"), ["--jobs=4"])
+  run_test_case("3, 1, 2 { run 'ping -n ' + this + ' 127.0.0.1' }",
+    lines("Run 'ping -n 3 127.0.0.1'", "Run 'ping -n 1 127.0.0.1'", "Run 'ping -n 2 127.0.0.1'"), ["--jobs=2"])
+  run_test_case("3, 1, 2, 1 { run 'ping -n ' + this + ' 127.0.0.1' }",
+    lines("Run 'ping -n 3 127.0.0.1'", "Run 'ping -n 1 127.0.0.1'", "Run 'ping -n 2 127.0.0.1'", "Run 'ping -n 1 127.0.0.1'"), ["--jobs=8"])
+  run_test_case("0, 0 { run 'cmd /c exit ' + this }; print success",
+    lines("Run 'cmd /c exit 0'", "Run 'cmd /c exit 0'", TRUE), ["--jobs=2"])
+  run_test_case("0, 1, 0 { run 'cmd /c exit ' + this }; print success",
+    lines("Run 'cmd /c exit 0'", "Failed to run 'cmd /c exit 1'", "Run 'cmd /c exit 0'", TRUE), ["--jobs=3"])
+  run_test_case("0, 0, 1 { run 'cmd /c exit ' + this }; print success",
+    lines("Run 'cmd /c exit 0'", "Run 'cmd /c exit 0'", "Failed to run 'cmd /c exit 1'", FALSE), ["--jobs=2"])
+  run_test_case("0, 1, 0 { run 'cmd /c exit ' + this; print success }",
+    lines("Run 'cmd /c exit 0'", TRUE, "Failed to run 'cmd /c exit 1'", FALSE, "Run 'cmd /c exit 0'", TRUE), ["--jobs=2"])
+  manyTexts = ["ex_%02d.txt" % i for i in range(1, 31)]
+  run_pipeline_test_case(copy_to_pipeline(path("res", "many texts")),
+    "inside 'modificables/pipeline' { copy files order by name to 'copies' }; print success",
+    lines(*["Copy '" + name + "' to 'copies'" for name in manyTexts], TRUE))
+  run_pipeline_test_case(copy_to_pipeline(path("res", "many texts")),
+    "inside 'modificables/pipeline' { move files order by name to 'moved' }; print success",
+    lines(*["Move '" + name + "' to 'moved'" for name in manyTexts], TRUE))
+  run_pipeline_test_case(copy_to_pipeline(path("res", "many texts")),
+    "inside 'modificables/pipeline' { copy ('ex_01.txt', 'ex_02.txt', 'ex_03.txt', 'ex_04.txt') where this = 'ex_01.txt' or success to 'copies' }; print success",
+    lines("Copy 'ex_01.txt' to 'copies'", "Failed to copy 'ex_02.txt'", FALSE), "ex_02.txt")
+  run_pipeline_test_case(write_to_pipeline({ path("one", "same.txt"): "first", path("two", "same.txt"): "second" }),
+    "inside 'modificables/pipeline' { copy ('one/same.txt', 'two/same.txt') to 'copies' }; print success",
+    lines("Copy 'same.txt' to 'copies'", "Failed to copy 'same.txt'", FALSE))
+  run_pipeline_test_case(write_to_pipeline({ path("one", "same.txt"): "first", path("two", "same.txt"): "second" }),
+    "inside 'modificables/pipeline' { force copy ('one/same.txt', 'two/same.txt') to 'copies' }; print success",
+    lines("Copy 'same.txt' to 'copies'", "Copy 'same.txt' to 'copies'", TRUE))
+  run_daemon_test_case([
+    ("print 'a', 'b'", lines("a", "b"), EXIT_CODE_OK),
+    ("print 'c'; error 5", "c", 5),
+    ("print 'a', 'b'", lines("a", "b"), EXIT_CODE_OK)])
+  run_watch_test_case("inside 'numbers' { recursiveDirectories { print name; exit } }",
+    [(None, "1"), (touch_file(path("res", "modificables", "watch.txt")), "1")])
+  run_watch_test_case("inside '..' { 'watch.txt' { exists } }; inside 'modificables' { 'watch.txt' { exists } }",
+    [(None, "0"), (None, "0"),
+     (ignored_change(write_file("watch.txt"), write_file(path("res", "modificables", "watch.txt"))), "1"), (None, "1")])
+  remove_files("watch.txt", path("res", "modificables", "watch.txt"))
+  write_file(path("res", "modificables", "first.in"))()
+  run_watch_test_case("inside 'modificables' { files where extension = 'in' { drop } }; print 'done'; sleep 3000",
+    [(None, "Drop 'first.in'"), (None, "done"),
+     (write_file(path("res", "modificables", "second.in")), "Drop 'second.in'"), (None, "done")])
+  remove_files(path("res", "modificables", "first.in"), path("res", "modificables", "second.in"))
+
   print ("BLACK-BOX TESTS END")
   print ("All tests have passed successfully if there is no error message above.")
   input("Press Enter to continue...")
@@ -0,0 +1,124 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "watch.h"
+#include "cmd.h"
+
+
+namespace perun2
+{
+
+// watch that is stopped by Ctrl+C
+static Watcher* activeWatcher = nullptr;
+
+static void stopActiveWatcher()
+{
+   if (activeWatcher != nullptr) {
+      activeWatcher->stop();
+   }
+}
+
+
+Watcher::Watcher(Perun2& inst)
+   : instance(inst) { };
+
+int Watcher::run()
+{
+   if (! this->instance.prepare()) {
+      return this->instance.getExitCode();
+   }
+
+   const p_str location = this->instance.getLocation();
+
+   if (! os_startWatch(location, this->watch)) {
+      os_stopWatch(this->watch);
+      cmd::error::watchLocation(location);
+      return EXITCODE_CLI_ERROR;
+   }
+
+   activeWatcher = this;
+   Terminator::setShutdown(stopActiveWatcher);
+
+   this->instance.execute();
+
+   while (this->awaitNextRun()) {
+      this->instance.execute();
+   }
+
+   Terminator::setShutdown(nullptr);
+   activeWatcher = nullptr;
+   os_stopWatch(this->watch);
+
+   return this->instance.getExitCode();
+}
+
+void Watcher::stop()
+{
+   os_wakeWatch(this->watch);
+}
+
+p_bool Watcher::awaitNextRun()
+{
+   if (this->instance.hasModifiedFiles()) {
+      // changes of the run itself are not told apart from changes made by other programs meanwhile
+      // so if anything has changed, the script runs once more and sees them all
+      // the next run, that leaves the location as it is, ends this
+      p_bool changed = false;
+
+      if (! this->awaitQuiet(changed)) {
+         return false;
+      }
+
+      if (changed) {
+         return true;
+      }
+   }
+
+   return this->awaitBurst();
+}
+
+p_bool Watcher::awaitBurst()
+{
+   p_bool changed = false;
+
+   return os_awaitChange(this->watch, WATCH_FOREVER) == WatchEvent::we_Change
+      && this->awaitQuiet(changed);
+}
+
+p_bool Watcher::awaitQuiet(p_bool& changed)
+{
+   while (true) {
+      switch (os_awaitChange(this->watch, WATCH_DEBOUNCE_MS)) {
+         case WatchEvent::we_Change: {
+            changed = true;
+            break;
+         }
+         case WatchEvent::we_Timeout: {
+            return true;
+         }
+         default: {
+            return false;
+         }
+      }
+   }
+}
+
+
+int runWatch(Perun2& instance)
+{
+   Watcher watcher(instance);
+   return watcher.run();
+}
+
+}
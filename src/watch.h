@@ -0,0 +1,63 @@
+/*
+    This file is part of Perun2.
+    Perun2 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    Perun2 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with Perun2. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "perun2.h"
+#include "os/os.h"
+
+
+namespace perun2
+{
+
+// a burst of changes is over, when nothing has changed for this many milliseconds
+p_constexpr p_int WATCH_DEBOUNCE_MS = 500;
+
+
+// the watch mode
+// the script is parsed once and run, then Perun2 waits for changes inside of its working location
+// a burst of changes, like many files being copied there, is coalesced into one more run
+// every run goes through the whole location, as definitions do not tell which elements they would skip
+// only the working location is watched, so changes of other places read by the script do not start it
+// changes made by the script itself are not awaited, but they may hide changes made by others at the same time
+// so after a run that has modified something, the script runs again, until a run modifies nothing
+// a script that modifies its location every time runs over and over, so it should check if a change is needed
+struct Watcher
+{
+public:
+   Watcher() = delete;
+   Watcher(Perun2& inst);
+   Watcher(Watcher const&) = delete;
+   Watcher& operator= (Watcher const&) = delete;
+
+   // block the current thread until the watch is stopped by Ctrl+C
+   int run();
+   void stop();
+
+private:
+   // return false, if the watch has been stopped
+   p_bool awaitNextRun();
+   // wait for the first change and then until the burst is over
+   p_bool awaitBurst();
+   // the argument is set, if there was any change in the meantime
+   p_bool awaitQuiet(p_bool& changed);
+
+   Perun2& instance;
+   DirectoryWatch watch;
+};
+
+
+int runWatch(Perun2& instance);
+
+}